@@ -0,0 +1,39 @@
+// pairs of functions whose generated code must be identical: each function in the
+// raw namespace is written by hand on doubles, and its counterpart in the qty
+// namespace computes the same thing using quantities. codegen.py compares the
+// assembly of each pair, so that any abstraction penalty fails the check
+
+#include <cmath>
+
+#include <units/math.h>
+#include <units/units.h>
+
+namespace raw {
+  double add(double a, double b) {return a + b;}
+  double subtract(double a, double b) {return a - b;}
+  double multiply(double a, double b) {return a * b;}
+  double scale(double a, double x) {return a * x;}
+  double convert(double km) {return km * 1000.;}
+  double divide(double km, double m) {return (km * 1000.) / m;}
+  double mixed_add(double m, double km) {return m + km * 1000.;}
+  double hypot(double a, double b) {return std::hypot(a, b);}
+  double sqrt(double a) {return std::sqrt(a);}
+  bool less(double a, double b) {return a < b;}
+  bool equal(double a, double b) {return a == b;}
+}
+
+namespace qty {
+  using namespace units;
+
+  meter_t<> add(meter_t<> a, meter_t<> b) {return a + b;}
+  meter_t<> subtract(meter_t<> a, meter_t<> b) {return a - b;}
+  auto multiply(meter_t<> a, second_t<> b) {return a * b;}
+  meter_t<> scale(meter_t<> a, double x) {return a * x;}
+  meter_t<> convert(kilometer_t<> km) {return km.convert<meter>();}
+  double divide(kilometer_t<> km, meter_t<> m) {return km / m;}
+  meter_t<> mixed_add(meter_t<> m, kilometer_t<> km) {return m + km;}
+  meter_t<> hypot(meter_t<> a, meter_t<> b) {return math::hypot(a, b);}
+  meter_t<> sqrt(quantity<make_unit<squared<meter>>> a) {return math::sqrt(a);}
+  bool less(meter_t<> a, meter_t<> b) {return a < b;}
+  bool equal(meter_t<> a, meter_t<> b) {return a == b;}
+}
@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+"""Codegen-equivalence check.
+
+Reads the assembly generated for codegen.cpp and compares, instruction by
+instruction, every function of the raw namespace against the function with the
+same name in the qty namespace. Fails if any pair differs, or has no counterpart.
+"""
+
+import re
+import sys
+
+# mangled names of the functions of interest: _ZN3raw3addE..., _ZN3qty3addE...
+FUNCTION = re.compile(r'^_?_ZN3(raw|qty)(\d+)(\w+):')
+
+def normalize(text):
+  """Local labels and constant pools are numbered per translation unit."""
+  return re.sub(r'\.L([A-Z]*)\d+', r'.L\1', text)
+
+def functions(lines):
+  """Map (namespace, name) to the normalized instructions of each function."""
+  result = {}
+  current = None
+
+  for line in lines:
+    match = FUNCTION.match(line)
+    if match:
+      space, length, rest = match.groups()
+      current = (space, rest[:int(length)])
+      result[current] = []
+      continue
+
+    if current is None:
+      continue
+
+    text = line.split('#')[0].strip()
+
+    if text.startswith('.cfi_endproc') or text.startswith('.size'):
+      current = None
+    elif text and (not text.startswith('.') or text.startswith('.L')):
+      # instructions and local labels: everything else is an assembler directive
+      result[current].append(normalize(text))
+
+  return result
+
+def main():
+  with open(sys.argv[1]) as f:
+    code = functions(f.readlines())
+
+  names = sorted({name for _, name in code})
+  failed = False
+
+  for name in names:
+    raw, qty = code.get(('raw', name)), code.get(('qty', name))
+
+    if raw is None or qty is None:
+      print(f'{name:12} MISSING {"raw" if raw is None else "qty"} implementation')
+      failed = True
+    elif raw != qty:
+      print(f'{name:12} DIFFERENT')
+      for a, b in zip(raw + [''] * len(qty), qty + [''] * len(raw)):
+        if a or b:
+          print(f'  {a:40} | {b}')
+      failed = True
+    else:
+      print(f'{name:12} identical ({len(raw)} instructions)')
+
+  return 1 if failed or not names else 0
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+"""Compile-time benchmarks for the unit type algebra.
+
+Generates synthetic translation units stressing make_unit, unit multiplication,
+ratio powers and nested powers, compiles each of them, and records the wall time
+and the peak memory of the compiler. Wall times depend on the machine, so they are
+divided by the time taken to compile a reference translation unit, which only
+includes standard headers, on the same machine. These relative times and the peak
+memory are compared against the baselines stored in compile_time.json, and the
+benchmark fails when any of them regresses past the baseline by more than the
+allowed tolerance.
+"""
+
+import argparse
+import json
+import os
+import pathlib
+import subprocess
+import sys
+import time
+
+# - synthetic translation units
+
+BASE_UNITS = ['meter', 'second', 'kilogram', 'ampere', 'kelvin', 'mole', 'candela']
+
+def unit_products(terms=60, count=20):
+  """Long products of base units and their inverses, passed to make_unit."""
+  lines = []
+  for i in range(count):
+    args = []
+    for j in range(terms):
+      unit = BASE_UNITS[(i + j) % len(BASE_UNITS)]
+      args.append(unit if (i + j) % 3 else f'inverse<{unit}>')
+    lines.append(f'using product_{i} = make_unit<{", ".join(args)}>;')
+    lines.append(f'static_assert(sizeof(quantity<product_{i}>) == sizeof(double));')
+    lines.append(f'constexpr std::string_view symbol_{i} = product_{i}::symbol;')
+  return lines
+
+def derived_units(count=300):
+  """Hundreds of distinct derived units, each with its own factor and symbol."""
+  lines = []
+  for i in range(count):
+    a = BASE_UNITS[i % len(BASE_UNITS)]
+    b = BASE_UNITS[(i // len(BASE_UNITS)) % len(BASE_UNITS)]
+    lines.append(f'units_add_derived_unit(derived_{i}, d{i}, make_unit<ratio<{i + 1}, {i + 2}>, {a}, inverse_squared<{b}>>);')
+  lines.append('constexpr auto total = (0.0')
+  for i in range(count):
+    lines.append(f'  + (derived_{i}_t<>(1) * {BASE_UNITS[0]}_t<>(1)).get_value()')
+  lines.append(');')
+  return lines
+
+def nested_powers(depth=24, count=20):
+  """Deeply nested power_t<power_t<...>> expressions and large ratio powers."""
+  # the exponents cycle so that every four levels of nesting multiply to one
+  exponents = [(2, 1), (1, 2), (-1, 1), (-1, 1)]
+  lines = []
+  for i in range(count):
+    expr = BASE_UNITS[i % len(BASE_UNITS)]
+    for j in range(depth):
+      num, den = exponents[(i + j) % len(exponents)]
+      expr = f'_details::power_t<{expr}, {num}, {den}>'
+    lines.append(f'using rpower_{i} = ratio_power<ratio<{i + 2}, {i + 3}>, {20 + i % 5}>;')
+    lines.append(f'using nested_{i} = make_unit<rpower_{i}, {expr}, squared<{expr}>>;')
+    lines.append(f'static_assert(sizeof(quantity<nested_{i}>) == sizeof(double));')
+  return lines
+
+def standard():
+  """Standard headers only, whose compile time measures the speed of the machine."""
+  headers = ['algorithm', 'array', 'chrono', 'functional', 'iostream', 'map', 'memory',
+    'optional', 'random', 'regex', 'string', 'tuple', 'unordered_map', 'variant', 'vector']
+  return [f'#include <{header}>' for header in headers] + ['']
+
+CASES = {
+  'unit-products': unit_products,
+  'derived-units': derived_units,
+  'nested-powers': nested_powers,
+}
+
+def source(lines):
+  return '\n'.join([
+    '#include <units/units.h>',
+    '',
+    'namespace units {',
+    *['  ' + line for line in lines],
+    '}',
+    '',
+  ])
+
+# - measurement
+
+def measure(compiler, compiler_id, include, path):
+  """Compile path, returning (seconds, peak kilobytes) of the compiler process."""
+  # the compiler runs in the directory of the source, so paths must be absolute
+  path = pathlib.Path(path).resolve()
+  include = pathlib.Path(include).resolve()
+  args = [*compiler, '-std=c++20', '-I', str(include), '-c', str(path), '-o', str(path.with_suffix('.o'))]
+  if compiler_id == 'clang':
+    args += ['-ftime-trace']
+
+  start = time.perf_counter()
+  process = subprocess.Popen(args, cwd=path.parent)
+  _, status, usage = os.wait4(process.pid, 0)
+  elapsed = time.perf_counter() - start
+  process.returncode = os.waitstatus_to_exitcode(status)
+
+  if process.returncode != 0:
+    sys.exit(f'compilation of {path} failed')
+
+  # the driver itself is small: the peak is dominated by the compiler proper,
+  # which is a child of the driver and is accounted for in ru_maxrss
+  return elapsed, usage.ru_maxrss
+
+def best(compiler, compiler_id, include, path, repeat):
+  """The shortest time and the smallest peak of several compilations of path."""
+  runs = [measure(compiler, compiler_id, include, path) for _ in range(repeat)]
+  return min(seconds for seconds, _ in runs), min(peak for _, peak in runs)
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  parser.add_argument('--compiler-id', required=True)
+  parser.add_argument('--include', required=True)
+  parser.add_argument('--baseline', required=True)
+  parser.add_argument('--workdir', required=True)
+  parser.add_argument('--tolerance', type=float, default=0.5,
+    help='allowed relative regression over the baseline (default: 0.5)')
+  parser.add_argument('--repeat', type=int, default=3,
+    help='compilations of each case, of which the best is kept (default: 3)')
+  parser.add_argument('--update', action='store_true',
+    help='store the measurements as the new baseline')
+  parser.add_argument('compiler', nargs='+')
+  args = parser.parse_args()
+
+  workdir = pathlib.Path(args.workdir).resolve()
+  workdir.mkdir(parents=True, exist_ok=True)
+
+  baseline = json.loads(pathlib.Path(args.baseline).read_text())
+  results = {}
+  failed = False
+
+  path = workdir / 'reference.cpp'
+  path.write_text('\n'.join(standard()))
+  unit, _ = best(args.compiler, args.compiler_id, args.include, path, args.repeat)
+  print(f'{"reference":16} {unit:8.3f} s')
+
+  for name, generator in CASES.items():
+    path = workdir / f'{name}.cpp'
+    path.write_text(source(generator()))
+    seconds, peak = best(args.compiler, args.compiler_id, args.include, path, args.repeat)
+    results[name] = {'relative_time': round(seconds/unit, 2), 'peak_kb': peak}
+
+    line = f'{name:16} {seconds:8.3f} s {seconds/unit:8.2f} x {peak/1024:10.1f} MiB'
+    reference = baseline.get(args.compiler_id, {}).get(name)
+
+    if reference:
+      for key, value in results[name].items():
+        if key in reference and value > reference[key] * (1 + args.tolerance):
+          line += f'  REGRESSION: {key} {value} > {reference[key]} (+{args.tolerance:.0%})'
+          failed = True
+
+    print(line)
+
+    if args.compiler_id == 'clang':
+      print(f'{"":16} time trace: {path.with_suffix(".json")}')
+
+  if args.update:
+    baseline[args.compiler_id] = results
+    pathlib.Path(args.baseline).write_text(json.dumps(baseline, indent=2, sort_keys=True) + '\n')
+
+  return 1 if failed else 0
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""Compile-time benchmark of the compiled library.
+
+Generates a set of translation units, each using a dozen of the prebuilt units in
+arithmetic, output and math functions, and compiles all of them twice: header-only,
+and with units_prebuilt defined, as programs linking libphys-units are. Reports the
+total compile time and object text size of both builds.
+"""
+
+import argparse
+import pathlib
+import subprocess
+import sys
+import time
+
+# - synthetic translation units
+
+UNITS = ['meter', 'second', 'kilogram', 'newton', 'joule', 'watt', 'volt', 'kilometer',
+  'millisecond', 'hour', 'electronvolt', 'hertz', 'pascal', 'coulomb', 'ohm', 'gram']
+
+def translation_unit(index, count=12):
+  """A function printing quantities of count units, starting from the index-th."""
+  lines = [
+    '#include <units/units.h>',
+    '#include <units/math.h>',
+    '#include <iostream>',
+    '',
+    'using namespace units;',
+    '',
+    f'void f{index}(const double x) {{',
+  ]
+  for k in range(count):
+    unit = UNITS[(3*index + k) % len(UNITS)]
+    lines.append(f'  {{ {unit}_t<> a(x), b(x*{k + 2}); auto c = a + b; c -= a;')
+    lines.append(f'    std::cout << c << math::floor(c) << math::hypot(a, b) << math::fmod(b, a) << math::round(a/2.0) << math::trunc(b) << math::isnan(c) << "\\n"; }}')
+  lines.append('}')
+  return '\n'.join(lines) + '\n'
+
+# - measurement
+
+def build(compiler, include, paths, flags):
+  """Compile paths one after the other, returning (seconds, text bytes) of all of them."""
+  start = time.perf_counter()
+  objects = []
+  for path in paths:
+    obj = path.with_suffix('.o')
+    subprocess.run([*compiler, '-std=c++20', *flags, '-I', str(pathlib.Path(include).resolve()), '-c', str(path), '-o', str(obj)], check=True)
+    objects.append(str(obj))
+  elapsed = time.perf_counter() - start
+
+  sizes = subprocess.run(['size', *objects], check=True, capture_output=True, text=True).stdout.splitlines()[1:]
+  return elapsed, sum(int(line.split()[0]) for line in sizes)
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  parser.add_argument('--include', required=True)
+  parser.add_argument('--workdir', required=True)
+  parser.add_argument('--units', type=int, default=8, help='number of translation units (default: 8)')
+  parser.add_argument('--repeat', type=int, default=3, help='builds of each kind, the fastest is kept (default: 3)')
+  parser.add_argument('--flags', default='-O0', help='compiler flags (default: -O0)')
+  parser.add_argument('compiler', nargs='+')
+  args = parser.parse_args()
+
+  workdir = pathlib.Path(args.workdir)
+  workdir.mkdir(parents=True, exist_ok=True)
+
+  paths = []
+  for i in range(args.units):
+    path = workdir / f'tu{i}.cpp'
+    path.write_text(translation_unit(i))
+    paths.append(path)
+
+  results = {}
+  for name, flags in [('header-only', []), ('prebuilt', ['-Dunits_prebuilt'])]:
+    runs = [build(args.compiler, args.include, paths, [*args.flags.split(), *flags]) for _ in range(args.repeat)]
+    results[name] = min(runs)
+    seconds, text = results[name]
+    print(f'{name:12} {seconds:8.3f} s {text/1024:10.1f} KiB of text')
+
+  ratio = results['prebuilt'][0]/results['header-only'][0]
+  print(f'{"":12} prebuilt build time: {ratio:.1%} of header-only')
+  return 0
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -0,0 +1,116 @@
+// runtime benchmarks: each kernel is a template instantiated once with raw doubles
+// and once with quantities, and both versions are timed over the same data
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <units/math.h>
+#include <units/units.h>
+
+using namespace units;
+
+// - kernels
+
+namespace kernels {
+
+  struct add {
+    static constexpr auto name = "add";
+    auto operator()(const auto a, const auto b) const {return a + b;}
+  };
+
+  struct mul {
+    static constexpr auto name = "mul";
+    auto operator()(const auto a, const auto b) const {return a * b;}
+  };
+
+  struct convert {
+    static constexpr auto name = "convert";
+    auto operator()(const double a, double) const {return a * 1000.;}
+    auto operator()(const meter_t<> a, meter_t<>) const {return a.convert<millimeter>();}
+  };
+
+  struct divide {
+    static constexpr auto name = "divide";
+    auto operator()(const double a, const double b) const {return (a * 1000.) / b;}
+    auto operator()(const meter_t<> a, const meter_t<> b) const {return a / millimeter_t<>(b.get_value());}
+  };
+
+  struct hypot {
+    static constexpr auto name = "hypot";
+    auto operator()(const double a, const double b) const {return std::hypot(a, b);}
+    auto operator()(const meter_t<> a, const meter_t<> b) const {return math::hypot(a, b);}
+  };
+
+  struct sqrt {
+    static constexpr auto name = "sqrt";
+    auto operator()(const double a, const double b) const {return std::sqrt(a * b);}
+    auto operator()(const meter_t<> a, const meter_t<> b) const {return math::sqrt(a * b);}
+  };
+
+  struct less {
+    static constexpr auto name = "less";
+    auto operator()(const auto a, const auto b) const {return a < b;}
+  };
+
+}
+
+// - timing
+
+template <class Kernel, class T>
+double run(const std::vector<T>& a, const std::vector<T>& b, const int repetitions) {
+  using result_type = decltype(Kernel{}(a[0], b[0]));
+  const auto c = std::make_unique<result_type[]>(a.size());
+
+  auto best = std::chrono::steady_clock::duration::max();
+
+  for (int r = 0; r < repetitions; ++r) {
+    const auto start = std::chrono::steady_clock::now();
+    std::transform(a.begin(), a.end(), b.begin(), c.get(), Kernel{});
+    best = std::min(best, std::chrono::steady_clock::now() - start);
+
+    // keep the compiler from discarding the results
+    asm volatile("" : : "r"(c.get()) : "memory");
+  }
+
+  return std::chrono::duration<double, std::nano>(best).count() / a.size();
+}
+
+template <class Kernel>
+void compare(const std::vector<double>& a, const std::vector<double>& b) {
+  constexpr int repetitions = 50;
+
+  const std::vector<meter_t<>> qa(a.begin(), a.end());
+  const std::vector<meter_t<>> qb(b.begin(), b.end());
+
+  const auto raw = run<Kernel>(a, b, repetitions);
+  const auto qty = run<Kernel>(qa, qb, repetitions);
+
+  std::printf("%-10s %10.3f %10.3f %8.2f\n", Kernel::name, raw, qty, qty/raw);
+}
+
+int main(void) {
+  constexpr std::size_t size = 1 << 20;
+
+  std::mt19937_64 engine(42);
+  std::uniform_real_distribution<double> distribution(1, 100);
+
+  std::vector<double> a(size), b(size);
+  std::generate(a.begin(), a.end(), [&]{return distribution(engine);});
+  std::generate(b.begin(), b.end(), [&]{return distribution(engine);});
+
+  std::printf("%-10s %10s %10s %8s\n", "kernel", "raw ns", "qty ns", "ratio");
+  compare<kernels::add>(a, b);
+  compare<kernels::mul>(a, b);
+  compare<kernels::convert>(a, b);
+  compare<kernels::divide>(a, b);
+  compare<kernels::hypot>(a, b);
+  compare<kernels::sqrt>(a, b);
+  compare<kernels::less>(a, b);
+
+  return 0;
+}
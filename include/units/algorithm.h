@@ -0,0 +1,117 @@
+#ifndef _include_units_algorithm_h
+#define _include_units_algorithm_h
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include <units/details/fixed.h>
+#include <units/details/quantity.h>
+#include <units/details/ratio.h>
+#include <units/details/simd.h>
+
+namespace units::_details::_algorithm {
+
+  // - scale a raw value by the compile-time ratio F, producing a value of type W
+
+  // the rounding and overflow policies only apply to integral values: floating point
+  // values are always scaled by a single multiplication
+  template <concepts::ratio F, class W, concepts::rounding_policy R = rounding::truncate, concepts::overflow_policy O = overflow::wrap>
+  constexpr auto scale(const auto x) {
+    using T = std::common_type_t<decltype(x), W>;
+    constexpr bool plain = std::is_same_v<R, rounding::truncate> && std::is_same_v<O, overflow::wrap>;
+
+    if constexpr (std::is_integral_v<T> && !plain)
+      // integral, with rounding or overflow checks: see _fixed::scale
+      return _fixed::scale<F, W, R, O>(x);
+    else if constexpr (std::is_same_v<F, one>)
+      // same factor: this is a plain copy (possibly changing the value type)
+      return static_cast<W>(x);
+    else if constexpr (std::is_floating_point_v<T>)
+      // floating point: a single multiplication by the folded factor
+      return static_cast<W>(static_cast<T>(x) * F::template value<T>);
+    else if constexpr (concepts::integral_ratio<F>)
+      // integral, with integral factor: a single integer multiplication
+      return static_cast<W>(static_cast<T>(x) * static_cast<T>(F::num));
+    else if constexpr (F::num == 1)
+      // integral, with factor 1/den: a single (truncating) division by a constant
+      return static_cast<W>(static_cast<T>(x) / static_cast<T>(F::den));
+    else
+      // integral, general factor: exact fixed-point arithmetic, with no division by
+      // a wide integer for all but the largest denominators, see _fixed::exact
+      return _fixed::scale<F, W, R, O>(x);
+  }
+
+  // - kernel: scale n values from in into out
+
+  // the loop is split into blocks of as many elements as fit in a vector register
+  // of the target, followed by a scalar loop handling the remaining tail elements.
+  // each block is fully loaded before being stored, so that in and out are allowed
+  // to alias and the block maps to a single vector load/multiply/store. overflows
+  // cannot be reported per element, so the checked policy is not available here
+  template <concepts::ratio F, class R, class O, concepts::quantity Qa, concepts::quantity Qb>
+  requires (!std::is_same_v<O, overflow::checked>)
+  constexpr void scale_n(const Qa* in, const std::size_t n, Qb* out) {
+    using value_type = typename Qb::value_type;
+    constexpr std::size_t width = _simd::lanes<std::common_type_t<typename Qa::value_type, value_type>>;
+
+    std::size_t i = 0;
+
+    for (; i + width <= n; i += width) {
+      value_type block[width];
+
+      for (std::size_t j = 0; j < width; ++j)
+        block[j] = scale<F, value_type, R, O>(in[i+j].get_value());
+
+      for (std::size_t j = 0; j < width; ++j)
+        out[i+j] = Qb(block[j]);
+    }
+
+    for (; i < n; ++i)
+      out[i] = Qb(scale<F, value_type, R, O>(in[i].get_value()));
+  }
+
+  // - convert n quantities starting at first, writing the results starting at out
+
+  // integral values are truncated and not checked for overflow, unless other
+  // policies are given, as in convert_n<rounding::nearest, overflow::saturate>(first, n, out)
+  template <
+    concepts::rounding_policy R = rounding::truncate, concepts::overflow_policy O = overflow::wrap,
+    concepts::quantity Qa, concepts::quantity_compatible<Qa> Qb>
+  constexpr Qb* convert_n(const Qa* first, const std::size_t n, Qb* out) {
+    using factor = ratio_divide<typename Qa::unit_type::factor, typename Qb::unit_type::factor>;
+    scale_n<factor, R, O>(first, n, out);
+    return out + n;
+  }
+
+  // - convert the quantities of a contiguous range into another contiguous range
+
+  // at most min(in.size(), out.size()) elements are converted. the returned span
+  // refers to the elements of out that were actually written
+  template <
+    concepts::rounding_policy R = rounding::truncate, concepts::overflow_policy O = overflow::wrap,
+    std::ranges::contiguous_range In, std::ranges::contiguous_range Out>
+  requires
+    concepts::quantity<std::ranges::range_value_t<In>> &&
+    concepts::quantity_compatible<std::ranges::range_value_t<Out>, std::ranges::range_value_t<In>>
+  constexpr auto convert_into(const In& in, Out&& out) {
+    const auto n = std::min<std::size_t>(std::ranges::size(in), std::ranges::size(out));
+    convert_n<R, O>(std::ranges::data(in), n, std::ranges::data(out));
+    return std::span(std::ranges::data(out), n);
+  }
+
+}
+
+namespace units {
+
+  // * batch conversion of quantities
+
+  using _details::_algorithm::convert_n;
+  using _details::_algorithm::convert_into;
+
+}
+
+#endif
@@ -1,9 +1,16 @@
 #ifndef _include_units_angular_h
 #define _include_units_angular_h
 
+#include <bit>
 #include <cmath>
+#include <cstdint>
+#include <span>
+#include <type_traits>
 
+#include <units/algorithm.h>
+#include <units/details/kernels.h>
 #include <units/framework.h>
+#include <units/math.h>
 
 namespace units {
 
@@ -23,19 +30,119 @@ namespace units {
 
   namespace _details::_math {
 
+    // * reduction of angles in their own unit
+
+    // angles in units of which a quarter turn is exactly representable, as degrees,
+    // arcseconds or cycles, are reduced modulo a quarter turn in that unit, which is
+    // exact, and only then converted to radians, see _kernel::sincos. so sin(180 deg)
+    // and cos(90 deg) are exactly zero, and the results are within 1.2 ulp of the
+    // exact ones for any angle. other angles, including radians, are converted to
+    // radians and passed to the functions from <cmath>. angles held in packs are
+    // computed element by element, by the kernel or by the functions of the pack
+    namespace _angle {
+      // * a quarter turn in units of U
+      template <concepts::unit U>
+      using quarter_turn = ratio_divide<typename cycle::factor, ratio_multiply<ratio<4>, typename U::factor>>;
+
+      // * type of the result of trigonometric functions of values of type V
+      template <class V>
+      struct value {using type = decltype(std::sin(std::declval<V>()));};
+
+      template <concepts::pack V>
+      struct value<V> {using type = V;};
+
+      template <concepts::quantity Q>
+      using value_t = typename value<typename Q::value_type>::type;
+
+      // * Q is reduced in its own unit: the kernel works in double precision, so
+      // * long double results always go through <cmath>
+      template <class Q>
+      concept reducible =
+        (std::is_same_v<traits::element_type_t<value_t<Q>>, float> || std::is_same_v<traits::element_type_t<value_t<Q>>, double>) &&
+        std::has_single_bit(std::uint64_t(quarter_turn<typename Q::unit_type>::den)) &&
+        quarter_turn<typename Q::unit_type>::num < (intm_t(1) << 32);
+
+      template <class Q>
+      using kernel = _kernel::sincos<quarter_turn<typename Q::unit_type>>;
+
+      // * sine and cosine of the elements of a pack x, computed as a block
+      template <class K, class T>
+      void evaluate(const T& x, T& sin, T& cos) {
+        using E = traits::element_type_t<T>;
+        constexpr std::size_t n = T::size();
+        E sines[n], cosines[n];
+
+        for (std::size_t j = 0; j < n; ++j)
+          K::lane(E(x[j]), sines[j], cosines[j]);
+
+        _kernel::refine(n,
+          [&](const std::size_t j) {return K::fast(E(x[j]));},
+          [&](const std::size_t j) {K::exact(E(x[j]), sines[j], cosines[j]);});
+
+        for (std::size_t j = 0; j < n; ++j) {
+          sin[j] = sines[j];
+          cos[j] = cosines[j];
+        }
+      }
+    }
+
+    // * sine and cosine computed together
+    template <class T>
+    struct sincos_t {T sin; T cos;};
+
+    template <concepts::quantity_compatible<radian_t<>> Q>
+    auto sincos(const Q q) {
+      using T = _angle::value_t<Q>;
+      sincos_t<T> ret;
+
+      if constexpr (_angle::reducible<Q> && concepts::pack<T>) {
+        _angle::evaluate<_angle::kernel<Q>>(T(q.get_value()), ret.sin, ret.cos);
+      } else if constexpr (_angle::reducible<Q>) {
+        _angle::kernel<Q>::evaluate(T(q.get_value()), ret.sin, ret.cos);
+      } else {
+        using std::sin, std::cos;
+        const auto x = q/radian_t{1};
+        ret = {sin(x), cos(x)};
+      }
+
+      return ret;
+    }
+
     // * trigonometric functions can only be computed using units of angle
-    auto sin(const concepts::quantity_compatible<radian_t<>> auto q)
-    {return std::sin(q/radian_t{1});}
+    template <concepts::quantity_compatible<radian_t<>> Q>
+    auto sin(const Q q) {
+      using std::sin;
+      if constexpr (_angle::reducible<Q>)
+        return sincos(q).sin;
+      else
+        return sin(q/radian_t{1});
+    }
 
-    auto cos(const concepts::quantity_compatible<radian_t<>> auto q)
-    {return std::cos(q/radian_t{1});}
+    template <concepts::quantity_compatible<radian_t<>> Q>
+    auto cos(const Q q) {
+      using std::cos;
+      if constexpr (_angle::reducible<Q>)
+        return sincos(q).cos;
+      else
+        return cos(q/radian_t{1});
+    }
 
-    auto tan(const concepts::quantity_compatible<radian_t<>> auto q)
-    {return std::tan(q/radian_t{1});}
+    // the tangent of an odd multiple of a right angle is infinite
+    template <concepts::quantity_compatible<radian_t<>> Q>
+    auto tan(const Q q) {
+      if constexpr (_angle::reducible<Q>) {
+        const auto [s, c] = sincos(q);
+        return s/c;
+      } else {
+        using std::tan;
+        return tan(q/radian_t{1});
+      }
+    }
 
     template <concepts::unit_compatible<radian> Unit = radian>
-    auto asin(const concepts::arithmetic auto x) {
-      const auto rad_value = radian_t{std::asin(x)};
+    auto asin(const concepts::value auto x) {
+      using std::asin;
+      const auto rad_value = radian_t<decltype(asin(x))>(asin(x));
       if constexpr (std::is_same_v<Unit, radian>)
         return rad_value;
       else
@@ -43,8 +150,9 @@ namespace units {
     }
 
     template <concepts::unit_compatible<radian> Unit = radian>
-    auto acos(const concepts::arithmetic auto x){
-      const auto rad_value = radian_t{std::acos(x)};
+    auto acos(const concepts::value auto x) {
+      using std::acos;
+      const auto rad_value = radian_t<decltype(acos(x))>(acos(x));
       if constexpr (std::is_same_v<Unit, radian>)
         return rad_value;
       else
@@ -52,8 +160,9 @@ namespace units {
     }
 
     template <concepts::unit_compatible<radian> Unit = radian>
-    auto atan(const concepts::arithmetic auto x){
-      const auto rad_value = radian_t{std::atan(x)};
+    auto atan(const concepts::value auto x) {
+      using std::atan;
+      const auto rad_value = radian_t<decltype(atan(x))>(atan(x));
       if constexpr (std::is_same_v<Unit, radian>)
         return rad_value;
       else
@@ -63,7 +172,9 @@ namespace units {
     template <concepts::unit_compatible<radian> Unit = radian>
     auto atan2(const concepts::quantity auto y, const concepts::quantity auto x)
     requires concepts::quantity_compatible<decltype(y), decltype(x)> {
-      const auto rad_value = radian_t(std::atan2(y.get_value(), decltype(y)(x).get_value()));
+      using std::atan2;
+      auto value = atan2(y.get_value(), decltype(y)(x).get_value());
+      const auto rad_value = radian_t<decltype(value)>(value);
       if constexpr (std::is_same_v<Unit, radian>)
         return rad_value;
       else
@@ -71,13 +182,118 @@ namespace units {
     }
 
     template <concepts::unit_compatible<radian> Unit = radian>
-    auto atan2(const concepts::arithmetic auto y, const concepts::arithmetic auto x) {
-      const auto rad_value = radian_t(std::atan2(y, x));
+    auto atan2(const concepts::value auto y, const concepts::value auto x) {
+      using std::atan2;
+      const auto rad_value = radian_t<decltype(atan2(y, x))>(atan2(y, x));
       if constexpr (std::is_same_v<Unit, radian>)
         return rad_value;
       else
         return rad_value.template convert<Unit>();
     }
+
+    // * batch versions
+
+    // sin, cos and sincos also take a contiguous range of angles, and write their
+    // results into contiguous ranges of numbers, as the batch functions in math.h.
+    // angles reduced in their own unit are computed in blocks by the same kernel as
+    // a single angle, so both give identical results
+
+    namespace _angle {
+      // * kernel computing only one of sine and cosine, for _batch::apply
+      template <class K, bool Cos>
+      struct component {
+        static bool fast(const auto x) {return K::fast(x);}
+
+        template <class T>
+        static T lane(const T x) {
+          T s, c;
+          K::lane(x, s, c);
+          return Cos? c : s;
+        }
+
+        template <class T>
+        static T exact(const T x) {
+          T s, c;
+          K::exact(x, s, c);
+          return Cos? c : s;
+        }
+      };
+
+      // * apply function f to angles in radians
+      template <class T, class F, class In, class Out>
+      auto in_radians(const F& f, const In& in, Out&& out) {
+        using factor = ratio_divide<typename _batch::element_t<In>::unit_type::factor, typename radian::factor>;
+        return _batch::unary<factor, T>(_batch::plain(f), in, out);
+      }
+    }
+
+    template <_batch::input In, _batch::output<decltype(sin(std::declval<_batch::element_t<In>>()))> Out>
+    auto sin(const In& in, Out&& out) {
+      using Q = _batch::element_t<In>;
+      using T = std::ranges::range_value_t<Out>;
+
+      if constexpr (_angle::reducible<Q>)
+        return _batch::unary<one, T>(_angle::component<_angle::kernel<Q>, false>(), in, out);
+      else
+        return _angle::in_radians<T>([](const T x) {return std::sin(x);}, in, out);
+    }
+
+    template <_batch::input In, _batch::output<decltype(cos(std::declval<_batch::element_t<In>>()))> Out>
+    auto cos(const In& in, Out&& out) {
+      using Q = _batch::element_t<In>;
+      using T = std::ranges::range_value_t<Out>;
+
+      if constexpr (_angle::reducible<Q>)
+        return _batch::unary<one, T>(_angle::component<_angle::kernel<Q>, true>(), in, out);
+      else
+        return _angle::in_radians<T>([](const T x) {return std::cos(x);}, in, out);
+    }
+
+    // min(in.size(), sin_out.size(), cos_out.size()) elements are computed, and the
+    // spans of written sines and cosines are returned
+    template <
+      _batch::input In,
+      _batch::output<decltype(sin(std::declval<_batch::element_t<In>>()))> SinOut,
+      _batch::output<decltype(cos(std::declval<_batch::element_t<In>>()))> CosOut>
+    auto sincos(const In& in, SinOut&& sin_out, CosOut&& cos_out) {
+      using Q = _batch::element_t<In>;
+      using T = std::ranges::range_value_t<SinOut>;
+
+      const auto n = std::min({std::ranges::size(in), std::ranges::size(sin_out), std::ranges::size(cos_out)});
+      const auto x = std::ranges::data(in);
+      const auto s = std::ranges::data(sin_out);
+      const auto c = std::ranges::data(cos_out);
+
+      if constexpr (_angle::reducible<Q>) {
+        using K = _angle::kernel<Q>;
+        constexpr std::size_t width = _simd::lanes<T>;
+
+        // blocked as in _batch::apply, with two outputs
+        _batch::blocks<width>(n, [&](const std::size_t i, const auto m) {
+          T sines[width], cosines[width];
+
+          for (std::size_t j = 0; j < width; ++j)
+            K::lane(T(x[i + _batch::lane(j, m)].get_value()), sines[j], cosines[j]);
+
+          _kernel::refine(m,
+            [&](const std::size_t j) {return K::fast(T(x[i+j].get_value()));},
+            [&](const std::size_t j) {K::exact(T(x[i+j].get_value()), sines[j], cosines[j]);});
+
+          for (std::size_t j = 0; j < m; ++j) {
+            s[i+j] = sines[j];
+            c[i+j] = cosines[j];
+          }
+        });
+      } else {
+        for (std::size_t i = 0; i < n; ++i) {
+          const auto r = sincos(x[i]);
+          s[i] = r.sin;
+          c[i] = r.cos;
+        }
+      }
+
+      return sincos_t<std::span<T>>{std::span(s, n), std::span(c, n)};
+    }
   }
 }
 
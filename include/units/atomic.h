@@ -0,0 +1,269 @@
+#ifndef _include_units_atomic_h
+#define _include_units_atomic_h
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <units/details/quantity.h>
+
+namespace units::_details {
+
+  namespace _atomic {
+
+    // * the value of a quantity of compatible unit, in units of U
+
+    // the conversion factor is a compile-time constant, so it costs at most a
+    // multiplication. accumulating into an integral quantity is only allowed when the
+    // converted value is still integral (for example, keV into eV but not eV into keV)
+    template <class U, class Q>
+    using converted_value_t = typename decltype(std::declval<Q>().template convert<U>())::value_type;
+
+    template <class U, class V, class Q>
+    concept addable = concepts::quantity_compatible<quantity<U, V>, Q> &&
+      (std::is_floating_point_v<V> || std::is_integral_v<converted_value_t<U, Q>>);
+
+    template <class U, class V>
+    constexpr V value_in(const concepts::quantity auto q) {
+      return static_cast<V>(q.template convert<U>().get_value());
+    }
+
+    // * size of a cache line, which shards are aligned to
+
+    // std::hardware_destructive_interference_size is not used since its value may
+    // change between compiler versions, and with it the layout of the accumulators
+    constexpr inline std::size_t cache_line = 64;
+
+    // * index of the calling thread, used to choose its shard
+
+    // threads are numbered in the order in which they first call this function, so
+    // that up to as many threads as shards all get a shard of their own
+    inline std::size_t thread_index() {
+      static std::atomic<std::size_t> next = 0;
+      thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+      return index;
+    }
+
+    // * default number of shards: one per hardware thread, rounded to a power of two
+    inline std::size_t default_shards() {
+      return std::bit_ceil(std::max<std::size_t>(std::thread::hardware_concurrency(), 1));
+    }
+
+  }
+
+  // - sharded accumulator
+
+  // a sum of quantities which many threads add to concurrently. each thread adds to
+  // its own shard, a counter in a cache line of its own, so that threads adding in
+  // a hot loop do not invalidate each other's caches. reading the sum merges the
+  // shards. additions are relaxed: a read concurrent with additions returns a sum
+  // that includes some of them, and a read after the adding threads are joined
+  // returns the exact total (for integral quantities; floating-point sums depend on
+  // the order in which they were merged)
+
+  template <concepts::quantity Q>
+  class sharded_accumulator {
+  public:
+    using quantity_type = Q;
+    using unit_type = typename Q::unit_type;
+    using value_type = typename Q::value_type;
+
+  private:
+    struct alignas(_atomic::cache_line) shard {
+      std::atomic<value_type> value = 0;
+    };
+
+    std::vector<shard> m_shards;
+    std::size_t m_mask;
+
+  public:
+    // * constructors
+
+    // the number of shards is rounded up to a power of two
+    explicit sharded_accumulator(const std::size_t shards = _atomic::default_shards())
+    : m_shards(std::bit_ceil(std::max<std::size_t>(shards, 1))), m_mask(m_shards.size() - 1) {}
+
+    std::size_t shards() const {
+      return m_shards.size();
+    }
+
+    // * addition of a quantity of compatible unit, to the shard of the calling thread
+
+    template <class Qa>
+    requires _atomic::addable<unit_type, value_type, Qa>
+    void add(const Qa q) {
+      m_shards[_atomic::thread_index() & m_mask].value.fetch_add(_atomic::value_in<unit_type, value_type>(q), std::memory_order_relaxed);
+    }
+
+    template <class Qa>
+    requires _atomic::addable<unit_type, value_type, Qa>
+    sharded_accumulator& operator+=(const Qa q) {
+      add(q);
+      return *this;
+    }
+
+    // * merge of the shards
+
+    Q load() const {
+      value_type sum = 0;
+      for (const auto& s : m_shards)
+        sum += s.value.load(std::memory_order_relaxed);
+      return Q(sum);
+    }
+
+    operator Q() const {
+      return load();
+    }
+
+    // the sum is returned and the accumulator is reset. additions concurrent with this
+    // call are either included in the returned sum or kept for the next one
+    Q exchange() {
+      value_type sum = 0;
+      for (auto& s : m_shards)
+        sum += s.value.exchange(0, std::memory_order_relaxed);
+      return Q(sum);
+    }
+
+    void reset() {
+      for (auto& s : m_shards)
+        s.value.store(0, std::memory_order_relaxed);
+    }
+  };
+
+}
+
+// - atomic quantities
+
+// std::atomic<quantity<U, V>> holds a std::atomic<V>, so it is lock-free whenever
+// std::atomic<V> is. besides the operations of std::atomic for any type, it has the
+// fetch_add and fetch_sub operations of arithmetic types, which accept quantities of
+// compatible units
+
+namespace std {
+
+  template <class U, class V>
+  struct atomic<units::_details::quantity<U, V>> {
+  public:
+    using value_type = units::_details::quantity<U, V>;
+    using difference_type = value_type;
+
+    static constexpr bool is_always_lock_free = std::atomic<V>::is_always_lock_free;
+
+  private:
+    std::atomic<V> m_value;
+
+  public:
+    // * constructors
+
+    constexpr atomic() noexcept : m_value(0) {}
+    constexpr atomic(const value_type q) noexcept : m_value(q.get_value()) {}
+
+    atomic(const atomic&) = delete;
+    atomic& operator=(const atomic&) = delete;
+    atomic& operator=(const atomic&) volatile = delete;
+
+    bool is_lock_free() const noexcept {
+      return m_value.is_lock_free();
+    }
+
+    // * load and store
+
+    void store(const value_type q, const std::memory_order order = std::memory_order_seq_cst) noexcept {
+      m_value.store(q.get_value(), order);
+    }
+
+    value_type load(const std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      return value_type(m_value.load(order));
+    }
+
+    value_type operator=(const value_type q) noexcept {
+      store(q);
+      return q;
+    }
+
+    operator value_type() const noexcept {
+      return load();
+    }
+
+    value_type exchange(const value_type q, const std::memory_order order = std::memory_order_seq_cst) noexcept {
+      return value_type(m_value.exchange(q.get_value(), order));
+    }
+
+    // * compare and exchange
+
+    bool compare_exchange_weak(value_type& expected, const value_type desired, const std::memory_order success, const std::memory_order failure) noexcept {
+      return m_value.compare_exchange_weak(expected.get_value(), desired.get_value(), success, failure);
+    }
+
+    bool compare_exchange_weak(value_type& expected, const value_type desired, const std::memory_order order = std::memory_order_seq_cst) noexcept {
+      return m_value.compare_exchange_weak(expected.get_value(), desired.get_value(), order);
+    }
+
+    bool compare_exchange_strong(value_type& expected, const value_type desired, const std::memory_order success, const std::memory_order failure) noexcept {
+      return m_value.compare_exchange_strong(expected.get_value(), desired.get_value(), success, failure);
+    }
+
+    bool compare_exchange_strong(value_type& expected, const value_type desired, const std::memory_order order = std::memory_order_seq_cst) noexcept {
+      return m_value.compare_exchange_strong(expected.get_value(), desired.get_value(), order);
+    }
+
+    // * arithmetic with quantities of compatible units, which return the previous value
+
+    template <class Q>
+    requires units::_details::_atomic::addable<U, V, Q>
+    value_type fetch_add(const Q q, const std::memory_order order = std::memory_order_seq_cst) noexcept {
+      return value_type(m_value.fetch_add(units::_details::_atomic::value_in<U, V>(q), order));
+    }
+
+    template <class Q>
+    requires units::_details::_atomic::addable<U, V, Q>
+    value_type fetch_sub(const Q q, const std::memory_order order = std::memory_order_seq_cst) noexcept {
+      return value_type(m_value.fetch_sub(units::_details::_atomic::value_in<U, V>(q), order));
+    }
+
+    // * compound assignment, which return the new value
+
+    template <class Q>
+    requires units::_details::_atomic::addable<U, V, Q>
+    value_type operator+=(const Q q) noexcept {
+      const auto x = units::_details::_atomic::value_in<U, V>(q);
+      return value_type(m_value.fetch_add(x) + x);
+    }
+
+    template <class Q>
+    requires units::_details::_atomic::addable<U, V, Q>
+    value_type operator-=(const Q q) noexcept {
+      const auto x = units::_details::_atomic::value_in<U, V>(q);
+      return value_type(m_value.fetch_sub(x) - x);
+    }
+
+    // * waiting and notifying
+
+    void wait(const value_type old, const std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      m_value.wait(old.get_value(), order);
+    }
+
+    void notify_one() noexcept {
+      m_value.notify_one();
+    }
+
+    void notify_all() noexcept {
+      m_value.notify_all();
+    }
+  };
+
+}
+
+namespace units {
+
+  // * concurrent accumulation of quantities
+
+  using _details::sharded_accumulator;
+
+}
+
+#endif
@@ -0,0 +1,405 @@
+#ifndef _include_units_columnar_h
+#define _include_units_columnar_h
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <units/dynamic.h>
+#include <units/framework.h>
+#include <units/span.h>
+
+namespace units::_details {
+
+  // - file layout
+
+  // a file holds a header, followed by a table with one entry per column and by the
+  // values of each column. every column entry records the name, the dimension and
+  // the exact factor of the unit, and the type of the values. values are stored in
+  // the byte order of the machine writing the file, each column starting at an
+  // offset aligned to 64 bytes, so that the mapped values can be used in place
+
+  namespace _columnar {
+
+    // * types of the values stored in a column
+
+    enum class value_code : std::uint8_t {
+      none, f32, f64, i8, i16, i32, i64, u8, u16, u32, u64
+    };
+
+    template <class V>
+    constexpr value_code code_of() {
+      if constexpr (std::is_same_v<V, float>) return value_code::f32;
+      else if constexpr (std::is_same_v<V, double>) return value_code::f64;
+      else if constexpr (std::is_same_v<V, std::int8_t>) return value_code::i8;
+      else if constexpr (std::is_same_v<V, std::int16_t>) return value_code::i16;
+      else if constexpr (std::is_same_v<V, std::int32_t>) return value_code::i32;
+      else if constexpr (std::is_same_v<V, std::int64_t>) return value_code::i64;
+      else if constexpr (std::is_same_v<V, std::uint8_t>) return value_code::u8;
+      else if constexpr (std::is_same_v<V, std::uint16_t>) return value_code::u16;
+      else if constexpr (std::is_same_v<V, std::uint32_t>) return value_code::u32;
+      else if constexpr (std::is_same_v<V, std::uint64_t>) return value_code::u64;
+      else return value_code::none;
+    }
+
+    // call f with a null pointer to the value type identified by code
+    template <class F>
+    constexpr bool visit(const value_code code, F&& f) {
+      switch (code) {
+        case value_code::f32: f(static_cast<float*>(nullptr)); return true;
+        case value_code::f64: f(static_cast<double*>(nullptr)); return true;
+        case value_code::i8: f(static_cast<std::int8_t*>(nullptr)); return true;
+        case value_code::i16: f(static_cast<std::int16_t*>(nullptr)); return true;
+        case value_code::i32: f(static_cast<std::int32_t*>(nullptr)); return true;
+        case value_code::i64: f(static_cast<std::int64_t*>(nullptr)); return true;
+        case value_code::u8: f(static_cast<std::uint8_t*>(nullptr)); return true;
+        case value_code::u16: f(static_cast<std::uint16_t*>(nullptr)); return true;
+        case value_code::u32: f(static_cast<std::uint32_t*>(nullptr)); return true;
+        case value_code::u64: f(static_cast<std::uint64_t*>(nullptr)); return true;
+        default: return false;
+      }
+    }
+
+    constexpr std::size_t size_of(const value_code code) {
+      std::size_t ret = 0;
+      visit(code, [&](auto* p){ret = sizeof(*p);});
+      return ret;
+    }
+
+    // * on-disk structures
+
+    constexpr char magic[8] = {'P', 'H', 'Y', 'S', 'C', 'O', 'L', '\0'};
+    constexpr std::uint32_t version = 1;
+    constexpr std::uint32_t byte_order = 0x01020304;
+    constexpr std::size_t alignment = 64;
+    constexpr std::size_t max_name_length = 31;
+
+    struct file_header {
+      char magic[8];
+      std::uint32_t version;
+      std::uint32_t byte_order;
+      std::uint64_t columns;
+      std::uint64_t reserved;
+    };
+
+    struct column_header {
+      char name[max_name_length + 1];
+      std::uint64_t dimension;
+      // the factor's numerator and denominator, as the low and high halves of intm_t
+      std::uint64_t num[2];
+      std::uint64_t den[2];
+      std::uint64_t size;
+      std::uint64_t offset;
+      value_code code;
+      std::uint8_t reserved[7];
+    };
+
+    static_assert(sizeof(file_header) == 32 && sizeof(column_header) == 96);
+    static_assert(std::is_trivially_copyable_v<file_header> && std::is_trivially_copyable_v<column_header>);
+
+    constexpr void split(const intm_t x, std::uint64_t (&halves)[2]) {
+      halves[0] = static_cast<std::uint64_t>(x);
+      halves[1] = static_cast<std::uint64_t>(x >> 64);
+    }
+
+    constexpr intm_t join(const std::uint64_t (&halves)[2]) {
+      return (intm_t(halves[1]) << 64) | intm_t(halves[0]);
+    }
+
+    constexpr std::size_t align(const std::size_t offset) {
+      return (offset + alignment - 1)/alignment*alignment;
+    }
+
+  }
+
+  // - description of a column
+
+  struct column_info {
+    std::string_view name;
+    unit_descriptor unit;
+    std::size_t size;
+    _columnar::value_code code;
+  };
+
+  // - writer of columnar files
+
+  // columns are only referenced when added, so their data must stay alive until the
+  // file is written. errors are reported by returning false
+
+  class column_writer {
+  private:
+    struct column {
+      _columnar::column_header header;
+      const void* data;
+    };
+
+    std::vector<column> m_columns;
+
+  public:
+
+    // * add a column, given a contiguous range of quantities
+    template <std::ranges::contiguous_range R>
+    requires concepts::quantity<std::ranges::range_value_t<R>>
+    bool add(const std::string_view name, const R& values) {
+      using quantity_type = std::ranges::range_value_t<R>;
+      using unit_type = typename quantity_type::unit_type;
+      using value_type = typename quantity_type::value_type;
+
+      static_assert(concepts::describable_unit<unit_type>, "Unit cannot be stored in a columnar file.");
+      static_assert(_columnar::code_of<value_type>() != _columnar::value_code::none, "Value type cannot be stored in a columnar file.");
+
+      if (name.empty() || name.size() > _columnar::max_name_length || contains(name))
+        return false;
+
+      column c = {};
+      std::copy(name.begin(), name.end(), c.header.name);
+      c.header.dimension = descriptor_of<unit_type>.dim.bits();
+      _columnar::split(descriptor_of<unit_type>.factor.num, c.header.num);
+      _columnar::split(descriptor_of<unit_type>.factor.den, c.header.den);
+      c.header.size = std::ranges::size(values);
+      c.header.code = _columnar::code_of<value_type>();
+      c.data = std::ranges::data(values);
+
+      m_columns.push_back(c);
+      return true;
+    }
+
+    // * whether a column with the given name has been added
+    bool contains(const std::string_view name) const {
+      for (const auto& c : m_columns)
+        if (name == c.header.name)
+          return true;
+      return false;
+    }
+
+    // * write all columns to the file at path
+    bool write(const std::filesystem::path& path) {
+      _columnar::file_header header = {};
+      std::copy(std::begin(_columnar::magic), std::end(_columnar::magic), header.magic);
+      header.version = _columnar::version;
+      header.byte_order = _columnar::byte_order;
+      header.columns = m_columns.size();
+
+      // lay out the columns after the column table
+      auto offset = _columnar::align(sizeof(header) + m_columns.size()*sizeof(_columnar::column_header));
+      for (auto& c : m_columns) {
+        c.header.offset = offset;
+        offset = _columnar::align(offset + c.header.size*_columnar::size_of(c.header.code));
+      }
+
+      const auto file = std::fopen(path.c_str(), "wb");
+      if (!file)
+        return false;
+
+      bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+      for (const auto& c : m_columns)
+        ok = ok && std::fwrite(&c.header, sizeof(c.header), 1, file) == 1;
+
+      for (const auto& c : m_columns) {
+        const auto bytes = c.header.size*_columnar::size_of(c.header.code);
+        ok = ok && std::fseek(file, c.header.offset, SEEK_SET) == 0;
+        ok = ok && (bytes == 0 || std::fwrite(c.data, bytes, 1, file) == 1);
+      }
+
+      // pad the file up to the end of the last column
+      ok = ok && std::fseek(file, 0, SEEK_END) == 0;
+      while (ok && static_cast<std::size_t>(std::ftell(file)) < offset)
+        ok = std::fputc(0, file) != EOF;
+
+      return (std::fclose(file) == 0) && ok;
+    }
+  };
+
+  // - memory-mapped reader of columnar files
+
+  // the file is mapped read-only and validated once, when opened. typed views of
+  // the columns point directly into the mapped memory
+
+  class column_file {
+  private:
+    const std::byte* m_data = nullptr;
+    std::size_t m_size = 0;
+
+    column_file(const std::byte* data, const std::size_t size) : m_data(data), m_size(size) {}
+
+    const _columnar::file_header& header() const {
+      return *reinterpret_cast<const _columnar::file_header*>(m_data);
+    }
+
+    const _columnar::column_header& column(const std::size_t i) const {
+      return reinterpret_cast<const _columnar::column_header*>(m_data + sizeof(_columnar::file_header))[i];
+    }
+
+    bool validate() const {
+      if (m_size < sizeof(_columnar::file_header))
+        return false;
+
+      const auto& h = header();
+      if (std::memcmp(h.magic, _columnar::magic, sizeof(h.magic)) != 0 ||
+          h.version != _columnar::version || h.byte_order != _columnar::byte_order)
+        return false;
+
+      if (h.columns > (m_size - sizeof(h))/sizeof(_columnar::column_header))
+        return false;
+
+      for (std::size_t i = 0; i < h.columns; ++i) {
+        const auto& c = column(i);
+        const auto element = _columnar::size_of(c.code);
+
+        if (element == 0 || c.name[_columnar::max_name_length] != '\0' || c.offset%_columnar::alignment != 0)
+          return false;
+
+        if (c.offset > m_size || c.size > (m_size - c.offset)/element)
+          return false;
+
+        if (!dimension::from_bits(c.dimension).valid() || _columnar::join(c.num) <= 0 || _columnar::join(c.den) <= 0)
+          return false;
+      }
+
+      return true;
+    }
+
+    std::optional<std::size_t> index(const std::string_view name) const {
+      for (std::size_t i = 0; i < size(); ++i)
+        if (name == column(i).name)
+          return i;
+      return std::nullopt;
+    }
+
+  public:
+    column_file(const column_file&) = delete;
+    column_file& operator=(const column_file&) = delete;
+
+    column_file(column_file&& other)
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) {}
+
+    column_file& operator=(column_file&& other) {
+      std::swap(m_data, other.m_data);
+      std::swap(m_size, other.m_size);
+      return *this;
+    }
+
+    ~column_file() {
+      if (m_data)
+        ::munmap(const_cast<std::byte*>(m_data), m_size);
+    }
+
+    // * map the file at path, returning nothing if it cannot be read or is malformed
+    static std::optional<column_file> open(const std::filesystem::path& path) {
+      const int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+        return std::nullopt;
+
+      struct stat st;
+      void* data = MAP_FAILED;
+
+      if (::fstat(fd, &st) == 0 && st.st_size > 0)
+        data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      // the mapping remains valid after the file is closed
+      ::close(fd);
+
+      if (data == MAP_FAILED)
+        return std::nullopt;
+
+      auto ret = column_file(static_cast<const std::byte*>(data), st.st_size);
+      if (!ret.validate())
+        return std::nullopt;
+
+      return ret;
+    }
+
+    // * number of columns
+    std::size_t size() const {return header().columns;}
+
+    // * description of the i-th column
+    column_info info(const std::size_t i) const {
+      const auto& c = column(i);
+      return {
+        c.name,
+        unit_descriptor::make(runtime_ratio::make(_columnar::join(c.num), _columnar::join(c.den)), dimension::from_bits(c.dimension)),
+        c.size,
+        c.code
+      };
+    }
+
+    // * description of the column with the given name
+    std::optional<column_info> info(const std::string_view name) const {
+      const auto i = index(name);
+      return i? std::optional(info(*i)) : std::nullopt;
+    }
+
+    // * zero-copy view of a column, if stored with unit U and value type V
+    template <concepts::describable_unit U, concepts::arithmetic V = double>
+    std::optional<quantity_span<U, const V>> view(const std::string_view name) const {
+      const auto i = index(name);
+
+      if (!i || column(*i).code != _columnar::code_of<V>() || info(*i).unit != descriptor_of<U>)
+        return std::nullopt;
+
+      const auto values = reinterpret_cast<const V*>(m_data + column(*i).offset);
+      return as_quantities<U>(std::span(values, column(*i).size));
+    }
+
+    // * copy a column into a buffer of quantities of unit U and value type V. values
+    // * are converted in a single batched pass if the column was stored with a
+    // * different, compatible unit or with a different value type. fails if units are
+    // * incompatible, if the buffer size does not match the size of the column, or if
+    // * any converted value does not fit in V, in which case the buffer is written anyway
+    template <std::ranges::contiguous_range R>
+    requires concepts::quantity<std::ranges::range_value_t<R>>
+    bool read(const std::string_view name, R&& values) const {
+      using quantity_type = std::ranges::range_value_t<R>;
+      const auto out = std::span<quantity_type>(std::ranges::data(values), std::ranges::size(values));
+
+      const auto i = index(name);
+
+      if (!i || column(*i).size != out.size())
+        return false;
+
+      const auto stored = info(*i);
+      constexpr auto& unit = descriptor_of<typename quantity_type::unit_type>;
+
+      if (!stored.unit.compatible(unit))
+        return false;
+
+      const auto factor = stored.unit.factor/unit.factor;
+      const auto dst = as_values(out).data();
+
+      bool fit = false;
+      return _columnar::visit(stored.code, [&](auto* type){
+        using stored_type = std::remove_pointer_t<decltype(type)>;
+        const auto src = reinterpret_cast<const stored_type*>(m_data + column(*i).offset);
+        fit = _dynamic::scale_n(src, out.size(), dst, factor);
+      }) && fit;
+    }
+  };
+
+}
+
+namespace units {
+
+  // * columnar files of quantities
+
+  using _details::column_info;
+  using _details::column_writer;
+  using _details::column_file;
+
+}
+
+#endif
@@ -0,0 +1,304 @@
+#ifndef _include_units_details_descriptor_h
+#define _include_units_details_descriptor_h
+
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+
+#include <units/details/ratio.h>
+#include <units/details/unit.h>
+
+namespace units::_details {
+
+  // - forward declarations
+
+  class dimension;
+  struct runtime_ratio;
+  struct unit_descriptor;
+
+  // - definition of the dimension class
+
+  // the exponents of all base units packed into a single 64-bit word, one signed
+  // 6-bit field per base unit id: two dimensions are equal if and only if their
+  // words are equal, and products of units are computed with a couple of integer
+  // operations on the words. the unused upper bits flag invalid dimensions, which
+  // are the result of any operation whose exponents do not fit into their fields
+
+  class dimension {
+  public:
+    static constexpr unsigned field_bits = 6;
+    static constexpr unsigned size = 64/field_bits;
+    static constexpr int max_exponent = (1 << (field_bits - 1)) - 1;
+    static constexpr int min_exponent = -(1 << (field_bits - 1));
+
+  private:
+    static constexpr std::uint64_t field_mask = (std::uint64_t(1) << field_bits) - 1;
+    static constexpr std::uint64_t used_mask = (std::uint64_t(1) << (size*field_bits)) - 1;
+    static constexpr std::uint64_t invalid_bits = ~std::uint64_t(0);
+
+    // the lowest and the highest (sign) bit of every field
+    static constexpr std::uint64_t low_bits = used_mask/field_mask;
+    static constexpr std::uint64_t high_bits = low_bits << (field_bits - 1);
+
+    std::uint64_t m_bits = 0;
+
+    constexpr explicit dimension(const std::uint64_t bits) : m_bits(bits) {}
+
+    // sum of the fields of a and b, flagging overflow if the sign of any field
+    // comes out different from the sign shared by its operands
+    static constexpr dimension add(const std::uint64_t a, const std::uint64_t b) {
+      const auto sum = ((a & ~high_bits) + (b & ~high_bits)) ^ ((a ^ b) & high_bits);
+      const auto overflow = ~(a ^ b) & (a ^ sum) & high_bits;
+      return dimension(overflow? invalid_bits : sum);
+    }
+
+  public:
+    // * the dimensionless dimension
+    constexpr dimension() = default;
+
+    // * a dimension resulting from an invalid operation
+    static constexpr dimension invalid() {return dimension(invalid_bits);}
+
+    // * the dimension from its packed representation, as returned by bits()
+    static constexpr dimension from_bits(const std::uint64_t bits)
+    {return dimension((bits & ~used_mask)? invalid_bits : bits);}
+
+    // * the dimension of a single base unit raised to the given exponent
+    static constexpr dimension base(const unsigned id, const int exponent = 1) {
+      if (id >= size || exponent < min_exponent || exponent > max_exponent)
+        return invalid();
+
+      return dimension((std::uint64_t(exponent) & field_mask) << (id*field_bits));
+    }
+
+    constexpr std::uint64_t bits() const {return m_bits;}
+    constexpr bool valid() const {return m_bits != invalid_bits;}
+    constexpr bool dimensionless() const {return m_bits == 0;}
+
+    // * exponent of the base unit with the given id
+    constexpr int exponent(const unsigned id) const {
+      if (!valid() || id >= size)
+        return 0;
+
+      const auto field = int((m_bits >> (id*field_bits)) & field_mask);
+      return (field > max_exponent)? field - (1 << field_bits) : field;
+    }
+
+    // * dimension of the product of units: exponents are added
+    friend constexpr dimension operator*(const dimension a, const dimension b) {
+      if (!a.valid() || !b.valid())
+        return invalid();
+
+      return add(a.m_bits, b.m_bits);
+    }
+
+    // * dimension of the inverse of a unit: exponents are negated
+    constexpr dimension inverse() const {
+      if (!valid())
+        return invalid();
+
+      // the two's complement in every field, ~x + 1
+      return add(~m_bits & used_mask, low_bits);
+    }
+
+    // * dimension of the ratio of units
+    friend constexpr dimension operator/(const dimension a, const dimension b)
+    {return a*b.inverse();}
+
+    // * dimension of the integral power of a unit
+    constexpr dimension pow(const int n) const {
+      if (n == 1 || n == -1)
+        return (n == 1)? *this : inverse();
+
+      dimension ret;
+
+      // only the fields of the base units actually present need to be visited
+      for (unsigned id = 0; id < size && (m_bits >> (id*field_bits)) != 0 && ret.valid(); ++id) {
+        const auto e = static_cast<long long>(exponent(id))*n;
+
+        if (e < min_exponent || e > max_exponent)
+          return invalid();
+
+        if (e != 0)
+          ret = ret*base(id, int(e));
+      }
+
+      return valid()? ret : invalid();
+    }
+
+    friend constexpr bool operator==(const dimension, const dimension) = default;
+  };
+
+  // - definition of the runtime ratio
+
+  // the factor of a unit, as an exact fraction kept in reduced form with a positive
+  // denominator. a null denominator flags an invalid ratio, which is the result of
+  // any operation that would overflow intm_t
+
+  struct runtime_ratio {
+    intm_t num = 1;
+    intm_t den = 1;
+
+    // * a reduced ratio, or an invalid one if den is null
+    static constexpr runtime_ratio make(const intm_t n, const intm_t d) {
+      if (d == 0)
+        return invalid();
+
+      // most factors fit into 64 bits, where divisions are much cheaper
+      if (n == std::int64_t(n) && d == std::int64_t(d) &&
+          n != std::numeric_limits<std::int64_t>::min() && d != std::numeric_limits<std::int64_t>::min()) {
+        const auto a = std::int64_t(n), b = std::int64_t(d);
+        const auto div = std::gcd(a, b);
+        return (b > 0)? runtime_ratio{a/div, b/div} : runtime_ratio{-(a/div), -(b/div)};
+      }
+
+      const auto div = gcd(n, d);
+      return (d > 0)? runtime_ratio{n/div, d/div} : runtime_ratio{-n/div, -d/div};
+    }
+
+    static constexpr runtime_ratio invalid() {return {0, 0};}
+
+    // * the runtime ratio corresponding to a ratio type
+    template <concepts::ratio R>
+    static constexpr runtime_ratio of() {return {R::num, R::den};}
+
+    constexpr bool valid() const {return den != 0;}
+
+    template <std::floating_point T>
+    constexpr T value() const {return static_cast<T>(num)/static_cast<T>(den);}
+
+    friend constexpr runtime_ratio operator*(const runtime_ratio a, const runtime_ratio b) {
+      if (!a.valid() || !b.valid())
+        return invalid();
+
+      // most units have a unit factor
+      if (a == runtime_ratio{})
+        return b;
+      if (b == runtime_ratio{})
+        return a;
+
+      // cross-reduce first, as done for ratio_multiply, to postpone overflows. the
+      // reductions are skipped for unit denominators, as 128-bit divisions are slow
+      const auto x = (b.den == 1)? runtime_ratio{a.num, 1} : make(a.num, b.den);
+      const auto y = (a.den == 1)? runtime_ratio{b.num, 1} : make(b.num, a.den);
+
+      intm_t num, den;
+      if (__builtin_mul_overflow(x.num, y.num, &num) || __builtin_mul_overflow(x.den, y.den, &den))
+        return invalid();
+
+      return {num, den};
+    }
+
+    constexpr runtime_ratio inverse() const
+    {return (valid() && num != 0)? make(den, num) : invalid();}
+
+    friend constexpr runtime_ratio operator/(const runtime_ratio a, const runtime_ratio b) {
+      // the ratio between equal factors is the common case when converting values
+      if (a == b && a.valid() && a.num != 0)
+        return {};
+
+      return a*b.inverse();
+    }
+
+    constexpr runtime_ratio pow(const int n) const {
+      auto ret = runtime_ratio{};
+      auto base = (n < 0)? inverse() : *this;
+
+      for (auto e = (n < 0)? -static_cast<long long>(n) : n; e > 0 && ret.valid(); e /= 2) {
+        if (e%2 != 0)
+          ret = ret*base;
+        if (e > 1)
+          base = base*base;
+      }
+
+      return valid()? ret : invalid();
+    }
+
+    friend constexpr bool operator==(const runtime_ratio&, const runtime_ratio&) = default;
+  };
+
+  // - traits
+
+  namespace traits {
+    // * assert unit can be described at runtime: its powers must be integral and
+    // * fit into the fields of the dimension class
+    template <class T>
+    struct is_describable_unit : std::false_type {};
+
+    template <concepts::reduced_ratio R, concepts::reduced_power... Ps>
+    requires ((Ps::exponent::den == 1 && Ps::base::index < dimension::size &&
+      Ps::exponent::num >= dimension::min_exponent && Ps::exponent::num <= dimension::max_exponent) && ...)
+    struct is_describable_unit<unit<R, Ps...>> : std::true_type {};
+
+    template <class T>
+    constexpr inline bool is_describable_unit_v = is_describable_unit<T>::value;
+  }
+
+  // - concepts
+
+  namespace concepts {
+    // * units with a runtime descriptor
+    template <class T>
+    concept describable_unit = traits::is_describable_unit_v<T>;
+  }
+
+  // - definition of the unit descriptor
+
+  // runtime counterpart of the unit class: a unit is fully described by its
+  // dimension and its factor with respect to the base units
+
+  struct unit_descriptor {
+    runtime_ratio factor;
+    dimension dim;
+
+    static constexpr unit_descriptor invalid()
+    {return {runtime_ratio::invalid(), dimension::invalid()};}
+
+    // * descriptor from factor and dimension. invalid descriptors always carry an
+    // * invalid dimension, so that compatibility is decided by the dimensions alone
+    static constexpr unit_descriptor make(const runtime_ratio& factor, const dimension dim)
+    {return (factor.valid() && dim.valid())? unit_descriptor{factor, dim} : invalid();}
+
+    constexpr bool valid() const {return factor.valid() && dim.valid();}
+
+    // * units are compatible if they differ only by their factors
+    constexpr bool compatible(const unit_descriptor& other) const
+    {return dim == other.dim && dim.valid();}
+
+    friend constexpr unit_descriptor operator*(const unit_descriptor& a, const unit_descriptor& b)
+    {return make(a.factor*b.factor, a.dim*b.dim);}
+
+    friend constexpr unit_descriptor operator/(const unit_descriptor& a, const unit_descriptor& b)
+    {return make(a.factor/b.factor, a.dim/b.dim);}
+
+    constexpr unit_descriptor inverse() const
+    {return make(factor.inverse(), dim.inverse());}
+
+    constexpr unit_descriptor pow(const int n) const
+    {return make(factor.pow(n), dim.pow(n));}
+
+    friend constexpr bool operator==(const unit_descriptor&, const unit_descriptor&) = default;
+  };
+
+  // * descriptor of a unit type
+
+  namespace _descriptor {
+    template <class U>
+    struct of;
+
+    template <class R, class... Ps>
+    struct of<unit<R, Ps...>> {
+      static constexpr unit_descriptor value = {
+        runtime_ratio::of<R>(),
+        (dimension() * ... * dimension::base(Ps::base::index, int(Ps::exponent::num)))
+      };
+    };
+  }
+
+  template <concepts::describable_unit U>
+  constexpr inline unit_descriptor descriptor_of = _descriptor::of<U>::value;
+
+}
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef _include_units_details_fixed_h
+#define _include_units_details_fixed_h
+
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+#include <units/details/ratio.h>
+
+namespace units::_details {
+
+  // - rounding and overflow policies of integral conversions
+
+  // * rounding: towards zero, or to the nearest integer with ties away from zero
+  namespace rounding {
+    struct truncate {};
+    struct nearest {};
+  }
+
+  // * overflow: unchecked (wrapping), clamped to the range of the result, or
+  // * reported by returning an empty std::optional
+  namespace overflow {
+    struct wrap {};
+    struct saturate {};
+    struct checked {};
+  }
+
+  namespace traits {
+    template <class T>
+    struct is_rounding_policy : std::false_type {};
+
+    template <>
+    struct is_rounding_policy<rounding::truncate> : std::true_type {};
+
+    template <>
+    struct is_rounding_policy<rounding::nearest> : std::true_type {};
+
+    template <class T>
+    constexpr inline bool is_rounding_policy_v = is_rounding_policy<T>::value;
+
+    template <class T>
+    struct is_overflow_policy : std::false_type {};
+
+    template <>
+    struct is_overflow_policy<overflow::wrap> : std::true_type {};
+
+    template <>
+    struct is_overflow_policy<overflow::saturate> : std::true_type {};
+
+    template <>
+    struct is_overflow_policy<overflow::checked> : std::true_type {};
+
+    template <class T>
+    constexpr inline bool is_overflow_policy_v = is_overflow_policy<T>::value;
+  }
+
+  namespace concepts {
+    template <class T>
+    concept rounding_policy = traits::is_rounding_policy_v<T>;
+
+    template <class T>
+    concept overflow_policy = traits::is_overflow_policy_v<T>;
+  }
+
+  // - scale an integer by a compile-time ratio, staying integral
+
+  // the factor num/den is split into its integer part k and remainder r, and x into
+  // a = x/den and b = x%den, so that
+  //
+  //   x*num/den = x*k + a*r + b*r/den
+  //
+  // where the last term is the only fractional one. when den < 2^31 (or r = 1, as
+  // for any prefix), b*r fits in 64 bits, so the whole computation is carried out in
+  // 64-bit integers, and divisions by the constant den are compiled into
+  // multiplications by its reciprocal. other factors go through intm_t. either way,
+  // the result is exact before rounding
+
+  namespace _fixed {
+
+    // * result of a scaling: the value and whether it overflowed
+    template <class T>
+    struct result {
+      T value;
+      bool overflowed;
+    };
+
+    // * sign test that also holds for intm_t, and does not warn for unsigned types
+    template <class T>
+    constexpr bool negative(const T x) {
+      if constexpr (T(-1) < T(0))
+        return x < 0;
+      else
+        return false;
+    }
+
+    // * value fits in the integral type W (T may be intm_t, so std::in_range is not used)
+    template <std::integral W, class T>
+    constexpr bool fits(const T x) {
+      return intm_t(x) >= intm_t(std::numeric_limits<W>::min()) &&
+        intm_t(x) <= intm_t(std::numeric_limits<W>::max());
+    }
+
+    // * round the truncated quotient of a division by den, given its remainder rem
+    template <class T, class R>
+    constexpr void round(result<T>& ret, const T x, const T rem, const T den) {
+      if constexpr (std::is_same_v<R, rounding::nearest>) {
+        // rem has the sign of x, ties are rounded away from zero
+        const T mag = negative(rem)? -rem : rem;
+        if (mag >= den - mag)
+          ret.overflowed |= __builtin_add_overflow(ret.value, negative(x)? T(-1) : T(1), &ret.value);
+      }
+    }
+
+    template <concepts::ratio F, class R, std::integral T>
+    constexpr auto exact(const T x) {
+      static_assert(F::num > 0, "Integral conversions require a positive factor.");
+
+      using wide = std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>;
+      constexpr intm_t k = F::num/F::den;
+      constexpr intm_t r = F::num%F::den;
+
+      if constexpr (fits<wide>(k) && fits<wide>(F::den) && (F::den < (intm_t(1) << 31) || r == 1)) {
+        result<wide> ret = {0, false};
+        const wide v = x;
+
+        if constexpr (k != 0)
+          ret.overflowed = __builtin_mul_overflow(v, wide(k), &ret.value);
+
+        if constexpr (r != 0) {
+          constexpr wide den = F::den;
+          const wide a = v/den;
+          const wide br = (v%den) * wide(r);
+
+          ret.overflowed |= __builtin_add_overflow(ret.value, a*wide(r) + br/den, &ret.value);
+          round<wide, R>(ret, v, br%den, den);
+        }
+
+        return ret;
+      } else {
+        result<intm_t> ret = {0, false};
+        intm_t p;
+        ret.overflowed = __builtin_mul_overflow(intm_t(x), intm_t(F::num), &p);
+
+        ret.value = p/F::den;
+        round<intm_t, R>(ret, p, p%F::den, F::den);
+
+        return ret;
+      }
+    }
+
+    // * the scaled value, converted to W according to the overflow policy
+    template <concepts::ratio F, std::integral W, concepts::rounding_policy R, concepts::overflow_policy O, std::integral T>
+    constexpr auto scale(const T x) {
+      const auto [value, overflowed] = exact<F, R>(x);
+      const bool fail = overflowed || !fits<W>(value);
+
+      if constexpr (std::is_same_v<O, overflow::wrap>) {
+        return static_cast<W>(value);
+      } else if constexpr (std::is_same_v<O, overflow::saturate>) {
+        if (fail)
+          return negative(x)? std::numeric_limits<W>::min() : std::numeric_limits<W>::max();
+        return static_cast<W>(value);
+      } else {
+        return fail? std::nullopt : std::optional<W>(static_cast<W>(value));
+      }
+    }
+
+  }
+
+}
+
+#endif
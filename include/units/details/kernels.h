@@ -0,0 +1,339 @@
+#ifndef _include_units_details_kernels_h
+#define _include_units_details_kernels_h
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__SSE2__) && !defined(__NO_MATH_ERRNO__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__) && !defined(__NO_MATH_ERRNO__)
+#include <arm_neon.h>
+#endif
+
+#include <units/details/ratio.h>
+#include <units/details/simd.h>
+
+// kernels of the batch math functions. each kernel computes, for a single element,
+// a fast approximation that the compiler can vectorize when evaluated over blocks
+// of _simd::lanes elements (lane), the range of arguments over which it is accurate
+// (fast), and a reference scalar implementation for the remaining arguments (exact).
+// lanes are computed in double precision, so they are only used for float and double
+
+namespace units::_details::_kernel {
+
+  // - exact lanes of a block
+
+  // once the fast approximations of the m lanes of a block are computed, the lanes
+  // whose arguments are out of the range of the kernel are computed again: fast(j)
+  // tells whether lane j is accurate, and exact(j) recomputes it. there is a single
+  // branch per block in the common case of all arguments in range
+  template <class F, class E>
+  constexpr void refine(const std::size_t m, const F& fast, const E& exact) {
+    bool all = true;
+    for (std::size_t j = 0; j < m; ++j)
+      all &= fast(j);
+
+    if (!all) {
+      for (std::size_t j = 0; j < m; ++j)
+        if (!fast(j))
+          exact(j);
+    }
+  }
+
+  // - square root
+
+  // calls to std::sqrt are never vectorized unless errno is disabled (as with
+  // -fno-math-errno), so the vector instruction is used directly where available,
+  // once the whole block is computed. as std::sqrt, the result is correctly rounded,
+  // but errno is never set
+  struct sqrt {
+    template <class T>
+    static bool fast(const T)
+    {return true;}
+
+    template <class T>
+    static T lane(const T x)
+    {return x;}
+
+    template <class T, std::size_t N>
+    static void finish(T (&block)[N]) {
+#if defined(__SSE2__) && !defined(__NO_MATH_ERRNO__)
+      if constexpr (std::is_same_v<T, double> && N%2 == 0) {
+        for (std::size_t j = 0; j < N; j += 2)
+          _mm_storeu_pd(block + j, _mm_sqrt_pd(_mm_loadu_pd(block + j)));
+        return;
+      } else if constexpr (std::is_same_v<T, float> && N%4 == 0) {
+        for (std::size_t j = 0; j < N; j += 4)
+          _mm_storeu_ps(block + j, _mm_sqrt_ps(_mm_loadu_ps(block + j)));
+        return;
+      }
+#elif defined(__ARM_NEON) && defined(__aarch64__) && !defined(__NO_MATH_ERRNO__)
+      if constexpr (std::is_same_v<T, double> && N%2 == 0) {
+        for (std::size_t j = 0; j < N; j += 2)
+          vst1q_f64(block + j, vsqrtq_f64(vld1q_f64(block + j)));
+        return;
+      } else if constexpr (std::is_same_v<T, float> && N%4 == 0) {
+        for (std::size_t j = 0; j < N; j += 4)
+          vst1q_f32(block + j, vsqrtq_f32(vld1q_f32(block + j)));
+        return;
+      }
+#endif
+      for (std::size_t j = 0; j < N; ++j)
+        block[j] = std::sqrt(block[j]);
+    }
+
+    template <class T>
+    static T exact(const T x)
+    {return std::sqrt(x);}
+  };
+
+  // - exponential
+
+  // with x = n*ln2 + r, |r| <= ln2/2, exp(x) = 2^n * exp(r). n is rounded by adding
+  // a large constant, whose low mantissa bits then hold n, and 2^n is built from
+  // them directly. exp(r) is a degree 13 taylor polynomial, whose truncation error
+  // is below 2^-60. lanes are within 1 ulp of the correctly rounded result
+  struct exp {
+    static constexpr double shifter = 0x1.8p52;
+
+    // the result, and 2^n, are normal numbers
+    template <class T>
+    static bool fast(const T x)
+    {return std::abs(x) <= (std::is_same_v<T, float>? T(87) : T(708));}
+
+    template <class T>
+    static T lane(const T value) {
+      const double x = value;
+      const double t = x*0x1.71547652b82fep0 + shifter;
+      const double n = t - shifter;
+      // ln2 split in two, so that n*ln2_hi is exact
+      const double r = (x - n*0x1.62e42fefa3800p-1) - n*0x1.ef35793c7673p-45;
+
+      double p = 1.0/6227020800;
+      p = p*r + 1.0/479001600;
+      p = p*r + 1.0/39916800;
+      p = p*r + 1.0/3628800;
+      p = p*r + 1.0/362880;
+      p = p*r + 1.0/40320;
+      p = p*r + 1.0/5040;
+      p = p*r + 1.0/720;
+      p = p*r + 1.0/120;
+      p = p*r + 1.0/24;
+      p = p*r + 1.0/6;
+      p = p*r + 0.5;
+      p = 1.0 + (r + r*r*p);
+
+      const auto scale = std::bit_cast<double>((std::bit_cast<std::uint64_t>(t) + 1023) << 52);
+      return static_cast<T>(p*scale);
+    }
+
+    template <class T>
+    static T exact(const T x)
+    {return std::exp(x);}
+  };
+
+  // - natural logarithm
+
+  // with x = 2^e * m, sqrt(2)/2 <= m < sqrt(2), log(x) = e*ln2 + log(m), and
+  // log(m) = 2*atanh(s), s = (m - 1)/(m + 1), is a series in s^2 <= 0.0295 of which
+  // ten terms are taken. lanes are within 1 ulp of the correctly rounded result
+  struct log {
+    template <class T>
+    static bool fast(const T x)
+    {return x >= std::numeric_limits<T>::min() && x <= std::numeric_limits<T>::max();}
+
+    template <class T>
+    static T lane(const T value) {
+      // subtracting the bits of sqrt(2)/2 moves the exponent boundary there, so that
+      // the exponent e and the mantissa m in [sqrt(2)/2, sqrt(2)) are split without
+      // branches. 2^62 is added to keep the difference positive: the biased exponent
+      // e + 1024 is then converted into a double by placing it in the mantissa of
+      // 2^52, which is then subtracted
+      const auto bits = std::bit_cast<std::uint64_t>(double(value));
+      const auto biased = (bits - 0x3fe6a09e667f3bcd + 0x4000000000000000) >> 52;
+
+      const double m = std::bit_cast<double>(bits - ((biased - 1024) << 52));
+      const double e = std::bit_cast<double>(biased | 0x4330000000000000) - 0x1.00000000004p52;
+
+      const double f = m - 1;
+      const double s = f/(2 + f);
+      const double z = s*s;
+
+      double p = 2.0/21;
+      p = p*z + 2.0/19;
+      p = p*z + 2.0/17;
+      p = p*z + 2.0/15;
+      p = p*z + 2.0/13;
+      p = p*z + 2.0/11;
+      p = p*z + 2.0/9;
+      p = p*z + 2.0/7;
+      p = p*z + 2.0/5;
+      p = p*z + 2.0/3;
+
+      // 2s + s*z*p, rearranged as in fdlibm so that the largest term, f, is exact
+      const double hf = 0.5*f*f;
+      const double log_m = f - (hf - s*(hf + z*p));
+
+      return static_cast<T>(e*0x1.62e42fefa3800p-1 + (e*0x1.ef35793c7673p-45 + log_m));
+    }
+
+    template <class T>
+    static T exact(const T x)
+    {return std::log(x);}
+  };
+
+  // - sine and cosine of angles in units of which a quarter turn, Q, is exact
+
+  // x is reduced in its own unit: with k the nearest integer to x/Q, r = x - k*Q is
+  // computed exactly, as x and k*Q are both multiples of the smaller of their ulps,
+  // and |r| <= Q/2. only then r is converted to radians, theta = r*pi/(2Q), with
+  // pi/(2Q) held in two parts, and sin and cos of theta are taylor polynomials of
+  // degree 15 and 16 in |theta| <= pi/4. the quadrant k mod 4 swaps and negates them
+  // using bit operations only. so multiples of Q are exact: sin(180 deg) is zero,
+  // cos(90 deg) is zero, whatever the magnitude. lanes are within 1.2 ulp of the
+  // exact result. angles so large that k*Q would not be exact are first reduced
+  // with std::fmod, which is exact too. the rounding error of a product is found by
+  // a fused multiply-add where the target has one, and by dekker's product otherwise:
+  // the splitting of dekker's product is only exact if the compiler does not contract
+  // it into fused operations, which it can only do on targets with a fused multiply-add
+  template <concepts::ratio Q>
+  struct sincos {
+    static_assert(std::has_single_bit(std::uint64_t(Q::den)), "A quarter turn must be exactly representable.");
+
+    static constexpr double quarter = double(Q::num)/double(Q::den);
+    static constexpr double inverse_quarter = 1/quarter;
+    static constexpr double shifter = 0x1.8p52;
+
+    // pi/(2Q) in two parts, from pi/2 = pio2_hi + pio2_lo, using dekker's exact
+    // product to get the rounding error of pio2_hi/Q
+    static constexpr double pio2_hi = 0x1.921fb54442d18p0;
+    static constexpr double pio2_lo = 0x1.1a62633145c07p-54;
+
+    static constexpr double split(const double a)
+    {return 134217729*a - (134217729*a - a);}
+
+    // the rounding error of p = a*b. constant evaluation never contracts
+    static constexpr double product_error(const double a, const double b, const double p) {
+#if defined(__FMA__) || defined(__FP_FAST_FMA) || defined(__ARM_FEATURE_FMA)
+      if (!std::is_constant_evaluated())
+        return std::fma(a, b, -p);
+#endif
+      const double ah = split(a), al = a - ah;
+      const double bh = split(b), bl = b - bh;
+      return ((ah*bh - p) + ah*bl + al*bh) + al*bl;
+    }
+
+    static constexpr double scale_hi = pio2_hi/quarter;
+    static constexpr double scale_lo =
+      ((pio2_hi - scale_hi*quarter) - product_error(scale_hi, quarter, scale_hi*quarter) + pio2_lo)/quarter;
+
+    // k*Q is exact as long as k has no more bits than the mantissa leaves to Q::num,
+    // and k is rounded exactly by the shifter as long as |k| <= 2^51
+    static constexpr double limit = quarter*double(std::uint64_t(1) << std::min(51, 53 - int(std::bit_width(std::uint64_t(Q::num)))));
+
+    template <class T>
+    static bool fast(const T x)
+    {return std::abs(x) <= T(limit);}
+
+    // too large to be inlined by default, which would prevent vectorization. inline is
+    // explicit because functions defined in classes are not implicitly inline in modules
+    template <class T>
+    [[gnu::always_inline]] static inline void lane(const T value, T& sin, T& cos) {
+      const double x = value;
+      const double t = x*inverse_quarter + shifter;
+      const double k = t - shifter;
+      const double r = x - k*quarter;
+      // theta is held as theta + delta, where delta collects the rounding error of
+      // r*scale_hi, found exactly by dekker's product, and the low part of the scale
+      const double p = r*scale_hi;
+      const double theta = p + r*scale_lo;
+      const double delta = (p - theta) + r*scale_lo + product_error(r, scale_hi, p);
+      const double z = theta*theta;
+
+      double ps = -1.0/1307674368000;
+      ps = ps*z + 1.0/6227020800;
+      ps = ps*z - 1.0/39916800;
+      ps = ps*z + 1.0/362880;
+      ps = ps*z - 1.0/5040;
+      ps = ps*z + 1.0/120;
+      ps = ps*z - 1.0/6;
+
+      double pc = 1.0/20922789888000;
+      pc = pc*z - 1.0/87178291200;
+      pc = pc*z + 1.0/479001600;
+      pc = pc*z - 1.0/3628800;
+      pc = pc*z + 1.0/40320;
+      pc = pc*z - 1.0/720;
+      pc = pc*z + 1.0/24;
+
+      const auto s = std::bit_cast<std::uint64_t>(theta + (delta + theta*z*ps));
+      // 1 - z/2 is rounded once, and its rounding error is added back as in fdlibm
+      const double hz = 0.5*z;
+      const double w = 1 - hz;
+      const auto c = std::bit_cast<std::uint64_t>(w + ((((1 - w) - hz) - theta*delta) + z*z*pc));
+
+      // the low mantissa bits of t hold k: odd quadrants swap sin and cos, the
+      // sine is negative in quadrants 2 and 3, the cosine in quadrants 1 and 2.
+      // signs are only applied to nonzero results, so that the exact zeros at
+      // multiples of a quarter turn are positive
+      const auto n = std::bit_cast<std::uint64_t>(t);
+      const auto swap = std::uint64_t(0) - (n & 1);
+      const auto sv = (s & ~swap) | (c & swap);
+      const auto cv = (c & ~swap) | (s & swap);
+      const auto nonzero = [](const std::uint64_t v) {return std::uint64_t(0) - std::uint64_t((v << 1) != 0);};
+
+      sin = static_cast<T>(std::bit_cast<double>(sv ^ (((n & 2) << 62) & nonzero(sv))));
+      cos = static_cast<T>(std::bit_cast<double>(cv ^ ((((n + 1) & 2) << 62) & nonzero(cv))));
+    }
+
+    template <class T>
+    static void exact(const T x, T& sin, T& cos) {
+      double s, c;
+      lane(std::fmod(double(x), 4*quarter), s, c);
+      sin = static_cast<T>(s);
+      cos = static_cast<T>(c);
+    }
+
+    template <class T>
+    static void evaluate(const T x, T& sin, T& cos) {
+      if (fast(x))
+        lane(x, sin, cos);
+      else
+        exact(x, sin, cos);
+    }
+  };
+
+  // - hypotenuse
+
+  // sqrt(x^2 + y^2) is accurate as long as the sum of squares neither overflows nor
+  // underflows. lanes are then within 1.5 ulp of the correctly rounded result
+  struct hypot {
+    // when the sum is large enough, the square of the smaller argument is only
+    // allowed to underflow if it is negligible anyway
+    template <class T>
+    static bool fast(const T x, const T y) {
+      const T s = x*x + y*y;
+      return s >= std::numeric_limits<T>::min()*T(0x1p54) && s <= std::numeric_limits<T>::max();
+    }
+
+    template <class T>
+    static T lane(const T x, const T y)
+    {return x*x + y*y;}
+
+    template <class T, std::size_t N>
+    static void finish(T (&block)[N])
+    {_kernel::sqrt::finish(block);}
+
+    template <class T>
+    static T exact(const T x, const T y)
+    {return std::hypot(x, y);}
+  };
+
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef _include_units_details_macros_h
 #define _include_units_details_macros_h
 
+#include <string_view>
 #include <type_traits>
 
 // - helper macros
@@ -45,6 +46,12 @@ namespace units {
 // one as defined in the units namespace
 #define units_assert_namespace \
   struct units_namespace_assert_type; \
+  units_assert_namespace_lookup
+
+// the dummy type is attached to the global module, and cannot be declared again in
+// the purview of the units modules. there, the macro is replaced by this check alone,
+// that unqualified lookup finds the dummy type (see modules/global.h)
+#define units_assert_namespace_lookup \
   static_assert(\
     std::is_same_v<units_namespace_assert_type, ::units::units_namespace_assert_type>, \
     "Units macros can only be used within the ::units namespace" );
@@ -53,7 +60,13 @@ namespace units {
 
 #define units_set_symbol(_unit_, _symbol_) \
   units_assert_namespace \
-  template <> constexpr inline auto _details::_unit::symbol<_unit_> = _details::string(#_symbol_);
+  template <> constexpr inline std::string_view _details::_unit::symbol<_unit_> = #_symbol_;
+
+// * specialize the template variable containing the name of the given unit
+
+#define units_set_name(_unit_) \
+  units_assert_namespace \
+  template <> constexpr inline std::string_view _details::_unit::name<_unit_> = #_unit_;
 
 // * create a literal operator using the given symbol for the given unit
 
@@ -102,19 +115,22 @@ namespace units {
 #define units_set_all_prefixes(_unit_, _symbol_) \
   units_set_prefixes(_unit_, _symbol_, femto, pico, nano, micro, milli, centi, deci, deca, hecto, kilo, mega, giga, tera, peta, exa)
 
-// * create aliases for a base unit with given id, then set its symbol and 
+// * create aliases for a base unit with given id, then set its name and symbol and
 // * create a literal operator
 
 #define units_add_base_unit(_id_, _name_, _symbol_) units_assert_namespace \
   using _name_   = _details::base_unit<_id_>; \
+  units_set_name(_name_); \
   units_set_symbol(_name_, _symbol_); \
   units_set_literal(_name_, _symbol_); \
   units_set_quantity_alias(_name_)
 
-// * create aliases for a derived unit, then set its symbol and create a literal operator
+// * create aliases for a derived unit, then set its name and symbol and create a
+// * literal operator
 
 #define units_add_derived_unit(_name_, _symbol_, ...) units_assert_namespace \
   using _name_   = __VA_ARGS__; \
+  units_set_name(_name_); \
   units_set_symbol(_name_, _symbol_); \
   units_set_literal(_name_, _symbol_); \
   units_set_quantity_alias(_name_)
@@ -0,0 +1,56 @@
+#ifndef _include_units_details_prebuilt_h
+#define _include_units_details_prebuilt_h
+
+#include <ostream>
+
+#include <units/details/macros.h>
+#include <units/units.h>
+
+// - instantiations defined by the compiled library
+
+// when the compiled library (libphys-units) is linked, the programs using it are
+// compiled with units_prebuilt defined, and units.h includes this header.
+// the instantiations listed below are then declared extern, so they are compiled
+// once, in the library, instead of once in every translation unit. without the
+// library, units_prebuilt is not defined and the headers instantiate everything
+
+// * units whose quantities are instantiated, each listed once (aliases such as
+// * sievert or micron are the same types as gray and micrometer)
+
+#define units_prebuilt_units \
+  meter, second, kilogram, ampere, kelvin, mole, candela, steradian, decay, \
+  hertz, newton, pascal, joule, watt, coulomb, volt, farad, ohm, siemens, weber, \
+  tesla, henry, lumen, lux, becquerel, katal, gray, \
+  femtometer, picometer, nanometer, micrometer, millimeter, centimeter, decimeter, \
+  decameter, hectometer, kilometer, megameter, gigameter, terameter, petameter, \
+  exameter, angstrom, foot, thou, barleycorn, yard, chain, furlong, mile, league, \
+  femtosecond, picosecond, nanosecond, microsecond, millisecond, centisecond, \
+  decisecond, decasecond, hectosecond, kilosecond, megasecond, gigasecond, \
+  terasecond, petasecond, exasecond, minute, hour, day, year, \
+  gram, microgram, milligram, centigram, decigram, electronvolt
+
+// * instantiations for the quantity of a single unit
+
+// the quantity class, which includes its constructor, accessors and unary operators,
+// and the output operator printing the symbol of the unit, which composes the symbol
+// and is the largest function instantiated per unit. _keyword_ is either
+// "extern template" or "template".
+//
+// only instantiations whose declaration is cheap are listed: an extern declaration
+// is processed by every translation unit, even those not using the unit, and for a
+// function returning auto it instantiates the whole definition to deduce the return
+// type. this is why conversions, the operators whose overloads are selected by
+// constraints and the math functions are not listed: declaring them extern makes all
+// translation units slower to compile than instantiating them where they are used.
+// the same holds for the math functions even with declared return types, as their
+// bodies are too small to pay for the declarations of all the units
+
+#define units_instantiate_quantity(_keyword_, _value_, _unit_) \
+  _keyword_ struct _details::quantity<_unit_, _value_>; \
+  _keyword_ std::ostream& _details::operator<<(std::ostream&, const _details::quantity<_unit_, _value_>&);
+
+namespace units {
+  FOR_EACH(units_instantiate_quantity, extern template, double, units_prebuilt_units)
+}
+
+#endif
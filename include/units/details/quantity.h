@@ -5,7 +5,10 @@
 #include <string>
 #include <concepts>
 #include <compare>
+#include <cstddef>
+#include <type_traits>
 
+#include <units/details/fixed.h>
 #include <units/details/power.h>
 #include <units/details/ratio.h>
 #include <units/details/unit.h>
@@ -19,9 +22,57 @@ namespace units::_details {
     concept arithmetic = std::is_integral_v<T> || std::is_floating_point_v<T>;
   }
 
+  // - values of quantities
+
+  // quantities hold arithmetic values, or packs of them: types holding a fixed
+  // number of arithmetic values, operated on element by element, whose comparisons
+  // give masks instead of booleans. these are recognized by their interface, that of
+  // std::experimental::simd, which the bundled _simd::pack follows
+
+  namespace traits {
+    template <class T>
+    struct is_pack : std::false_type {};
+
+    template <class T>
+    requires (!std::is_arithmetic_v<T>) && requires (const T a, const typename T::value_type x) {
+      requires concepts::arithmetic<typename T::value_type>;
+      {T::size()} -> std::convertible_to<std::size_t>;
+      {a[0]} -> std::convertible_to<typename T::value_type>;
+      {T(x)};
+      {-a} -> std::convertible_to<T>;
+      {a + a} -> std::convertible_to<T>;
+      {a - a} -> std::convertible_to<T>;
+      {a * a} -> std::convertible_to<T>;
+      {a / a} -> std::convertible_to<T>;
+    }
+    struct is_pack<T> : std::true_type {};
+
+    template <class T>
+    constexpr inline bool is_pack_v = is_pack<T>::value;
+
+    // * type of the elements of a value: the value itself, if it is arithmetic
+    template <class T>
+    struct element_type {using type = T;};
+
+    template <class T>
+    requires is_pack_v<T>
+    struct element_type<T> {using type = typename T::value_type;};
+
+    template <class T>
+    using element_type_t = typename element_type<T>::type;
+  }
+
+  namespace concepts {
+    template <class T>
+    concept pack = traits::is_pack_v<T>;
+
+    template <class T>
+    concept value = arithmetic<T> || pack<T>;
+  }
+
   // - forward declare the quantity struct
 
-  template <concepts::unit U, concepts::arithmetic V = double>
+  template <concepts::unit U, concepts::value V = double>
   requires std::same_as<V, std::remove_cvref_t<V>>
   struct quantity;
 
@@ -57,7 +108,7 @@ namespace units::_details {
     struct is_integral_quantity : std::false_type {};
 
     template <concepts::quantity Q>
-    struct is_integral_quantity<Q> : std::is_integral<typename Q::value_type> {};
+    struct is_integral_quantity<Q> : std::is_integral<element_type_t<typename Q::value_type>> {};
 
     template <class Q>
     constexpr inline bool is_integral_quantity_v = is_integral_quantity<Q>::value;
@@ -67,7 +118,7 @@ namespace units::_details {
     struct is_floating_point_quantity : std::false_type {};
 
     template <concepts::quantity Q>
-    struct is_floating_point_quantity<Q> : std::is_floating_point<typename Q::value_type> {};
+    struct is_floating_point_quantity<Q> : std::is_floating_point<element_type_t<typename Q::value_type>> {};
 
     template <class Q>
     constexpr inline bool is_floating_point_quantity_v = is_floating_point_quantity<Q>::value;
@@ -81,6 +132,24 @@ namespace units::_details {
     concept floating_point_quantity = traits::is_floating_point_quantity_v<Q>;
   }
 
+  // * type is quantity holding a pack of values
+
+  namespace traits {
+    template <class Q>
+    struct is_pack_quantity : std::false_type {};
+
+    template <concepts::quantity Q>
+    struct is_pack_quantity<Q> : is_pack<typename Q::value_type> {};
+
+    template <class Q>
+    constexpr inline bool is_pack_quantity_v = is_pack_quantity<Q>::value;
+  }
+
+  namespace concepts {
+    template <class Q>
+    concept pack_quantity = traits::is_pack_quantity_v<Q>;
+  }
+
   // * type is quantity with dimensionless units (a conversion factor is accepted)
 
   namespace traits {
@@ -135,13 +204,15 @@ namespace units::_details {
 
   // - definition of the quantity class
 
-  template <concepts::unit Unit, concepts::arithmetic ValueType>
+  template <concepts::unit Unit, concepts::value ValueType>
   requires std::same_as<ValueType, std::remove_cvref_t<ValueType>>
   struct quantity {
   public:
     using type = quantity;
     using unit_type = std::remove_cv_t<Unit>;
     using value_type = std::remove_cv_t<ValueType>;
+    // the type of value_type, or of its elements if it is a pack
+    using element_type = traits::element_type_t<value_type>;
 
   private:
     value_type m_value;
@@ -151,7 +222,13 @@ namespace units::_details {
     // * constructors
 
     // construct from raw value
-    explicit constexpr quantity(const value_type& value = 0) : m_value(value) {}
+    explicit constexpr quantity(const value_type& value = 0) : m_value(value) {
+      // a quantity is laid out exactly as its value: this is what allows buffers of
+      // raw values to be viewed as buffers of quantities without copies. packs are
+      // never viewed so, and some (as fixed_size_simd) are not trivially copyable
+      static_assert(concepts::pack<value_type> || (std::is_standard_layout_v<type> && std::is_trivially_copyable_v<type>));
+      static_assert(sizeof(type) == sizeof(value_type) && alignof(type) == alignof(value_type));
+    }
 
     // construct from another quantity
     explicit constexpr quantity(const concepts::quantity_compatible<type> auto q)
@@ -183,7 +260,7 @@ namespace units::_details {
     requires concepts::floating_point_quantity<type>
     constexpr auto convert() const {
       using factor = ratio_divide<typename unit_type::factor, typename U::factor>;
-      return quantity<U, value_type>(m_value * factor::template value<value_type>); 
+      return quantity<U, value_type>(m_value * factor::template value<element_type>);
     }
 
     // when this' value type is integral, the value type of the returned quantity
@@ -192,7 +269,12 @@ namespace units::_details {
     requires concepts::integral_quantity<type>
     constexpr auto convert() const {
       using factor = ratio_divide<typename unit_type::factor, typename U::factor>;
-      if constexpr (factor::num%factor::den == 0)
+      if constexpr (concepts::pack<value_type>) {
+        // packs are multiplied by numbers of the type of their elements, and packs of
+        // integers are never promoted
+        static_assert(factor::num%factor::den == 0, "Packs of integers can only be converted by integral factors.");
+        return quantity<U, value_type>(m_value * element_type(factor::num/factor::den));
+      } else if constexpr (factor::num%factor::den == 0)
         // in case the remainder of the operation num/den is zero, the returned
         // quantity carries the same value type as this', because the resulting value
         // can be represented by value type
@@ -200,21 +282,47 @@ namespace units::_details {
       else
         // otherwise, a floating point number is required, so we promote the, originally
         // integral, value_type to long double
-        return quantity<U, long double>(m_value * factor::template value<value_type>);
+        return quantity<U, long double>(m_value * factor::template value<long double>);
+    }
+
+    // integral conversion staying integral: the value type is preserved, and the
+    // result is rounded and checked for overflow according to the given policies.
+    // with the checked overflow policy, an empty std::optional is returned on overflow
+    template <concepts::unit_compatible<unit_type> U, concepts::rounding_policy R, concepts::overflow_policy O = overflow::wrap>
+    requires concepts::integral_quantity<type> && concepts::arithmetic<value_type>
+    constexpr auto convert() const {
+      using factor = ratio_divide<typename unit_type::factor, typename U::factor>;
+      const auto value = _fixed::scale<factor, value_type, R, O>(m_value);
+
+      if constexpr (std::is_same_v<O, overflow::checked>)
+        return value? std::optional(quantity<U, value_type>(*value)) : std::nullopt;
+      else
+        return quantity<U, value_type>(value);
     }
 
-    // explicit type conversion operator. value type is always the requested one
+    // explicit type conversion operator. value type is always the requested one.
+    // integral values converted to an integral type are scaled exactly and
+    // truncated, as by convert<U, rounding::truncate>(), and wrap on overflow.
+    // floating-point values converted to an integral type are scaled in their own
+    // type and then truncated. otherwise, values are scaled by the factor in V
     template <concepts::unit_compatible<unit_type> U, concepts::arithmetic V>
+    requires concepts::arithmetic<value_type>
     constexpr operator quantity<U, V>() const {
       using factor = ratio_divide<typename unit_type::factor, typename U::factor>;
-      return quantity<U, V>(m_value * factor::template value<V>);
+      if constexpr (std::is_integral_v<value_type> && std::is_integral_v<V>)
+        // integral to integral: truncate, without going through floating point
+        return quantity<U, V>(_fixed::scale<factor, V, rounding::truncate, overflow::wrap>(m_value));
+      else if constexpr (std::is_integral_v<V>)
+        return quantity<U, V>(static_cast<V>(m_value * factor::template value<value_type>));
+      else
+        return quantity<U, V>(m_value * factor::template value<V>);
     }
 
     // dimensionless quantities can be converted to any type constructible from value_type
     template <std::constructible_from<value_type> T>
     requires concepts::dimensionless_quantity<type>
     constexpr operator T() const {
-      return T(m_value * unit_type::factor::template value<value_type>);
+      return T(m_value * unit_type::factor::template value<element_type>);
     };
 
     // * assignment operations for quantities of compatible units
@@ -340,17 +448,23 @@ namespace units::_details {
       // takes into account the division of the factors carried by each quantities unit.
       // first, we divide the factors carried by the units
       using factor = ratio_divide<typename unit_type::factor, typename decltype(q)::unit_type::factor>;
-      // then, proceed to compute the division
-      return (get_value() * factor::num) / (q.get_value() * factor::den);
+      // then, proceed to compute the division. packs are multiplied by numbers of the
+      // type of their elements
+      if constexpr (concepts::pack<value_type> || concepts::pack_quantity<decltype(q)>) {
+        using E = std::common_type_t<element_type, typename decltype(q)::element_type>;
+        return (get_value() * E(factor::num)) / (q.get_value() * E(factor::den));
+      } else {
+        return (get_value() * factor::num) / (q.get_value() * factor::den);
+      }
     }
 
-    // multiplication by arithmetic type
-    constexpr auto operator*(const concepts::arithmetic auto x) const {
+    // multiplication by arithmetic type, or pack
+    constexpr auto operator*(const concepts::value auto x) const {
       return quantity<unit_type, decltype(get_value()*x)>(get_value()*x);
     }
 
-    // division by arithmetic type
-    constexpr auto operator/(const concepts::arithmetic auto x) const {
+    // division by arithmetic type, or pack
+    constexpr auto operator/(const concepts::value auto x) const {
       return quantity<unit_type, decltype(get_value()/x)>(get_value()/x);
     }
 
@@ -376,17 +490,37 @@ namespace units::_details {
       return get_value() <=> q.template convert<unit_type>().get_value();
     };
 
+    // relational operators are spelled out, instead of being rewritten in terms of
+    // operator<=>, so that they compile down to a single comparison of the values.
+    // the comparison of packs gives a mask
+
+    constexpr auto operator<(const concepts::quantity_compatible<type> auto q) const {
+      return get_value() < q.template convert<unit_type>().get_value();
+    };
+
+    constexpr auto operator>(const concepts::quantity_compatible<type> auto q) const {
+      return get_value() > q.template convert<unit_type>().get_value();
+    };
+
+    constexpr auto operator<=(const concepts::quantity_compatible<type> auto q) const {
+      return get_value() <= q.template convert<unit_type>().get_value();
+    };
+
+    constexpr auto operator>=(const concepts::quantity_compatible<type> auto q) const {
+      return get_value() >= q.template convert<unit_type>().get_value();
+    };
+
   };
 
-  // - multiplication by arithmetic type from lhs
+  // - multiplication by arithmetic type, or pack, from lhs
 
-  constexpr auto operator*(const concepts::arithmetic auto x, const concepts::quantity auto q) {
+  constexpr auto operator*(const concepts::value auto x, const concepts::quantity auto q) {
     return q * x;
   };
 
-  // - division of arithmetic type by quantity
+  // - division of arithmetic type, or pack, by quantity
 
-  constexpr auto operator/(const concepts::arithmetic auto x, const concepts::quantity auto q) {
+  constexpr auto operator/(const concepts::value auto x, const concepts::quantity auto q) {
     using unit_type = make_unit<inverse<typename std::remove_cvref_t<decltype(q)>::unit_type>>;
     auto value = x / q.get_value();
     return quantity<unit_type, decltype(value)>(value);
@@ -19,20 +19,10 @@ namespace units::_details {
 
   template <char... cs>
   constexpr __int128_t operator""_imax() {
-    constexpr std::array<char, sizeof...(cs)> chars = {cs...};
-
-    constexpr auto get_num = [](char c){
-      constexpr std::string_view str = "0123456789";
-      return (c == '\'') ? 0 : str.find_first_of(c);
-    };
-
-    static_assert(std::all_of(chars.begin(), chars.end(), [&](char c){return get_num(c) < 10;}));
+    static_assert(((cs == '\'' || (cs >= '0' && cs <= '9')) && ...), "Invalid digit in integer literal.");
 
     __int128_t ret = 0;
-    for (const auto c : chars) {
-      if (c != '\'')
-        ret = 10*ret + get_num(c);
-    }
+    ((ret = (cs == '\'')? ret : 10*ret + (cs - '0')), ...);
     return ret;
   }
 
@@ -0,0 +1,242 @@
+#ifndef _include_units_details_registry_h
+#define _include_units_details_registry_h
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include <units/details/descriptor.h>
+#include <units/details/unit.h>
+
+namespace units::_details {
+
+  // - lists of units
+
+  template <class... Us>
+  struct unit_list {};
+
+  namespace _registry {
+    template <class... Ls>
+    struct cat;
+
+    template <class... Us>
+    struct cat<unit_list<Us...>> {using type = unit_list<Us...>;};
+
+    template <class... As, class... Bs, class... Ls>
+    struct cat<unit_list<As...>, unit_list<Bs...>, Ls...> : cat<unit_list<As..., Bs...>, Ls...> {};
+  }
+
+  // * concatenation of lists of units
+  template <class... Ls>
+  using unit_list_cat = typename _registry::cat<unit_list<>, Ls...>::type;
+
+  // - fingerprints
+
+  // the fingerprint of a unit is a 64-bit hash of its dimension and of its exact
+  // factor, so it identifies the unit in any process and whatever the way it was
+  // written: the fingerprint of parse_unit("km") is that of kilometer. fingerprints
+  // may be stored, so the hash must never change. invalid descriptors, and only
+  // them, have a null fingerprint
+
+  namespace _registry {
+    // * the finalizer of splitmix64, a bijection of 64-bit words
+    constexpr std::uint64_t mix(std::uint64_t x) {
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+      return x ^ (x >> 31);
+    }
+
+    constexpr std::uint64_t combine(const std::uint64_t h, const std::uint64_t x)
+    {return mix(h ^ (x + 0x9e3779b97f4a7c15 + (h << 6) + (h >> 2)));}
+
+    // * the 128-bit factors are hashed as two words each
+    constexpr std::uint64_t combine(const std::uint64_t h, const intm_t x)
+    {return combine(combine(h, std::uint64_t(x)), std::uint64_t(x >> 64));}
+  }
+
+  constexpr std::uint64_t fingerprint(const unit_descriptor& unit) {
+    if (!unit.valid())
+      return 0;
+
+    const auto h = _registry::combine(_registry::combine(_registry::mix(unit.dim.bits()), unit.factor.num), unit.factor.den);
+    return (h == 0)? 1 : h;
+  }
+
+  template <concepts::describable_unit U>
+  constexpr inline std::uint64_t fingerprint_of = fingerprint(descriptor_of<U>);
+
+  // - perfect hashing
+
+  // the slots of a table of N distinct keys are found at compile time, by searching
+  // for a seed under which the hashes of all keys are distinct modulo the number of
+  // slots, so that a lookup costs one hash and a single comparison with the key at
+  // the slot
+
+  namespace _registry {
+
+    constexpr std::uint64_t hash(const std::string_view s, const std::uint64_t seed) {
+      // fnv-1a, with the seed mixed into the offset basis
+      std::uint64_t h = 0xcbf29ce484222325 ^ (seed*0x9e3779b97f4a7c15);
+      for (const auto c : s) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3;
+      }
+      return h ^ (h >> 32);
+    }
+
+    constexpr std::uint64_t hash(const std::uint64_t key, const std::uint64_t seed)
+    {return mix(key ^ (seed*0x9e3779b97f4a7c15));}
+
+    // * the keys of a table of entries
+    template <class Entry, std::size_t N, class Key>
+    constexpr auto keys(const std::array<Entry, N>& entries, Key Entry::* member) {
+      std::array<Key, N> ret = {};
+      for (std::size_t i = 0; i < N; ++i)
+        ret[i] = entries[i].*member;
+      return ret;
+    }
+
+    // * keys are all different, otherwise no seed could be found
+    template <class Key, std::size_t N>
+    constexpr bool distinct(const std::array<Key, N>& keys) {
+      for (std::size_t i = 0; i < N; ++i)
+        for (std::size_t j = i + 1; j < N; ++j)
+          if (keys[i] == keys[j])
+            return false;
+      return true;
+    }
+
+    template <std::size_t N>
+    class perfect_hash {
+    public:
+      // eight slots per key keep the expected number of tried seeds low
+      static constexpr std::size_t slots = std::bit_ceil(8*N);
+
+    private:
+      static constexpr std::uint16_t empty = 0xffff;
+      static_assert(N < empty, "Too many keys for a perfect hash table.");
+
+      std::array<std::uint16_t, slots> m_slots = {};
+      std::uint64_t m_seed = 0;
+
+    public:
+      // the search for a seed would never end on duplicate keys, which are rejected
+      // first: at compile time, this is reported as an error at the throw expression
+      template <class Key>
+      constexpr perfect_hash(const std::array<Key, N>& keys) {
+        if (!distinct(keys))
+          throw std::invalid_argument("keys of a perfect hash table must be distinct");
+
+        for (;; ++m_seed) {
+          m_slots.fill(empty);
+
+          bool collision = false;
+          for (std::size_t i = 0; i < N && !collision; ++i) {
+            auto& slot = m_slots[hash(keys[i], m_seed) % slots];
+            collision = (slot != empty);
+            slot = static_cast<std::uint16_t>(i);
+          }
+
+          if (!collision)
+            break;
+        }
+      }
+
+      // * index of the only key that may be equal to the given one, or N if none
+      template <class Key>
+      constexpr std::size_t candidate(const Key& key) const {
+        const auto index = m_slots[hash(key, m_seed) % slots];
+        return (index == empty)? N : index;
+      }
+    };
+
+  }
+
+  // - registry of units
+
+  // the name, symbol, descriptor and fingerprint of each unit in a list are stored
+  // in a static array, in the order of the list, along with perfect hash tables
+  // indexing it by each of them. everything is computed at compile time, so the
+  // registry can be used in constant expressions, and at runtime it is read-only
+  // data that requires no initialization. names, symbols and fingerprints must be
+  // unique within a registry
+
+  struct registered_unit {
+    std::string_view name;
+    std::string_view symbol;
+    unit_descriptor unit;
+    std::uint64_t fingerprint;
+  };
+
+  template <class L>
+  class unit_registry;
+
+  template <class... Us>
+  class unit_registry<unit_list<Us...>> {
+    static_assert((concepts::describable_unit<Us> && ...), "Registered units must be describable.");
+    static_assert((_unit::has_name<Us> && ...), "Registered units must be named (see units_set_name).");
+
+  public:
+    static constexpr std::size_t size = sizeof...(Us);
+
+    // * the registered units, in the order of the list
+    static constexpr std::array<registered_unit, size> entries = {
+      registered_unit{_unit::name<Us>, _unit::symbol<Us>, descriptor_of<Us>, fingerprint_of<Us>}...
+    };
+
+  private:
+    static_assert(_registry::distinct(_registry::keys(entries, &registered_unit::name)), "Unit names are not unique.");
+    static_assert(_registry::distinct(_registry::keys(entries, &registered_unit::symbol)), "Unit symbols are not unique.");
+    static_assert(_registry::distinct(_registry::keys(entries, &registered_unit::fingerprint)), "Unit fingerprints are not unique.");
+
+    static constexpr _registry::perfect_hash<size> by_name = _registry::keys(entries, &registered_unit::name);
+    static constexpr _registry::perfect_hash<size> by_symbol = _registry::keys(entries, &registered_unit::symbol);
+    static constexpr _registry::perfect_hash<size> by_fingerprint = _registry::keys(entries, &registered_unit::fingerprint);
+
+    template <class Key>
+    static constexpr const registered_unit* lookup(const _registry::perfect_hash<size>& index, const Key key, Key registered_unit::* member) {
+      const auto i = index.candidate(key);
+      return (i < size && entries[i].*member == key)? &entries[i] : nullptr;
+    }
+
+  public:
+    // * whether the unit is registered, and its position in entries
+    template <class U>
+    static constexpr bool contains = (std::is_same_v<U, Us> || ...);
+
+    template <class U>
+    requires contains<U>
+    static constexpr std::size_t index_of = []{
+      std::size_t i = 0;
+      ((std::is_same_v<U, Us>? false : (++i, true)) && ...);
+      return i;
+    }();
+
+    static constexpr std::span<const registered_unit, size> all()
+    {return entries;}
+
+    // * lookups, returning nullptr for units that are not registered
+    static constexpr const registered_unit* find_name(const std::string_view name)
+    {return lookup(by_name, name, &registered_unit::name);}
+
+    static constexpr const registered_unit* find_symbol(const std::string_view symbol)
+    {return lookup(by_symbol, symbol, &registered_unit::symbol);}
+
+    static constexpr const registered_unit* find(const std::uint64_t fingerprint)
+    {return lookup(by_fingerprint, fingerprint, &registered_unit::fingerprint);}
+
+    // the registered unit with the same dimension and factor, however it is written
+    static constexpr const registered_unit* find(const unit_descriptor& unit) {
+      const auto entry = find(fingerprint(unit));
+      return (entry && entry->unit == unit)? entry : nullptr;
+    }
+  };
+
+}
+
+#endif
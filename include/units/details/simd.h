@@ -0,0 +1,254 @@
+#ifndef _include_units_details_simd_h
+#define _include_units_details_simd_h
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+namespace units::_details::_simd {
+
+  // - width, in bytes, of the widest vector register of the target
+
+  // AVX-512 and AVX/AVX2 are detected from the compiler flags, everything else
+  // (SSE2, NEON, or no vector unit at all) is assumed to be 16 bytes wide
+#if defined(__AVX512F__)
+  constexpr inline std::size_t register_bytes = 64;
+#elif defined(__AVX__) || defined(__AVX2__)
+  constexpr inline std::size_t register_bytes = 32;
+#else
+  constexpr inline std::size_t register_bytes = 16;
+#endif
+
+  // - number of elements of type T that fit in a single vector register
+
+  template <class T>
+  constexpr inline std::size_t lanes = (sizeof(T) < register_bytes)? register_bytes/sizeof(T) : 1;
+
+  // - fixed-width packs
+
+  // N values of an arithmetic type, operated on element by element: every operation
+  // is a loop over the elements, which the compiler turns into vector instructions
+  // of the target. as value type of a quantity, a pack holds N quantities of the
+  // same unit. the interface follows that of std::experimental::simd, so that code
+  // is written once for both
+
+  // * result of the element-wise comparison of packs
+  template <std::size_t N>
+  class mask {
+  private:
+    bool m_values[N];
+
+  public:
+    using value_type = bool;
+
+    constexpr mask() = default;
+
+    constexpr mask(const bool value) {
+      for (std::size_t j = 0; j < N; ++j)
+        m_values[j] = value;
+    }
+
+    static constexpr std::size_t size() {return N;}
+
+    constexpr bool& operator[](const std::size_t j) {return m_values[j];}
+    constexpr bool operator[](const std::size_t j) const {return m_values[j];}
+
+    friend constexpr mask operator!(const mask& a) {
+      mask ret;
+      for (std::size_t j = 0; j < N; ++j)
+        ret.m_values[j] = !a.m_values[j];
+      return ret;
+    }
+
+    friend constexpr mask operator&&(const mask& a, const mask& b) {
+      mask ret;
+      for (std::size_t j = 0; j < N; ++j)
+        ret.m_values[j] = a.m_values[j] && b.m_values[j];
+      return ret;
+    }
+
+    friend constexpr mask operator||(const mask& a, const mask& b) {
+      mask ret;
+      for (std::size_t j = 0; j < N; ++j)
+        ret.m_values[j] = a.m_values[j] || b.m_values[j];
+      return ret;
+    }
+
+    // * reductions, which are found by argument-dependent lookup as those of
+    // * std::experimental::simd_mask
+
+    friend constexpr bool all_of(const mask& a) {
+      bool ret = true;
+      for (std::size_t j = 0; j < N; ++j)
+        ret &= a.m_values[j];
+      return ret;
+    }
+
+    friend constexpr bool any_of(const mask& a) {
+      bool ret = false;
+      for (std::size_t j = 0; j < N; ++j)
+        ret |= a.m_values[j];
+      return ret;
+    }
+
+    friend constexpr bool none_of(const mask& a)
+    {return !any_of(a);}
+  };
+
+  // * pack of N values of type T
+
+  // the size and alignment of a pack must not depend on the compiler flags, which
+  // would give the same type different layouts in different translation units. by
+  // default, a pack fills 16 bytes, the width of the vector registers of every
+  // target, and packs are aligned as the smallest power of two holding them, up to
+  // 16 bytes. wider packs, such as pack<double, 4> for AVX, spell their size
+  constexpr inline std::size_t max_alignment = 16;
+
+  template <class T>
+  constexpr inline std::size_t default_size = (sizeof(T) < max_alignment)? max_alignment/sizeof(T) : 1;
+
+  // the default constructor leaves the values uninitialized, as for arithmetic types,
+  // and numbers are broadcast to all the elements
+  template <class T, std::size_t N = default_size<T>>
+  requires std::is_arithmetic_v<T> && (N > 0)
+  class pack {
+  public:
+    using value_type = T;
+    using mask_type = mask<N>;
+
+  private:
+    static constexpr std::size_t bytes = N*sizeof(T);
+    static constexpr std::size_t width = (bytes < max_alignment)? std::bit_ceil(bytes) : max_alignment;
+
+    alignas((width > alignof(T))? width : alignof(T)) T m_values[N];
+
+    template <class F>
+    static constexpr pack map(const F& f) {
+      pack ret;
+      for (std::size_t j = 0; j < N; ++j)
+        ret.m_values[j] = f(j);
+      return ret;
+    }
+
+    template <class F>
+    static constexpr mask_type test(const F& f) {
+      mask_type ret;
+      for (std::size_t j = 0; j < N; ++j)
+        ret[j] = f(j);
+      return ret;
+    }
+
+  public:
+
+    // * constructors
+
+    constexpr pack() = default;
+
+    constexpr pack(const value_type value) {
+      for (std::size_t j = 0; j < N; ++j)
+        m_values[j] = value;
+    }
+
+    // the element j is f(j)
+    template <std::invocable<std::size_t> F>
+    requires std::convertible_to<std::invoke_result_t<F, std::size_t>, value_type>
+    explicit constexpr pack(F&& f) {
+      for (std::size_t j = 0; j < N; ++j)
+        m_values[j] = static_cast<value_type>(f(j));
+    }
+
+    // * access to the elements
+
+    static constexpr std::size_t size() {return N;}
+
+    constexpr value_type& operator[](const std::size_t j) {return m_values[j];}
+    constexpr value_type operator[](const std::size_t j) const {return m_values[j];}
+
+    // * loads and stores of N contiguous values
+
+    constexpr void copy_from(const value_type* p) {
+      for (std::size_t j = 0; j < N; ++j)
+        m_values[j] = p[j];
+    }
+
+    constexpr void copy_to(value_type* p) const {
+      for (std::size_t j = 0; j < N; ++j)
+        p[j] = m_values[j];
+    }
+
+    // * arithmetic operations
+
+    friend constexpr pack operator+(const pack& a)
+    {return a;}
+
+    friend constexpr pack operator-(const pack& a)
+    {return map([&](const std::size_t j) {return value_type(-a.m_values[j]);});}
+
+    friend constexpr pack operator+(const pack& a, const pack& b)
+    {return map([&](const std::size_t j) {return value_type(a.m_values[j] + b.m_values[j]);});}
+
+    friend constexpr pack operator-(const pack& a, const pack& b)
+    {return map([&](const std::size_t j) {return value_type(a.m_values[j] - b.m_values[j]);});}
+
+    friend constexpr pack operator*(const pack& a, const pack& b)
+    {return map([&](const std::size_t j) {return value_type(a.m_values[j] * b.m_values[j]);});}
+
+    friend constexpr pack operator/(const pack& a, const pack& b)
+    {return map([&](const std::size_t j) {return value_type(a.m_values[j] / b.m_values[j]);});}
+
+    friend constexpr pack operator%(const pack& a, const pack& b)
+    requires std::is_integral_v<value_type>
+    {return map([&](const std::size_t j) {return value_type(a.m_values[j] % b.m_values[j]);});}
+
+    constexpr pack& operator+=(const pack& b) {return *this = *this + b;}
+    constexpr pack& operator-=(const pack& b) {return *this = *this - b;}
+    constexpr pack& operator*=(const pack& b) {return *this = *this * b;}
+    constexpr pack& operator/=(const pack& b) {return *this = *this / b;}
+
+    constexpr pack& operator++() {return *this += 1;}
+    constexpr pack& operator--() {return *this -= 1;}
+
+    constexpr pack operator++(int) {const pack ret = *this; *this += 1; return ret;}
+    constexpr pack operator--(int) {const pack ret = *this; *this -= 1; return ret;}
+
+    // * comparisons, element by element
+
+    friend constexpr mask_type operator==(const pack& a, const pack& b)
+    {return test([&](const std::size_t j) {return a.m_values[j] == b.m_values[j];});}
+
+    friend constexpr mask_type operator!=(const pack& a, const pack& b)
+    {return test([&](const std::size_t j) {return a.m_values[j] != b.m_values[j];});}
+
+    friend constexpr mask_type operator<(const pack& a, const pack& b)
+    {return test([&](const std::size_t j) {return a.m_values[j] < b.m_values[j];});}
+
+    friend constexpr mask_type operator>(const pack& a, const pack& b)
+    {return test([&](const std::size_t j) {return a.m_values[j] > b.m_values[j];});}
+
+    friend constexpr mask_type operator<=(const pack& a, const pack& b)
+    {return test([&](const std::size_t j) {return a.m_values[j] <= b.m_values[j];});}
+
+    friend constexpr mask_type operator>=(const pack& a, const pack& b)
+    {return test([&](const std::size_t j) {return a.m_values[j] >= b.m_values[j];});}
+
+    // * elements of a where m is set, and of b elsewhere
+    friend constexpr pack select(const mask_type& m, const pack& a, const pack& b)
+    {return map([&](const std::size_t j) {return m[j]? a.m_values[j] : b.m_values[j];});}
+
+    // * functions of each element, found by argument-dependent lookup as the
+    // * functions of <cmath> are for numbers. those computed by the kernels of the
+    // * batch math functions are defined along with them, in math.h
+
+    template <class F>
+    friend constexpr pack apply(const F& f, const pack& a)
+    {return map([&](const std::size_t j) {return value_type(f(a.m_values[j]));});}
+
+    template <class F>
+    friend constexpr pack apply(const F& f, const pack& a, const pack& b)
+    {return map([&](const std::size_t j) {return value_type(f(a.m_values[j], b.m_values[j]));});}
+  };
+
+}
+
+#endif
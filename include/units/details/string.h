@@ -40,11 +40,17 @@ namespace units::_details {
     constexpr static_string(const char c) {
       m_data.fill(0);
       m_data[0] = c;
+      m_size = (c != 0 && max_length > 0)? 1 : 0;
     }
 
-    constexpr static_string(const std::string_view& s)
-    : static_string(s.data())
-    {}
+    constexpr static_string(const std::string_view& s) {
+      m_data.fill(0);
+
+      while(m_size < s.size() && m_size < max_length) {
+        m_data[m_size] = s[m_size];
+        ++m_size;
+      }
+    }
 
     constexpr auto data() const {return m_data.data();}
     constexpr auto size() const {return m_size;}
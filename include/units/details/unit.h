@@ -2,6 +2,7 @@
 #define _include_units_details_unit_h
 
 #include <array>
+#include <iosfwd>
 #include <string_view>
 #include <tuple>
 #include <numeric>
@@ -60,7 +61,7 @@ namespace units::_details {
     struct is_unit<unit<R, Ps...>> : std::true_type {};
 
     template <class T>
-    static constexpr inline bool is_unit_v = is_unit<T>::value;
+    constexpr inline bool is_unit_v = is_unit<T>::value;
 
     // * assert unit is dimensionless
     template <class T>
@@ -127,26 +128,121 @@ namespace units::_details {
     };
   }
 
-  // - units nomenclature helper template variables
+  // - units nomenclature helpers
 
   namespace _unit {
-    constexpr inline string default_symbol = "?";
+    // * symbols registered for named units (see units_set_symbol)
+
+    constexpr inline std::string_view default_symbol = "?";
 
     template <concepts::unit U>
-    constexpr inline string symbol = default_symbol;
+    constexpr inline std::string_view symbol = default_symbol;
 
     template <concepts::unit U>
     constexpr inline bool has_symbol = symbol<U> != default_symbol;
 
+    // * names registered for named units (see units_set_name)
+
+    template <concepts::unit U>
+    constexpr inline std::string_view name = {};
+
+    template <concepts::unit U>
+    constexpr inline bool has_name = !name<U>.empty();
+
+    // * composition of the symbol of an arbitrary unit
+
+    // the helpers below are only ever evaluated at compile time: the fixed-capacity
+    // strings they return are never stored, only the final text is (see symbol_text)
+
     template <concepts::reduced_ratio R>
-    constexpr inline string ratiostr = (R::num%R::den != 0)?
-      ("(" + stringify(R::num) + "/" + stringify(R::den) + ")") :
-      stringify(R::num);
+    constexpr string ratiostr() {
+      if constexpr (R::num%R::den != 0)
+        return "(" + stringify(R::num) + "/" + stringify(R::den) + ")";
+      else
+        return stringify(R::num);
+    }
 
     template <concepts::reduced_power P>
-    constexpr inline string smbpowstr = std::is_same_v<one, typename P::exponent>?
-      symbol<base_unit<P::base::index>> :
-      symbol<base_unit<P::base::index>> + "^" + ratiostr<typename P::exponent>;
+    constexpr string smbpowstr() {
+      if constexpr (std::is_same_v<one, typename P::exponent>)
+        return string(symbol<base_unit<P::base::index>>);
+      else
+        return string(symbol<base_unit<P::base::index>>) + "^" + ratiostr<typename P::exponent>();
+    }
+
+    template <class U>
+    struct compose;
+
+    template <class R, class... Ps>
+    struct compose<unit<R, Ps...>> {
+      using type = unit<R, Ps...>;
+
+      static constexpr string text() {
+        if constexpr (has_symbol<type> || traits::is_base_unit_v<type>) {
+          return string(symbol<type>);
+        } else if constexpr (sizeof...(Ps) > 0 && has_symbol<unit<one, Ps...>>) {
+          return compose<unit<R>>::text() + " " + string(symbol<unit<one, Ps...>>);
+        } else {
+          string ret;
+
+          if constexpr (R::num != R::den) {
+            if constexpr (R::den == 1)
+              ret += "· " + stringify(R::num);
+            else
+              ret += "· (" + stringify(R::num) + "/" + stringify(R::den) + ")";
+          }
+
+          if constexpr (sizeof...(Ps) > 0) {
+            ret += ret.size() > 0? " " : "";
+
+            constexpr bool all_int = (Ps::exponent::den * ... * 1) == 1;
+            constexpr auto exp_gcd = gcd(Ps::exponent::num..., intm_t(0));
+            using u = unit<one, power_t<Ps, 1, exp_gcd>...>;
+
+            if constexpr (all_int && exp_gcd != 1 && has_symbol<u>) {
+              ret += string(symbol<u>) + "^" + stringify(exp_gcd);
+            } else {
+              ret += ((smbpowstr<Ps>() + " ") + ...);
+            }
+          }
+
+          return ret;
+        }
+      }
+    };
+
+    // * the symbol of a unit, stored in a string of exactly its length
+
+    // being a variable template, the symbol is only composed for units whose symbol is
+    // actually requested, and only the resulting text ends up in the binary
+    template <concepts::unit U>
+    constexpr inline auto symbol_text = []{
+      constexpr string text = compose<U>::text();
+      return static_string<text.size()>(std::string_view(text.data(), text.size()));
+    }();
+
+    // * empty handle giving access to the symbol of a unit
+
+    // the text is only looked up when the handle is used, so declaring the handle as a
+    // member of the unit class does not compose the symbol of every instantiated unit
+    template <class U>
+    struct symbol_handle {
+      constexpr const char* data() const {return symbol_text<U>.data();}
+      constexpr std::size_t size() const {return symbol_text<U>.size();}
+      constexpr const char* begin() const {return data();}
+      constexpr const char* end() const {return data() + size();}
+
+      constexpr operator std::string_view() const {return {data(), size()};}
+
+      friend constexpr bool operator==(const symbol_handle s, const std::string_view other) {
+        return std::string_view(s) == other;
+      }
+
+      template <class CharT, class Traits>
+      friend auto& operator<<(std::basic_ostream<CharT, Traits>& os, const symbol_handle s) {
+        return os << std::string_view(s);
+      }
+    };
   }
 
   // - definition of the unit class
@@ -159,38 +255,7 @@ namespace units::_details {
     using factor = R;
     using powers = std::tuple<Ps...>;
 
-    static constexpr string symbol = []()->string{
-      if constexpr (_unit::has_symbol<type> || traits::is_base_unit_v<type>) {
-        return _unit::symbol<type>;
-      } else if constexpr (sizeof...(Ps) > 0 && _unit::has_symbol<unit<one, Ps...>>) {
-        return unit<R>::symbol + " " + _unit::symbol<unit<one, Ps...>>;
-      } else {
-        string ret;
-        
-        if constexpr (R::num != R::den) {
-          if constexpr (R::den == 1)
-            ret += "· " + stringify(R::num);
-          else
-            ret += "· (" + stringify(R::num) + "/" + stringify(R::den) + ")"; 
-        }
-
-        if constexpr (sizeof...(Ps) > 0) {
-          ret += ret.size() > 0? " " : "";
-
-          constexpr bool all_int = (Ps::exponent::den * ... * 1) == 1;
-          constexpr auto exp_gcd = gcd(Ps::exponent::num...);
-          using u = unit<one, power_t<Ps, 1, exp_gcd>...>;
-
-          if constexpr (all_int && exp_gcd != 1 && _unit::has_symbol<u>) {
-            ret += _unit::symbol<u> + "^" + stringify(exp_gcd);
-          } else {
-            ret += ((_unit::smbpowstr<Ps> + " ") + ...);
-          }
-        }
-        
-        return ret;
-      }
-    }();
+    static constexpr _unit::symbol_handle<type> symbol = {};
   };
 
   // - implementation of the product between units
@@ -0,0 +1,334 @@
+#ifndef _include_units_dynamic_h
+#define _include_units_dynamic_h
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+#include <units/details/fixed.h>
+#include <units/framework.h>
+
+namespace units::_details {
+
+  // - forward declarations
+
+  template <concepts::arithmetic V = double>
+  requires std::same_as<V, std::remove_cvref_t<V>>
+  class dynamic_quantity;
+
+  // - traits and concepts
+
+  namespace traits {
+    template <class T>
+    struct is_dynamic_quantity : std::false_type {};
+
+    template <class V>
+    struct is_dynamic_quantity<dynamic_quantity<V>> : std::true_type {};
+
+    template <class T>
+    constexpr inline bool is_dynamic_quantity_v = is_dynamic_quantity<T>::value;
+  }
+
+  namespace concepts {
+    template <class T>
+    concept dynamic_quantity = traits::is_dynamic_quantity_v<T>;
+  }
+
+  // - helpers
+
+  namespace _dynamic {
+    // * value carried by the results of invalid operations
+    template <class V>
+    constexpr V invalid_value() {
+      if constexpr (std::numeric_limits<V>::has_quiet_NaN)
+        return std::numeric_limits<V>::quiet_NaN();
+      else
+        return V(0);
+    }
+
+    // * floating-point value x, once truncated, fits in the integral type W. NaN does
+    // * not. min - 1 may round to min, which itself fits, hence the two comparisons
+    template <std::integral W, std::floating_point F>
+    constexpr bool fits(const F x) {
+      constexpr F lo = F(std::numeric_limits<W>::min());
+      constexpr F hi = F(std::numeric_limits<W>::max()/2 + 1)*F(2);
+      return (x >= lo || x > lo - F(1)) && x < hi;
+    }
+
+    // * value scaled by an exact ratio and converted to W, or nothing if the result
+    // * does not fit in W. integral values stay integral, truncating the result if
+    // * the ratio is not an integer, and are checked for overflow of the product too
+    template <concepts::arithmetic W, concepts::arithmetic V>
+    constexpr std::optional<W> checked_scale(const V value, const runtime_ratio& r) {
+      if (!r.valid())
+        return std::nullopt;
+
+      if constexpr (std::is_floating_point_v<W>) {
+        return (r == runtime_ratio{})? W(value) : W(value) * r.template value<W>();
+      } else if constexpr (std::is_floating_point_v<V>) {
+        using F = std::conditional_t<(sizeof(V) > sizeof(double)), V, double>;
+        const auto x = (r == runtime_ratio{})? F(value) : F(value) * r.template value<F>();
+        return fits<W>(x)? std::optional<W>(static_cast<W>(x)) : std::nullopt;
+      } else {
+        intm_t p = value;
+        if (r != runtime_ratio{} && __builtin_mul_overflow(intm_t(value), r.num, &p))
+          return std::nullopt;
+
+        const auto x = p / r.den;
+        return _fixed::fits<W>(x)? std::optional<W>(static_cast<W>(x)) : std::nullopt;
+      }
+    }
+
+    // * scale value by an exact ratio: integral values stay integral, truncating
+    // * the result if the ratio is not an integer. results that do not fit are invalid
+    template <class V>
+    constexpr V scale(const V value, const runtime_ratio& r) {
+      if (r == runtime_ratio{})
+        return value;
+      else if constexpr (std::is_floating_point_v<V>)
+        return r.valid()? value * r.template value<V>() : invalid_value<V>();
+      else
+        return checked_scale<V>(value, r).value_or(invalid_value<V>());
+    }
+
+    // * scale n values from src into dst, of possibly different types, as
+    // * checked_scale does. floating-point values are multiplied by the value of the
+    // * ratio, computed once. false if the ratio is invalid, or if any of the values
+    // * does not fit in T, in which case it is written as zero
+    template <class S, class T>
+    constexpr bool scale_n(const S* const src, const std::size_t n, T* const dst, const runtime_ratio& r) {
+      if (!r.valid())
+        return false;
+
+      if constexpr (std::is_floating_point_v<T>) {
+        if (r == runtime_ratio{}) {
+          for (std::size_t i = 0; i < n; ++i)
+            dst[i] = static_cast<T>(src[i]);
+        } else {
+          const auto factor = r.template value<T>();
+          for (std::size_t i = 0; i < n; ++i)
+            dst[i] = static_cast<T>(src[i]) * factor;
+        }
+        return true;
+      } else if constexpr (std::is_floating_point_v<S>) {
+        using F = std::conditional_t<(sizeof(S) > sizeof(double)), S, double>;
+        const auto factor = r.template value<F>();
+        bool ok = true;
+        for (std::size_t i = 0; i < n; ++i) {
+          const auto x = static_cast<F>(src[i]) * factor;
+          const bool fit = fits<T>(x);
+          dst[i] = fit? static_cast<T>(x) : T(0);
+          ok = ok && fit;
+        }
+        return ok;
+      } else {
+        bool ok = true;
+        for (std::size_t i = 0; i < n; ++i) {
+          const auto value = checked_scale<T>(src[i], r);
+          dst[i] = value.value_or(T(0));
+          ok = ok && value;
+        }
+        return ok;
+      }
+    }
+
+    // * exact integral values of a and b in a common unit, of which both units are
+    // * integral multiples: with b.factor/a.factor = n/d, a is d and b is n of it. this
+    // * is the finer of the two units when one of them is a multiple of the other. the
+    // * unit is invalid if either value overflows in it
+    template <class V>
+    constexpr auto common(const V a, const unit_descriptor& ua, const V b, const unit_descriptor& ub) {
+      const auto r = ub.factor/ua.factor;
+      intm_t x, y;
+
+      if (__builtin_mul_overflow(intm_t(a), r.den, &x) || __builtin_mul_overflow(intm_t(b), r.num, &y))
+        return std::tuple(intm_t(0), intm_t(0), unit_descriptor::invalid());
+
+      return std::tuple(x, y, unit_descriptor::make(ua.factor/runtime_ratio{r.den, 1}, ua.dim));
+    }
+
+    // * sum or difference of the results of common, or an invalid quantity if the
+    // * unit is invalid or if the result does not fit in the value type
+    template <class Q, class Op>
+    constexpr Q combine(const std::tuple<intm_t, intm_t, unit_descriptor>& c, Op op) {
+      const auto& [a, b, unit] = c;
+      intm_t x;
+
+      if (!unit.valid() || op(a, b, &x) || !_fixed::fits<typename Q::value_type>(x))
+        return Q(invalid_value<typename Q::value_type>(), unit_descriptor::invalid());
+
+      return Q(static_cast<typename Q::value_type>(x), unit);
+    }
+  }
+
+  // - definition of the dynamic quantity class
+
+  // a quantity whose unit is only known at runtime. its unit is described by a
+  // unit_descriptor, so checking two dynamic quantities for compatibility is a single
+  // integer comparison. operations on incompatible quantities do not fail, but
+  // produce an invalid quantity: invalid quantities propagate through any further
+  // operation, and can be detected once, after a whole computation, using valid()
+
+  template <concepts::arithmetic V>
+  requires std::same_as<V, std::remove_cvref_t<V>>
+  class dynamic_quantity {
+  public:
+    using type = dynamic_quantity;
+    using value_type = V;
+
+  private:
+    value_type m_value = 0;
+    unit_descriptor m_unit;
+
+    static constexpr type invalid() {return type(_dynamic::invalid_value<V>(), unit_descriptor::invalid());}
+
+  public:
+
+    // * constructors
+
+    // dimensionless zero
+    constexpr dynamic_quantity() = default;
+
+    // construct from raw value and unit
+    constexpr dynamic_quantity(const value_type& value, const unit_descriptor& unit)
+    : m_value(value), m_unit(unit_descriptor::make(unit.factor, unit.dim)) {}
+
+    // construct from a quantity, whose unit is known at compile time
+    template <concepts::describable_unit U, concepts::arithmetic W>
+    constexpr dynamic_quantity(const quantity<U, W>& q)
+    : m_value(q.get_value()), m_unit(descriptor_of<U>) {}
+
+    // * access to value and unit
+
+    constexpr const auto& get_value() const {return m_value;}
+    constexpr const auto& get_unit() const {return m_unit;}
+
+    constexpr bool valid() const {return m_unit.valid();}
+
+    // * unit conversion
+
+    // conversion to another runtime unit. the result is invalid if units are incompatible
+    constexpr type convert(const unit_descriptor& unit) const {
+      if (!m_unit.compatible(unit))
+        return invalid();
+
+      const auto value = _dynamic::checked_scale<value_type>(m_value, m_unit.factor/unit.factor);
+      return value? type(*value, unit) : invalid();
+    }
+
+    // checked conversion to a quantity, whose unit is known at compile time. once
+    // converted, values can be processed with no runtime checks at all. empty if the
+    // dimensions differ, or if W is integral and the converted value does not fit in it
+    template <concepts::describable_unit U, concepts::arithmetic W = value_type>
+    constexpr std::optional<quantity<U, W>> convert() const {
+      constexpr auto& unit = descriptor_of<U>;
+
+      if (m_unit.dim != unit.dim)
+        return std::nullopt;
+
+      // scaled before the conversion to W, which may truncate
+      const auto value = _dynamic::checked_scale<W>(m_value, m_unit.factor/unit.factor);
+      return value? std::optional(quantity<U, W>(*value)) : std::nullopt;
+    }
+
+    // * arithmetic operations
+
+    constexpr type operator+() const {return *this;}
+    constexpr type operator-() const {return type(-m_value, m_unit);}
+
+    // addition and subtraction: the result carries the unit of the lhs, except for
+    // integral values, which are added exactly in the common unit of both operands.
+    // integral results that do not fit in the value type are invalid
+    constexpr type operator+(const type& q) const {
+      if (!m_unit.compatible(q.m_unit))
+        return invalid();
+
+      if constexpr (std::is_integral_v<value_type>) {
+        return _dynamic::combine<type>(_dynamic::common(m_value, m_unit, q.m_value, q.m_unit),
+          [](const intm_t a, const intm_t b, intm_t* x) {return __builtin_add_overflow(a, b, x);});
+      } else {
+        return type(m_value + _dynamic::scale(q.m_value, q.m_unit.factor/m_unit.factor), m_unit);
+      }
+    }
+
+    constexpr type operator-(const type& q) const {
+      if (!m_unit.compatible(q.m_unit))
+        return invalid();
+
+      if constexpr (std::is_integral_v<value_type>) {
+        return _dynamic::combine<type>(_dynamic::common(m_value, m_unit, q.m_value, q.m_unit),
+          [](const intm_t a, const intm_t b, intm_t* x) {return __builtin_sub_overflow(a, b, x);});
+      } else {
+        return type(m_value - _dynamic::scale(q.m_value, q.m_unit.factor/m_unit.factor), m_unit);
+      }
+    }
+
+    // multiplication and division by other quantities
+    constexpr type operator*(const type& q) const
+    {return type(m_value * q.m_value, m_unit * q.m_unit);}
+
+    constexpr type operator/(const type& q) const
+    {return type(m_value / q.m_value, m_unit / q.m_unit);}
+
+    // multiplication and division by arithmetic type
+    constexpr type operator*(const concepts::arithmetic auto x) const
+    {return type(m_value * x, m_unit);}
+
+    constexpr type operator/(const concepts::arithmetic auto x) const
+    {return type(m_value / x, m_unit);}
+
+    // * assignment operations
+
+    constexpr type& operator+=(const type& q) {return *this = *this + q;}
+    constexpr type& operator-=(const type& q) {return *this = *this - q;}
+    constexpr type& operator*=(const type& q) {return *this = *this * q;}
+    constexpr type& operator/=(const type& q) {return *this = *this / q;}
+
+    constexpr type& operator*=(const concepts::arithmetic auto x) {m_value *= x; return *this;}
+    constexpr type& operator/=(const concepts::arithmetic auto x) {m_value /= x; return *this;}
+
+    // * comparison
+
+    // quantities of incompatible units are never equal, and are unordered. integral
+    // values are compared exactly, in the common unit of both operands
+
+    constexpr bool operator==(const type& q) const {
+      return (*this <=> q) == 0;
+    }
+
+    constexpr std::partial_ordering operator<=>(const type& q) const {
+      if (!m_unit.compatible(q.m_unit))
+        return std::partial_ordering::unordered;
+
+      if constexpr (std::is_integral_v<value_type>) {
+        const auto [a, b, unit] = _dynamic::common(m_value, m_unit, q.m_value, q.m_unit);
+        return unit.valid()? std::partial_ordering(a <=> b) : std::partial_ordering::unordered;
+      } else {
+        return m_value <=> _dynamic::scale(q.m_value, q.m_unit.factor/m_unit.factor);
+      }
+    }
+  };
+
+  // - multiplication by arithmetic type from lhs
+
+  template <class V>
+  constexpr auto operator*(const concepts::arithmetic auto x, const dynamic_quantity<V>& q) {
+    return q * x;
+  }
+
+  // - deduction guides
+
+  template <class U, class V>
+  dynamic_quantity(quantity<U, V>) -> dynamic_quantity<V>;
+
+}
+
+namespace units {
+  using _details::dynamic_quantity;
+}
+
+#endif
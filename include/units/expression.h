@@ -0,0 +1,277 @@
+#ifndef _include_units_expression_h
+#define _include_units_expression_h
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include <units/algorithm.h>
+#include <units/details/quantity.h>
+#include <units/details/simd.h>
+#include <units/details/unit.h>
+
+namespace units::_details {
+
+  // - forward declarations
+
+  namespace _expr {
+    template <class Q>
+    struct terminal;
+
+    template <class Q>
+    struct constant;
+
+    template <class Op, class L, class R>
+    struct additive;
+
+    template <class Op, class L, class R>
+    struct multiplicative;
+
+    template <class E>
+    struct negation;
+  }
+
+  // - traits and concepts
+
+  namespace traits {
+    // * type is a node of a quantity expression
+    template <class T>
+    struct is_expression : std::false_type {};
+
+    template <class Q>
+    struct is_expression<_expr::terminal<Q>> : std::true_type {};
+
+    template <class Q>
+    struct is_expression<_expr::constant<Q>> : std::true_type {};
+
+    template <class Op, class L, class R>
+    struct is_expression<_expr::additive<Op, L, R>> : std::true_type {};
+
+    template <class Op, class L, class R>
+    struct is_expression<_expr::multiplicative<Op, L, R>> : std::true_type {};
+
+    template <class E>
+    struct is_expression<_expr::negation<E>> : std::true_type {};
+
+    template <class T>
+    constexpr inline bool is_expression_v = is_expression<T>::value;
+  }
+
+  namespace concepts {
+    template <class T>
+    concept expression = traits::is_expression_v<T>;
+
+    // types that can take part in an expression: quantities and numbers are
+    // broadcast to all elements
+    template <class T>
+    concept expression_operand = expression<T> || quantity<T> || arithmetic<T>;
+  }
+
+  // - evaluation of a node in a given unit
+
+  // sums and differences pass the target unit down to their operands, so that any
+  // other node is scaled to the target unit exactly once. as units are known at
+  // compile time, the scaling factor of each node is a single folded constant,
+  // which is omitted altogether when it is one
+
+  namespace _expr {
+    template <class E>
+    struct is_additive : std::false_type {};
+
+    template <class Op, class L, class R>
+    struct is_additive<additive<Op, L, R>> : std::true_type {};
+
+    template <class Target, class W, concepts::expression E>
+    constexpr W eval(const E& e, const std::size_t i) {
+      if constexpr (is_additive<E>::value) {
+        return typename E::operation{}(eval<Target, W>(e.lhs, i), eval<Target, W>(e.rhs, i));
+      } else {
+        using factor = ratio_divide<typename E::unit_type::factor, typename Target::factor>;
+        return _algorithm::scale<factor, W>(e[i]);
+      }
+    }
+  }
+
+  // - expression nodes
+
+  namespace _expr {
+    // size of nodes broadcasting a single value
+    constexpr inline std::size_t broadcast = std::numeric_limits<std::size_t>::max();
+
+    // * a contiguous range of quantities
+    template <class Q>
+    struct terminal {
+      using unit_type = typename Q::unit_type;
+      using value_type = typename Q::value_type;
+
+      const Q* data;
+      std::size_t count;
+
+      constexpr std::size_t size() const {return count;}
+      constexpr value_type operator[](const std::size_t i) const {return data[i].get_value();}
+    };
+
+    // * a single quantity, the same for all elements
+    template <class Q>
+    struct constant {
+      using unit_type = typename Q::unit_type;
+      using value_type = typename Q::value_type;
+
+      Q value;
+
+      constexpr std::size_t size() const {return broadcast;}
+      constexpr value_type operator[](std::size_t) const {return value.get_value();}
+    };
+
+    // * sum or difference of nodes with compatible units, in the unit of lhs
+    template <class Op, class L, class R>
+    struct additive {
+      using operation = Op;
+      using unit_type = typename L::unit_type;
+      using value_type = std::common_type_t<typename L::value_type, typename R::value_type>;
+
+      L lhs;
+      R rhs;
+
+      constexpr std::size_t size() const {return std::min(lhs.size(), rhs.size());}
+      constexpr value_type operator[](const std::size_t i) const {return eval<unit_type, value_type>(*this, i);}
+    };
+
+    // * product or ratio of nodes
+    template <class Op, class L, class R>
+    struct multiplicative {
+      using unit_type = std::conditional_t<std::is_same_v<Op, std::multiplies<>>,
+        unit_multiply<typename L::unit_type, typename R::unit_type>,
+        unit_divide<typename L::unit_type, typename R::unit_type>>;
+      using value_type = decltype(Op{}(std::declval<typename L::value_type>(), std::declval<typename R::value_type>()));
+
+      L lhs;
+      R rhs;
+
+      constexpr std::size_t size() const {return std::min(lhs.size(), rhs.size());}
+      constexpr value_type operator[](const std::size_t i) const {return Op{}(lhs[i], rhs[i]);}
+    };
+
+    // * negated node
+    template <class E>
+    struct negation {
+      using unit_type = typename E::unit_type;
+      using value_type = decltype(-std::declval<typename E::value_type>());
+
+      E operand;
+
+      constexpr std::size_t size() const {return operand.size();}
+      constexpr value_type operator[](const std::size_t i) const {return -operand[i];}
+    };
+
+    // * conversion of operands into nodes
+    template <concepts::expression_operand T>
+    constexpr auto node(const T& x) {
+      if constexpr (concepts::expression<T>)
+        return x;
+      else if constexpr (concepts::quantity<T>)
+        return constant<T>{x};
+      else
+        return constant<quantity<unit<one>, T>>{quantity<unit<one>, T>(x)};
+    }
+
+    template <class T>
+    using node_t = decltype(node(std::declval<T>()));
+
+    // * operators, taking part whenever at least one operand is an expression
+
+    template <class A, class B>
+    concept operands =
+      concepts::expression_operand<A> && concepts::expression_operand<B> &&
+      (concepts::expression<A> || concepts::expression<B>);
+
+    template <class A, class B>
+    requires operands<A, B> && concepts::unit_compatible<typename node_t<A>::unit_type, typename node_t<B>::unit_type>
+    constexpr auto operator+(const A& a, const B& b)
+    {return additive<std::plus<>, node_t<A>, node_t<B>>{node(a), node(b)};}
+
+    template <class A, class B>
+    requires operands<A, B> && concepts::unit_compatible<typename node_t<A>::unit_type, typename node_t<B>::unit_type>
+    constexpr auto operator-(const A& a, const B& b)
+    {return additive<std::minus<>, node_t<A>, node_t<B>>{node(a), node(b)};}
+
+    template <class A, class B>
+    requires operands<A, B>
+    constexpr auto operator*(const A& a, const B& b)
+    {return multiplicative<std::multiplies<>, node_t<A>, node_t<B>>{node(a), node(b)};}
+
+    template <class A, class B>
+    requires operands<A, B>
+    constexpr auto operator/(const A& a, const B& b)
+    {return multiplicative<std::divides<>, node_t<A>, node_t<B>>{node(a), node(b)};}
+
+    template <concepts::expression E>
+    constexpr auto operator-(const E& e)
+    {return negation<E>{e};}
+  }
+
+  // - opt into expressions: view a contiguous range of quantities as a terminal node
+
+  // the range is referenced, not copied, so it must outlive the expression
+  template <std::ranges::contiguous_range R>
+  requires concepts::quantity<std::ranges::range_value_t<R>>
+  constexpr auto lazy(const R& range) {
+    return _expr::terminal<std::ranges::range_value_t<R>>{std::ranges::data(range), std::ranges::size(range)};
+  }
+
+  // - evaluate an expression into a contiguous range of quantities
+
+  // the whole expression is computed in a single pass, element by element, with no
+  // temporary arrays. at most min(e.size(), out.size()) elements are evaluated, and
+  // the returned span refers to the elements of out that were actually written
+  template <concepts::expression E, std::ranges::contiguous_range Out>
+  requires
+    concepts::quantity<std::ranges::range_value_t<Out>> &&
+    concepts::unit_compatible<typename std::ranges::range_value_t<Out>::unit_type, typename E::unit_type>
+  constexpr auto evaluate_into(const E& e, Out&& out) {
+    using quantity_type = std::ranges::range_value_t<Out>;
+    using unit_type = typename quantity_type::unit_type;
+    using value_type = typename quantity_type::value_type;
+
+    constexpr std::size_t width = _simd::lanes<value_type>;
+
+    const auto n = std::min<std::size_t>(e.size(), std::ranges::size(out));
+    const auto data = std::ranges::data(out);
+
+    // blocked as in _algorithm::scale_n, so that each block is evaluated as a whole
+    // before being stored, even if out is also an operand of the expression
+    std::size_t i = 0;
+
+    for (; i + width <= n; i += width) {
+      value_type block[width];
+
+      for (std::size_t j = 0; j < width; ++j)
+        block[j] = _expr::eval<unit_type, value_type>(e, i+j);
+
+      for (std::size_t j = 0; j < width; ++j)
+        data[i+j] = quantity_type(block[j]);
+    }
+
+    for (; i < n; ++i)
+      data[i] = quantity_type(_expr::eval<unit_type, value_type>(e, i));
+
+    return std::span(data, n);
+  }
+
+}
+
+namespace units {
+
+  // * lazily evaluated expressions over ranges of quantities
+
+  using _details::lazy;
+  using _details::evaluate_into;
+
+}
+
+#endif
@@ -0,0 +1,238 @@
+#ifndef _include_units_format_h
+#define _include_units_format_h
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include <units/framework.h>
+#include <units/parser.h>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+namespace units::_details {
+
+  // - format specification
+
+  // the format specification of a quantity reads
+  //
+  //   [ '.' precision ] [ 'a' | 'e' | 'f' | 'g' ] [ ':' unit ]
+  //
+  // with precision and type as for floating point numbers in std::format, and unit
+  // any expression accepted by parse_unit. when a unit is given, the value is
+  // converted to that unit and printed along with the unit as it was written
+
+  namespace _format {
+
+    // * the largest precision accepted in a specification
+    constexpr inline int max_precision = 1000;
+
+    // * the type in which values of type V are written
+    template <class V>
+    using number_t = std::conditional_t<std::is_floating_point_v<V>, V, double>;
+
+    // * the length of the longest value of type V written according to any
+    // * specification: in fixed notation, with a sign, all the digits of the
+    // * largest value, a point and max_precision decimals
+    template <class V>
+    constexpr inline std::size_t max_length = std::numeric_limits<number_t<V>>::max_exponent10 + max_precision + 8;
+
+    struct spec {
+      int precision = -1;
+      std::optional<std::chars_format> format;
+      std::string_view unit_text;
+      std::optional<unit_descriptor> unit;
+    };
+
+    constexpr std::optional<spec> parse_spec(std::string_view text) {
+      spec ret;
+
+      if (text.starts_with('.')) {
+        text.remove_prefix(1);
+
+        if (text.empty() || text.front() < '0' || text.front() > '9')
+          return std::nullopt;
+
+        ret.precision = 0;
+        while (!text.empty() && text.front() >= '0' && text.front() <= '9') {
+          ret.precision = 10*ret.precision + (text.front() - '0');
+          text.remove_prefix(1);
+
+          if (ret.precision > max_precision)
+            return std::nullopt;
+        }
+      }
+
+      if (!text.empty() && text.front() != ':') {
+        switch (text.front()) {
+          case 'a': ret.format = std::chars_format::hex; break;
+          case 'e': ret.format = std::chars_format::scientific; break;
+          case 'f': ret.format = std::chars_format::fixed; break;
+          case 'g': ret.format = std::chars_format::general; break;
+          default: return std::nullopt;
+        }
+        text.remove_prefix(1);
+
+        // as in std::format, all types but 'a' default to a precision of six
+        if (ret.precision < 0 && ret.format != std::chars_format::hex)
+          ret.precision = 6;
+      }
+
+      if (text.starts_with(':')) {
+        ret.unit_text = text.substr(1);
+        ret.unit = parse_unit(ret.unit_text);
+
+        if (!ret.unit)
+          return std::nullopt;
+
+        text = {};
+      }
+
+      if (!text.empty())
+        return std::nullopt;
+
+      return ret;
+    }
+
+    // * write a number according to the specification
+    template <class T>
+    std::to_chars_result write_value(char* first, char* last, const T value, const spec& s) {
+      if constexpr (std::is_integral_v<T>) {
+        // integers are written as floating point numbers if any format is requested
+        if (s.precision >= 0 || s.format)
+          return write_value(first, last, static_cast<double>(value), s);
+        else
+          return std::to_chars(first, last, value);
+      } else if (s.precision >= 0) {
+        return std::to_chars(first, last, value, s.format.value_or(std::chars_format::general), s.precision);
+      } else if (s.format) {
+        return std::to_chars(first, last, value, *s.format);
+      } else {
+        return std::to_chars(first, last, value);
+      }
+    }
+
+    // * write text, failing if it does not fit
+    inline std::to_chars_result write_text(char* first, char* last, const std::string_view text) {
+      if (last - first < static_cast<std::ptrdiff_t>(text.size()))
+        return {last, std::errc::value_too_large};
+
+      return {std::copy(text.begin(), text.end(), first), std::errc()};
+    }
+
+    // * write the value of a quantity, converted to the unit in the specification
+    template <class U, class V>
+    std::to_chars_result write_number(char* first, char* last, const quantity<U, V>& q, const spec& s) {
+      if (!s.unit)
+        return write_value(first, last, q.get_value(), s);
+
+      if constexpr (concepts::describable_unit<U>) {
+        constexpr auto& unit = descriptor_of<U>;
+
+        if (!unit.compatible(*s.unit))
+          return {last, std::errc::invalid_argument};
+
+        using T = number_t<V>;
+        const auto factor = (unit.factor/s.unit->factor).template value<T>();
+        return write_value(first, last, static_cast<T>(q.get_value()) * factor, s);
+      } else {
+        return {last, std::errc::invalid_argument};
+      }
+    }
+
+    // * the unit printed after the value
+    template <class U>
+    constexpr std::string_view unit_text(const spec& s) {
+      return s.unit? s.unit_text : std::string_view(U::symbol);
+    }
+
+    // * write a quantity according to the specification: the value, a space, the unit
+    template <class U, class V>
+    std::to_chars_result write(char* first, char* last, const quantity<U, V>& q, const spec& s) {
+      auto ret = write_number(first, last, q, s);
+      if (ret.ec == std::errc())
+        ret = write_text(ret.ptr, last, " ");
+      if (ret.ec == std::errc())
+        ret = write_text(ret.ptr, last, unit_text<U>(s));
+      return ret;
+    }
+
+  }
+
+  // - write a quantity into a character buffer
+
+  // as std::to_chars, writes into [first, last) without allocating, and returns the
+  // end of the written text or an error code: std::errc::value_too_large if the
+  // buffer is too small, std::errc::invalid_argument if the specification is
+  // malformed or requests a unit incompatible with the quantity
+
+  template <class U, class V>
+  std::to_chars_result to_chars(char* first, char* last, const quantity<U, V>& q) {
+    return _format::write(first, last, q, _format::spec());
+  }
+
+  template <class U, class V>
+  std::to_chars_result to_chars(char* first, char* last, const quantity<U, V>& q, const std::string_view spec) {
+    const auto s = _format::parse_spec(spec);
+    return s? _format::write(first, last, q, *s) : std::to_chars_result{last, std::errc::invalid_argument};
+  }
+
+}
+
+// - std::formatter specialization for quantities
+
+#if defined(__cpp_lib_format)
+
+template <class U, class V>
+struct std::formatter<units::_details::quantity<U, V>, char> {
+private:
+  units::_details::_format::spec m_spec;
+
+public:
+  constexpr auto parse(std::format_parse_context& ctx) {
+    const auto end = std::find(ctx.begin(), ctx.end(), '}');
+    const auto spec = units::_details::_format::parse_spec(std::string_view(ctx.begin(), end));
+
+    if (!spec)
+      throw std::format_error("invalid format specification for a quantity");
+
+    if constexpr (units::_details::concepts::describable_unit<U>) {
+      if (spec->unit && !units::_details::descriptor_of<U>.compatible(*spec->unit))
+        throw std::format_error("incompatible unit in the format specification of a quantity");
+    }
+
+    m_spec = *spec;
+    return end;
+  }
+
+  template <class FormatContext>
+  auto format(const units::_details::quantity<U, V>& q, FormatContext& ctx) const {
+    // the precision is limited, so any value fits
+    char buffer[units::_details::_format::max_length<V>];
+    const auto [end, ec] = units::_details::_format::write_number(buffer, buffer + sizeof(buffer), q, m_spec);
+
+    if (ec != std::errc())
+      throw std::format_error("quantity cannot be formatted");
+
+    const auto unit = units::_details::_format::unit_text<U>(m_spec);
+
+    auto out = std::copy(buffer, end, ctx.out());
+    *out++ = ' ';
+    return std::copy(unit.begin(), unit.end(), out);
+  }
+};
+
+#endif
+
+namespace units {
+  using _details::to_chars;
+}
+
+#endif
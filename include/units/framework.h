@@ -1,10 +1,12 @@
 #ifndef _include_units_framework_h
 #define _include_units_framework_h
 
+#include <units/details/descriptor.h>
 #include <units/details/macros.h>
 #include <units/details/power.h>
 #include <units/details/quantity.h>
 #include <units/details/ratio.h>
+#include <units/details/registry.h>
 #include <units/details/unit.h>
 
 namespace units {
@@ -17,13 +19,39 @@ namespace units {
   using _details::ratio_multiply;
   using _details::ratio_divide;
   using _details::ratio_power;
-  using namespace _details::prefixes;
+
+  // prefixes, as the common powers below, are declared one by one rather than with a
+  // using-directive, which would not be exported by the units module
+  using _details::yocto;
+  using _details::zepto;
+  using _details::atto;
+  using _details::femto;
+  using _details::pico;
+  using _details::nano;
+  using _details::micro;
+  using _details::milli;
+  using _details::centi;
+  using _details::deci;
+  using _details::one;
+  using _details::deca;
+  using _details::hecto;
+  using _details::kilo;
+  using _details::mega;
+  using _details::giga;
+  using _details::tera;
+  using _details::peta;
+  using _details::exa;
+  using _details::zetta;
+  using _details::yotta;
 
   // * powers, power multiplication, and common powers
 
   using _details::power;
   using _details::power_multiply;
-  using namespace _details::common_powers;
+  using _details::power_null;
+  using _details::inverse;
+  using _details::squared;
+  using _details::inverse_squared;
 
   // * unit, base unit, and unit-creation helpers
 
@@ -33,10 +61,31 @@ namespace units {
   using _details::unit_multiply;
   using _details::unit_divide;
 
+  // * runtime unit descriptors
+
+  using _details::dimension;
+  using _details::runtime_ratio;
+  using _details::unit_descriptor;
+  using _details::descriptor_of;
+
+  // * lists and registries of units, and unit fingerprints
+
+  using _details::unit_list;
+  using _details::unit_list_cat;
+  using _details::unit_registry;
+  using _details::registered_unit;
+  using _details::fingerprint;
+  using _details::fingerprint_of;
+
   // * quantities
 
   using _details::quantity;
 
+  // * rounding and overflow policies of integral conversions
+
+  namespace rounding = _details::rounding;
+  namespace overflow = _details::overflow;
+
   // * literals (defined along with units)
 
   namespace literals {};
@@ -0,0 +1,595 @@
+#ifndef _include_units_heterogeneous_h
+#define _include_units_heterogeneous_h
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <units/details/quantity.h>
+#include <units/details/ratio.h>
+#include <units/details/registry.h>
+#include <units/details/unit.h>
+#include <units/linalg.h>
+
+namespace units::_details {
+
+  namespace _heterogeneous {
+
+    // - operations on lists of units
+
+    template <class L>
+    struct list;
+
+    template <concepts::unit... Us>
+    struct list<unit_list<Us...>> {
+      static constexpr std::size_t size = sizeof...(Us);
+
+      template <std::size_t I>
+      using at = std::tuple_element_t<I, std::tuple<Us...>>;
+
+      using inverted = unit_list<make_unit<inverse<Us>>...>;
+
+      template <class U>
+      using times = unit_list<unit_multiply<Us, U>...>;
+    };
+
+    template <class L>
+    constexpr inline std::size_t size_v = list<L>::size;
+
+    template <class L, std::size_t I>
+    using at_t = typename list<L>::template at<I>;
+
+    template <class L>
+    using inverse_t = typename list<L>::inverted;
+
+    template <class L, class U>
+    using times_t = typename list<L>::template times<U>;
+
+    template <class L>
+    concept units = requires {list<L>::size;} && (list<L>::size > 0);
+
+    // * unit of the element (i, j) of a matrix whose rows have units R and columns C
+    template <class R, class C, std::size_t I, std::size_t J>
+    using element_t = unit_multiply<at_t<R, I>, at_t<C, J>>;
+
+    // - contractions: sums over k of the products of the elements k of two lists
+
+    // the products must all have compatible units, and are summed in the unit of the
+    // first one: the others are scaled by a constant factor, which is one (and is not
+    // applied) when the units of the lists are written consistently
+
+    template <class A, class B, std::size_t K>
+    using term_t = unit_multiply<at_t<A, K>, at_t<B, K>>;
+
+    template <class A, class B>
+    using contraction_t = term_t<A, B, 0>;
+
+    template <class A, class B>
+    constexpr bool contractible() {
+      if constexpr (size_v<A> != size_v<B>)
+        return false;
+      else
+        return []<std::size_t... K>(std::index_sequence<K...>) {
+          return (concepts::unit_compatible<term_t<A, B, K>, contraction_t<A, B>> && ...);
+        }(std::make_index_sequence<size_v<A>>());
+    }
+
+    template <class V, class A, class B>
+    constexpr auto contraction_factors() {
+      return []<std::size_t... K>(std::index_sequence<K...>) {
+        return std::array<V, sizeof...(K)>{
+          ratio_divide<typename term_t<A, B, K>::factor, typename contraction_t<A, B>::factor>::template value<V>...};
+      }(std::make_index_sequence<size_v<A>>());
+    }
+
+    // - element-wise operations between matrices of r x c elements
+
+    // element k is at row k/c and column k%c. a vector is a matrix of one column,
+    // whose unit is make_unit<>
+
+    template <class Ra, class Ca, class Rb, class Cb>
+    constexpr bool elementwise_compatible() {
+      if constexpr (size_v<Ra> != size_v<Rb> || size_v<Ca> != size_v<Cb>)
+        return false;
+      else
+        return []<std::size_t... K>(std::index_sequence<K...>) {
+          constexpr std::size_t c = size_v<Ca>;
+          return (concepts::unit_compatible<element_t<Ra, Ca, K/c, K%c>, element_t<Rb, Cb, K/c, K%c>> && ...);
+        }(std::make_index_sequence<size_v<Ra>*size_v<Ca>>());
+    }
+
+    // factors converting the elements of b into the units of the elements of a
+    template <class V, class Ra, class Ca, class Rb, class Cb>
+    constexpr auto elementwise_factors() {
+      return []<std::size_t... K>(std::index_sequence<K...>) {
+        constexpr std::size_t c = size_v<Ca>;
+        return std::array<V, sizeof...(K)>{
+          ratio_divide<typename element_t<Rb, Cb, K/c, K%c>::factor, typename element_t<Ra, Ca, K/c, K%c>::factor>::template value<V>...};
+      }(std::make_index_sequence<size_v<Ra>*size_v<Ca>>());
+    }
+
+    template <class V, std::size_t N>
+    constexpr bool all_one(const std::array<V, N>& factors) {
+      for (const auto f : factors)
+        if (f != V(1))
+          return false;
+      return true;
+    }
+
+    // * a += f*b or a -= f*b, element-wise, skipping f when all factors are one
+    template <auto factors, class V>
+    constexpr void accumulate(V* const a, const V* const b, const bool subtract) {
+      const V sign = subtract? V(-1) : V(1);
+      for (std::size_t k = 0; k < factors.size(); ++k) {
+        if constexpr (all_one(factors))
+          a[k] += sign*b[k];
+        else
+          a[k] += sign*factors[k]*b[k];
+      }
+    }
+
+    using dimensionless = unit_list<make_unit<>>;
+
+    // * whether quantities of types Qs are compatible with the elements of L
+    template <class L, class V, class... Qs>
+    constexpr bool compatible_elements() {
+      if constexpr (size_v<L> != sizeof...(Qs))
+        return false;
+      else
+        return []<std::size_t... I>(std::index_sequence<I...>) {
+          return (concepts::quantity_compatible<quantity<at_t<L, I>, V>, Qs> && ...);
+        }(std::make_index_sequence<size_v<L>>());
+    }
+
+    // * whether the diagonal of a square matrix is dimensionless
+    template <class R, class C>
+    constexpr bool dimensionless_diagonal() {
+      if constexpr (size_v<R> != size_v<C>)
+        return false;
+      else
+        return []<std::size_t... I>(std::index_sequence<I...>) {
+          return (concepts::dimensionless_unit<element_t<R, C, I, I>> && ...);
+        }(std::make_index_sequence<size_v<R>>());
+    }
+
+  }
+
+  // - vectors of quantities of different units
+
+  // a state vector, holding for example a position, a velocity and an angle. the
+  // units of the elements are part of the type, and the values are stored packed,
+  // as a plain array of floating-point numbers that can be handed to numerical
+  // libraries. every operation checks the units of the elements it combines at
+  // compile time, and does nothing else at run time
+
+  template <class L, std::floating_point V = double>
+  requires _heterogeneous::units<L>
+  class hvec;
+
+  template <class R, class C, std::floating_point V = double>
+  requires _heterogeneous::units<R> && _heterogeneous::units<C>
+  class hmat;
+
+  template <class L, std::floating_point V>
+  requires _heterogeneous::units<L>
+  class hvec {
+  public:
+    using units_type = L;
+    using value_type = V;
+
+    static constexpr std::size_t extent = _heterogeneous::size_v<L>;
+
+    // * type of the element i
+    template <std::size_t I>
+    using quantity_type = quantity<_heterogeneous::at_t<L, I>, V>;
+
+  private:
+    alignas(_linalg::alignment<V, extent>) V m_values[extent] = {};
+
+    template <class Lb, std::floating_point W>
+    requires _heterogeneous::units<Lb>
+    friend class hvec;
+
+  public:
+    // * constructors
+
+    // all elements are zero
+    constexpr hvec() = default;
+
+    // from one quantity of compatible unit per element
+    template <class... Qs>
+    requires (_heterogeneous::compatible_elements<L, V, Qs...>())
+    constexpr hvec(const Qs... qs)
+    : hvec(std::make_index_sequence<extent>(), qs...) {}
+
+    // from a vector of compatible units
+    template <class Lb>
+    requires (_heterogeneous::elementwise_compatible<L, _heterogeneous::dimensionless, Lb, _heterogeneous::dimensionless>())
+    explicit constexpr hvec(const hvec<Lb, V>& other) {
+      *this += other;
+    }
+
+  private:
+    template <std::size_t... I, class... Qs>
+    constexpr hvec(std::index_sequence<I...>, const Qs... qs)
+    : m_values{quantity_type<I>(qs).get_value()...} {}
+
+  public:
+    // * access to the elements
+
+    template <std::size_t I>
+    requires (I < extent)
+    constexpr quantity_type<I> get() const {
+      return quantity_type<I>(m_values[I]);
+    }
+
+    template <std::size_t I>
+    requires (I < extent)
+    constexpr hvec& set(const concepts::quantity_compatible<quantity_type<I>> auto q) {
+      m_values[I] = quantity_type<I>(q).get_value();
+      return *this;
+    }
+
+    // * the raw values, each in the unit of its element
+
+    static constexpr std::size_t size() {return extent;}
+
+    constexpr V* data() {return m_values;}
+    constexpr const V* data() const {return m_values;}
+
+    constexpr std::span<V, extent> values() {return m_values;}
+    constexpr std::span<const V, extent> values() const {return m_values;}
+
+    // * assignment operations
+
+    template <class Lb>
+    requires (_heterogeneous::elementwise_compatible<L, _heterogeneous::dimensionless, Lb, _heterogeneous::dimensionless>())
+    constexpr hvec& operator+=(const hvec<Lb, V>& other) {
+      constexpr auto factors = _heterogeneous::elementwise_factors<V, L, _heterogeneous::dimensionless, Lb, _heterogeneous::dimensionless>();
+      _heterogeneous::accumulate<factors>(m_values, other.m_values, false);
+      return *this;
+    }
+
+    template <class Lb>
+    requires (_heterogeneous::elementwise_compatible<L, _heterogeneous::dimensionless, Lb, _heterogeneous::dimensionless>())
+    constexpr hvec& operator-=(const hvec<Lb, V>& other) {
+      constexpr auto factors = _heterogeneous::elementwise_factors<V, L, _heterogeneous::dimensionless, Lb, _heterogeneous::dimensionless>();
+      _heterogeneous::accumulate<factors>(m_values, other.m_values, true);
+      return *this;
+    }
+
+    constexpr hvec& operator*=(const V x) {
+      for (auto& v : m_values)
+        v *= x;
+      return *this;
+    }
+
+    constexpr hvec& operator/=(const V x) {
+      for (auto& v : m_values)
+        v /= x;
+      return *this;
+    }
+
+    // * arithmetic, in the units of the left operand
+
+    template <class Lb>
+    requires (_heterogeneous::elementwise_compatible<L, _heterogeneous::dimensionless, Lb, _heterogeneous::dimensionless>())
+    constexpr hvec operator+(const hvec<Lb, V>& other) const {
+      return hvec(*this) += other;
+    }
+
+    template <class Lb>
+    requires (_heterogeneous::elementwise_compatible<L, _heterogeneous::dimensionless, Lb, _heterogeneous::dimensionless>())
+    constexpr hvec operator-(const hvec<Lb, V>& other) const {
+      return hvec(*this) -= other;
+    }
+
+    constexpr hvec operator*(const V x) const {
+      return hvec(*this) *= x;
+    }
+
+    constexpr hvec operator/(const V x) const {
+      return hvec(*this) /= x;
+    }
+
+    constexpr hvec operator-() const {
+      return hvec(*this) *= V(-1);
+    }
+
+    // * comparison, of vectors with the same units
+    constexpr bool operator==(const hvec&) const = default;
+  };
+
+  template <class L, std::floating_point V>
+  constexpr auto operator*(const V x, const hvec<L, V>& v) {
+    return v * x;
+  }
+
+  // - matrices of quantities of different units
+
+  // the unit of the element (i, j) is the product of the units R_i of the row i and
+  // C_j of the column j. all matrices relating two vectors, and all products of such
+  // matrices, are of this form: a covariance of a state of units X has units X_i X_j,
+  // and a jacobian of y with respect to x has units Y_i / X_j. the product of an r x k
+  // and a k x c matrix is defined when the products of the units of the columns of the
+  // first and of the rows of the second are all compatible, which is checked at
+  // compile time: for the covariance P and the jacobian H of a measurement, P * H^T
+  // compiles, but P * H does not
+
+  template <class R, class C, std::floating_point V>
+  requires _heterogeneous::units<R> && _heterogeneous::units<C>
+  class hmat {
+  public:
+    using row_units = R;
+    using column_units = C;
+    using value_type = V;
+
+    static constexpr std::size_t rows = _heterogeneous::size_v<R>;
+    static constexpr std::size_t columns = _heterogeneous::size_v<C>;
+
+    // * type of the element (i, j)
+    template <std::size_t I, std::size_t J>
+    using quantity_type = quantity<_heterogeneous::element_t<R, C, I, J>, V>;
+
+  private:
+    alignas(_linalg::alignment<V, rows*columns>) V m_values[rows*columns] = {};
+
+    template <class Rb, class Cb, std::floating_point W>
+    requires _heterogeneous::units<Rb> && _heterogeneous::units<Cb>
+    friend class hmat;
+
+  public:
+    // * constructors
+
+    // all elements are zero
+    constexpr hmat() = default;
+
+    // from a matrix of compatible units
+    template <class Rb, class Cb>
+    requires (_heterogeneous::elementwise_compatible<R, C, Rb, Cb>())
+    explicit constexpr hmat(const hmat<Rb, Cb, V>& other) {
+      *this += other;
+    }
+
+    // the identity, for matrices whose diagonal is dimensionless
+    static constexpr hmat identity()
+    requires (_heterogeneous::dimensionless_diagonal<R, C>()) {
+      hmat ret;
+      [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (ret.template set<I, I>(quantity<make_unit<>, V>(1)), ...);
+      }(std::make_index_sequence<rows>());
+      return ret;
+    }
+
+    // * access to the elements
+
+    template <std::size_t I, std::size_t J>
+    requires (I < rows && J < columns)
+    constexpr quantity_type<I, J> get() const {
+      return quantity_type<I, J>(m_values[I*columns + J]);
+    }
+
+    template <std::size_t I, std::size_t J>
+    requires (I < rows && J < columns)
+    constexpr hmat& set(const concepts::quantity_compatible<quantity_type<I, J>> auto q) {
+      m_values[I*columns + J] = quantity_type<I, J>(q).get_value();
+      return *this;
+    }
+
+    // * the raw values, in row-major order, each in the unit of its element
+
+    constexpr V* data() {return m_values;}
+    constexpr const V* data() const {return m_values;}
+
+    constexpr std::span<V, rows*columns> values() {return m_values;}
+    constexpr std::span<const V, rows*columns> values() const {return m_values;}
+
+    // * assignment operations
+
+    template <class Rb, class Cb>
+    requires (_heterogeneous::elementwise_compatible<R, C, Rb, Cb>())
+    constexpr hmat& operator+=(const hmat<Rb, Cb, V>& other) {
+      constexpr auto factors = _heterogeneous::elementwise_factors<V, R, C, Rb, Cb>();
+      _heterogeneous::accumulate<factors>(m_values, other.m_values, false);
+      return *this;
+    }
+
+    template <class Rb, class Cb>
+    requires (_heterogeneous::elementwise_compatible<R, C, Rb, Cb>())
+    constexpr hmat& operator-=(const hmat<Rb, Cb, V>& other) {
+      constexpr auto factors = _heterogeneous::elementwise_factors<V, R, C, Rb, Cb>();
+      _heterogeneous::accumulate<factors>(m_values, other.m_values, true);
+      return *this;
+    }
+
+    constexpr hmat& operator*=(const V x) {
+      for (auto& v : m_values)
+        v *= x;
+      return *this;
+    }
+
+    constexpr hmat& operator/=(const V x) {
+      for (auto& v : m_values)
+        v /= x;
+      return *this;
+    }
+
+    // * arithmetic, in the units of the left operand
+
+    template <class Rb, class Cb>
+    requires (_heterogeneous::elementwise_compatible<R, C, Rb, Cb>())
+    constexpr hmat operator+(const hmat<Rb, Cb, V>& other) const {
+      return hmat(*this) += other;
+    }
+
+    template <class Rb, class Cb>
+    requires (_heterogeneous::elementwise_compatible<R, C, Rb, Cb>())
+    constexpr hmat operator-(const hmat<Rb, Cb, V>& other) const {
+      return hmat(*this) -= other;
+    }
+
+    constexpr hmat operator*(const V x) const {
+      return hmat(*this) *= x;
+    }
+
+    constexpr hmat operator/(const V x) const {
+      return hmat(*this) /= x;
+    }
+
+    constexpr hmat operator-() const {
+      return hmat(*this) *= V(-1);
+    }
+
+    // * products
+
+    // the row i of the product is accumulated as a linear combination of the rows of
+    // the right operand, which vectorizes along the rows
+    template <class Rb, class Cb>
+    requires (_heterogeneous::contractible<C, Rb>())
+    constexpr auto operator*(const hmat<Rb, Cb, V>& other) const {
+      using K = _heterogeneous::contraction_t<C, Rb>;
+      constexpr auto factors = _heterogeneous::contraction_factors<V, C, Rb>();
+      constexpr std::size_t n = hmat<Rb, Cb, V>::columns;
+
+      hmat<_heterogeneous::times_t<R, K>, Cb, V> ret;
+      for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t k = 0; k < columns; ++k) {
+          const V a = m_values[i*columns + k] * factors[k];
+          for (std::size_t j = 0; j < n; ++j)
+            ret.m_values[i*n + j] += a * other.m_values[k*n + j];
+        }
+      }
+      return ret;
+    }
+
+    template <class L>
+    requires (_heterogeneous::contractible<C, L>())
+    constexpr auto operator*(const hvec<L, V>& v) const {
+      using K = _heterogeneous::contraction_t<C, L>;
+      constexpr auto factors = _heterogeneous::contraction_factors<V, C, L>();
+      const V* const x = v.data();
+
+      hvec<_heterogeneous::times_t<R, K>, V> ret;
+      for (std::size_t i = 0; i < rows; ++i) {
+        V sum = 0;
+        for (std::size_t k = 0; k < columns; ++k)
+          sum += m_values[i*columns + k] * (factors[k] * x[k]);
+        ret.data()[i] = sum;
+      }
+      return ret;
+    }
+
+    // * comparison, of matrices with the same units
+    constexpr bool operator==(const hmat&) const = default;
+  };
+
+  template <class R, class C, std::floating_point V>
+  constexpr auto operator*(const V x, const hmat<R, C, V>& m) {
+    return m * x;
+  }
+
+  // * covariance of a vector with units L, and jacobian of a vector of units Y with
+  // * respect to one of units X
+  template <class L, std::floating_point V = double>
+  using covariance = hmat<L, L, V>;
+
+  template <class Y, class X, std::floating_point V = double>
+  using jacobian = hmat<Y, _heterogeneous::inverse_t<X>, V>;
+
+  namespace _heterogeneous {
+
+    // - transpose and inverse
+
+    template <class R, class C, class V>
+    constexpr auto transpose(const hmat<R, C, V>& m) {
+      constexpr std::size_t r = hmat<R, C, V>::rows;
+      constexpr std::size_t c = hmat<R, C, V>::columns;
+
+      hmat<C, R, V> ret;
+      for (std::size_t i = 0; i < r; ++i)
+        for (std::size_t j = 0; j < c; ++j)
+          ret.data()[j*r + i] = m.data()[i*c + j];
+      return ret;
+    }
+
+    // the inverse of a matrix with units R_i C_j has units 1/C_i 1/R_j, and its raw
+    // values are the inverse of the raw values. it is computed by gauss-jordan
+    // elimination with partial pivoting, and is empty when the matrix is singular
+    template <class R, class C, class V>
+    requires (size_v<R> == size_v<C>)
+    constexpr auto invert(const hmat<R, C, V>& m) {
+      constexpr std::size_t n = size_v<R>;
+      using result_type = hmat<inverse_t<C>, inverse_t<R>, V>;
+
+      V a[n][n];
+      V b[n][n];
+      for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+          a[i][j] = m.data()[i*n + j];
+          b[i][j] = (i == j)? V(1) : V(0);
+        }
+      }
+
+      for (std::size_t col = 0; col < n; ++col) {
+        std::size_t pivot = col;
+        for (std::size_t i = col + 1; i < n; ++i)
+          if (std::abs(a[i][col]) > std::abs(a[pivot][col]))
+            pivot = i;
+
+        if (a[pivot][col] == V(0) || !std::isfinite(a[pivot][col]))
+          return std::optional<result_type>();
+
+        if (pivot != col) {
+          std::swap(a[pivot], a[col]);
+          std::swap(b[pivot], b[col]);
+        }
+
+        const V inv = V(1)/a[col][col];
+        for (std::size_t j = 0; j < n; ++j) {
+          a[col][j] *= inv;
+          b[col][j] *= inv;
+        }
+
+        for (std::size_t i = 0; i < n; ++i) {
+          if (i == col || a[i][col] == V(0))
+            continue;
+          const V f = a[i][col];
+          for (std::size_t j = 0; j < n; ++j) {
+            a[i][j] -= f*a[col][j];
+            b[i][j] -= f*b[col][j];
+          }
+        }
+      }
+
+      result_type ret;
+      for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+          ret.data()[i*n + j] = b[i][j];
+      return std::optional<result_type>(ret);
+    }
+
+  }
+
+}
+
+namespace units {
+
+  // * vectors and matrices of quantities of different units
+
+  using _details::hvec;
+  using _details::hmat;
+  using _details::covariance;
+  using _details::jacobian;
+
+  using _details::_heterogeneous::transpose;
+  using _details::_heterogeneous::invert;
+
+}
+
+#endif
@@ -0,0 +1,394 @@
+#ifndef _include_units_histogram_h
+#define _include_units_histogram_h
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <units/details/quantity.h>
+
+namespace units::_details {
+
+  namespace _histogram {
+
+    // * the raw value, in units of Q, of a quantity of compatible unit
+
+    // the conversion factor is a compile-time constant, which is a single
+    // multiplication for floating-point quantities, and nothing if units are the same
+    template <concepts::quantity Q>
+    constexpr auto value_in(const concepts::quantity_compatible<Q> auto x) {
+      using value_type = typename Q::value_type;
+      return static_cast<value_type>(x.template convert<typename Q::unit_type>().get_value());
+    }
+
+    // * bin index of a value already scaled to bins, counting the underflow bin as 0
+
+    // values outside the axis, and nans, fall in the underflow (0) or overflow (n + 1)
+    // bins. the comparisons are made before the conversion to an integer, which would
+    // be undefined for values too large
+    template <class T>
+    constexpr std::size_t clamp_index(const T scaled, const std::size_t n) {
+      if (scaled >= 0 && scaled < T(n))
+        return std::size_t(scaled) + 1;
+      return (scaled < 0)? 0 : n + 1;
+    }
+
+  }
+
+  // - axes
+
+  // an axis splits a range of quantities into n bins, and has two more bins for the
+  // values below and above its range (or nan). the limits of an axis may be given in
+  // any unit compatible with its quantity, and are converted once on construction.
+  // values filled in another compatible unit are converted by a constant factor
+
+  // * uniform axis: bins of equal width
+
+  // the bin is found with a multiplication, and then checked against the edges
+  // enclosing it, so that values rounded into a neighbouring bin are put back into
+  // the bin whose edges enclose them, as for the other axes
+  template <concepts::floating_point_quantity Q>
+  class uniform_axis {
+  public:
+    using quantity_type = Q;
+    using value_type = typename Q::value_type;
+
+  private:
+    std::size_t m_bins;
+    value_type m_lo;
+    value_type m_hi;
+    value_type m_scale;
+
+    value_type edge_value(const std::size_t i) const {
+      return (i == m_bins)? m_hi : m_lo + value_type(i)/m_scale;
+    }
+
+  public:
+    uniform_axis(const std::size_t bins, const concepts::quantity_compatible<Q> auto lo, const concepts::quantity_compatible<Q> auto hi)
+    : m_bins(bins),
+      m_lo(_histogram::value_in<Q>(lo)),
+      m_hi(_histogram::value_in<Q>(hi)),
+      m_scale(value_type(bins)/(m_hi - m_lo)) {}
+
+    std::size_t bins() const {return m_bins;}
+
+    Q edge(const std::size_t i) const {
+      return Q(edge_value(i));
+    }
+
+    std::size_t index(const concepts::quantity_compatible<Q> auto x) const {
+      const auto v = _histogram::value_in<Q>(x);
+      const std::size_t n = m_bins;
+
+      if (!(v >= m_lo))
+        return std::isnan(v)? n + 1 : 0;
+      if (v >= m_hi)
+        return n + 1;
+
+      // the value is within the axis, in the bin i - 1 or in one of its neighbours
+      auto i = std::clamp<std::size_t>(_histogram::clamp_index((v - m_lo)*m_scale, n), 1, n);
+      if (v < edge_value(i - 1))
+        --i;
+      else if (v >= edge_value(i))
+        ++i;
+      return i;
+    }
+  };
+
+  // * logarithmic axis: bins of equal width in the logarithm of the value
+
+  // the limits must be positive. values that are zero or negative underflow. the
+  // edges are stored, so that values rounded into a neighbouring bin by the logarithm
+  // are put back into the bin whose edges enclose them
+  template <concepts::floating_point_quantity Q>
+  class log_axis {
+  public:
+    using quantity_type = Q;
+    using value_type = typename Q::value_type;
+
+  private:
+    std::vector<value_type> m_edges;
+    value_type m_log_lo;
+    value_type m_scale;
+
+  public:
+    log_axis(const std::size_t bins, const concepts::quantity_compatible<Q> auto lo, const concepts::quantity_compatible<Q> auto hi)
+    : m_edges(bins + 1),
+      m_log_lo(std::log(_histogram::value_in<Q>(lo))),
+      m_scale(value_type(bins)/(std::log(_histogram::value_in<Q>(hi)) - m_log_lo)) {
+      m_edges.front() = _histogram::value_in<Q>(lo);
+      m_edges.back() = _histogram::value_in<Q>(hi);
+      for (std::size_t i = 1; i < bins; ++i)
+        m_edges[i] = std::exp(m_log_lo + value_type(i)/m_scale);
+    }
+
+    std::size_t bins() const {return m_edges.size() - 1;}
+
+    Q edge(const std::size_t i) const {
+      return Q(m_edges[i]);
+    }
+
+    std::size_t index(const concepts::quantity_compatible<Q> auto x) const {
+      const auto v = _histogram::value_in<Q>(x);
+      const std::size_t n = bins();
+
+      if (!(v >= m_edges.front()))
+        return std::isnan(v)? n + 1 : 0;
+      if (v >= m_edges.back())
+        return n + 1;
+
+      // the value is within the axis, in the bin i - 1 or in one of its neighbours
+      auto i = std::clamp<std::size_t>(_histogram::clamp_index((std::log(v) - m_log_lo)*m_scale, n), 1, n);
+      if (v < m_edges[i - 1])
+        --i;
+      else if (v >= m_edges[i])
+        ++i;
+      return i;
+    }
+  };
+
+  // * variable axis: bins between arbitrary increasing edges
+
+  // lookups go through a uniform grid over the range of the axis, with a few cells
+  // per bin, each cell holding the first bin it overlaps. finding a bin takes a
+  // multiplication and a search of the edges within the cell, which is a constant
+  // time unless edges are much more clustered than the grid, and a logarithmic
+  // time in the number of edges of the cell otherwise
+  template <concepts::floating_point_quantity Q>
+  class variable_axis {
+  public:
+    using quantity_type = Q;
+    using value_type = typename Q::value_type;
+
+  private:
+    static constexpr std::size_t cells_per_bin = 4;
+
+    std::vector<value_type> m_edges;
+    std::vector<std::uint32_t> m_grid;
+    value_type m_scale;
+
+  public:
+    template <concepts::quantity_compatible<Q> E>
+    variable_axis(const std::initializer_list<E> edges)
+    : variable_axis(std::vector<E>(edges)) {}
+
+    // the edges must be increasing, and there must be at least two of them
+    template <std::ranges::input_range R>
+    requires concepts::quantity_compatible<Q, std::ranges::range_value_t<R>>
+    explicit variable_axis(const R& edges) {
+      for (const auto& e : edges)
+        m_edges.push_back(_histogram::value_in<Q>(e));
+
+      const std::size_t n = bins();
+      const std::size_t cells = cells_per_bin*n;
+      m_scale = value_type(cells)/(m_edges.back() - m_edges.front());
+      m_grid.resize(cells + 1);
+
+      std::size_t bin = 0;
+      for (std::size_t c = 0; c <= cells; ++c) {
+        const value_type start = m_edges.front() + value_type(c)/m_scale;
+        while (bin + 1 < n && m_edges[bin + 1] <= start)
+          ++bin;
+        m_grid[c] = std::uint32_t(bin);
+      }
+    }
+
+    std::size_t bins() const {return m_edges.size() - 1;}
+
+    Q edge(const std::size_t i) const {
+      return Q(m_edges[i]);
+    }
+
+    std::size_t index(const concepts::quantity_compatible<Q> auto x) const {
+      const auto v = _histogram::value_in<Q>(x);
+      const std::size_t n = bins();
+
+      const auto cell = _histogram::clamp_index((v - m_edges.front())*m_scale, m_grid.size() - 1);
+      if (cell == 0)
+        return 0;
+      if (cell > m_grid.size() - 1)
+        return (v >= m_edges.back() || std::isnan(v))? n + 1 : n;
+
+      // the bins overlapping the cell are searched by bisection, which keeps lookups
+      // fast where many edges are clustered in a few cells. the result is a hint:
+      // rounding may place a value next to an edge in a neighbouring cell, so the
+      // scan that follows goes both ways
+      const std::size_t first = m_grid[cell - 1];
+      const std::size_t last = std::min<std::size_t>(m_grid[cell] + 1, n);
+      std::size_t bin = std::size_t(std::upper_bound(m_edges.begin() + first + 1, m_edges.begin() + last, v) - m_edges.begin()) - 1;
+      while (bin > 0 && v < m_edges[bin])
+        --bin;
+      while (bin + 1 < n && v >= m_edges[bin + 1])
+        ++bin;
+      return (v < m_edges.back())? bin + 1 : n + 1;
+    }
+  };
+
+  // * axis types
+
+  namespace traits {
+    template <class T>
+    struct is_axis : std::false_type {};
+
+    template <class Q>
+    struct is_axis<uniform_axis<Q>> : std::true_type {};
+
+    template <class Q>
+    struct is_axis<log_axis<Q>> : std::true_type {};
+
+    template <class Q>
+    struct is_axis<variable_axis<Q>> : std::true_type {};
+
+    template <class T>
+    constexpr inline bool is_axis_v = is_axis<T>::value;
+  }
+
+  namespace concepts {
+    template <class T>
+    concept axis = traits::is_axis_v<T>;
+  }
+
+  // - histogram
+
+  // counts of the values filled in each bin of one or more axes, including the
+  // underflow and overflow bins. filling requires one quantity per axis, each of a
+  // unit compatible with the unit of its axis: filling a time into an energy axis
+  // does not compile
+
+  template <concepts::axis... Axes>
+  requires (sizeof...(Axes) > 0)
+  class histogram {
+  public:
+    using count_type = std::uint64_t;
+    static constexpr std::size_t rank = sizeof...(Axes);
+
+  private:
+    std::tuple<Axes...> m_axes;
+    std::array<std::size_t, rank> m_strides;
+    std::vector<count_type> m_counts;
+
+    // index of the bin of the given quantities in the flattened counts
+    template <std::size_t... I>
+    std::size_t flat_index(std::index_sequence<I...>, const auto&... xs) const {
+      return ((std::get<I>(m_axes).index(xs) * m_strides[I]) + ...);
+    }
+
+  public:
+    explicit histogram(const Axes&... axes) : m_axes(axes...) {
+      std::size_t stride = 1;
+      std::size_t i = 0;
+      ((m_strides[i++] = stride, stride *= axes.bins() + 2), ...);
+      m_counts.assign(stride, 0);
+    }
+
+    // * axes and counts
+
+    template <std::size_t I>
+    const auto& axis() const {
+      return std::get<I>(m_axes);
+    }
+
+    // counts, indexed by bin, where 0 is the underflow bin and bins() + 1 the overflow
+    count_type at(const std::convertible_to<std::size_t> auto... bins) const
+    requires (sizeof...(bins) == rank) {
+      std::size_t i = 0, flat = 0;
+      ((flat += std::size_t(bins) * m_strides[i++]), ...);
+      return m_counts[flat];
+    }
+
+    // all counts, the first axis varying fastest
+    const std::vector<count_type>& counts() const {
+      return m_counts;
+    }
+
+    count_type entries() const {
+      count_type sum = 0;
+      for (const auto c : m_counts)
+        sum += c;
+      return sum;
+    }
+
+    void reset() {
+      std::fill(m_counts.begin(), m_counts.end(), 0);
+    }
+
+    // * filling, from a single thread
+
+    template <class... Xs>
+    requires (sizeof...(Xs) == rank && (concepts::quantity_compatible<typename Axes::quantity_type, Xs> && ...))
+    void fill(const Xs... xs) {
+      ++m_counts[flat_index(std::index_sequence_for<Axes...>(), xs...)];
+    }
+
+    // * filling from many threads
+
+    // each thread fills a buffer of its own, holding a copy of the axes and counts of
+    // its own, without any synchronization. flushing a buffer adds its counts to the
+    // histogram with atomic additions, so buffers of many threads can be flushed
+    // concurrently, and is done when the buffer is destroyed. counts of the histogram
+    // must not be read while buffers are being flushed, which is why buffers are made
+    // from the axes of the histogram alone
+    class buffer {
+      histogram* m_target;
+      histogram m_local;
+
+    public:
+      explicit buffer(histogram& target)
+      : m_target(&target), m_local(std::make_from_tuple<histogram>(target.m_axes)) {}
+
+      buffer(const buffer&) = delete;
+      buffer& operator=(const buffer&) = delete;
+
+      ~buffer() {
+        flush();
+      }
+
+      template <class... Xs>
+      requires (sizeof...(Xs) == rank && (concepts::quantity_compatible<typename Axes::quantity_type, Xs> && ...))
+      void fill(const Xs... xs) {
+        m_local.fill(xs...);
+      }
+
+      // only bins that were filled since the last flush are touched in the histogram
+      void flush() {
+        auto& local = m_local.m_counts;
+        auto& target = m_target->m_counts;
+
+        for (std::size_t i = 0; i < local.size(); ++i) {
+          if (local[i] != 0) {
+            std::atomic_ref<count_type>(target[i]).fetch_add(local[i], std::memory_order_relaxed);
+            local[i] = 0;
+          }
+        }
+      }
+    };
+
+    buffer make_buffer() {
+      return buffer(*this);
+    }
+  };
+
+}
+
+namespace units {
+
+  // * histograms of quantities
+
+  using _details::uniform_axis;
+  using _details::log_axis;
+  using _details::variable_axis;
+  using _details::histogram;
+
+}
+
+#endif
@@ -0,0 +1,426 @@
+#ifndef _include_units_interpolation_h
+#define _include_units_interpolation_h
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <units/details/kernels.h>
+#include <units/details/quantity.h>
+#include <units/details/simd.h>
+#include <units/histogram.h>
+#include <units/math.h>
+
+namespace units::_details {
+
+  // - interpolation policies
+
+  // * linear: straight lines between the nodes
+  // * cubic: natural cubic spline through the nodes, with continuous first and
+  // * second derivatives
+  namespace interpolation {
+    struct linear {};
+    struct cubic {};
+  }
+
+  namespace traits {
+    template <class T>
+    struct is_interpolation_policy : std::false_type {};
+
+    template <>
+    struct is_interpolation_policy<interpolation::linear> : std::true_type {};
+
+    template <>
+    struct is_interpolation_policy<interpolation::cubic> : std::true_type {};
+
+    template <class T>
+    constexpr inline bool is_interpolation_policy_v = is_interpolation_policy<T>::value;
+  }
+
+  namespace concepts {
+    template <class T>
+    concept interpolation_policy = traits::is_interpolation_policy_v<T>;
+  }
+
+  namespace _interpolation {
+
+    // * the cell holding a key, and the position of the key within it, from 0 to 1
+    template <class T>
+    struct cell {
+      std::size_t index;
+      T fraction;
+    };
+
+    // * cell of a coordinate s, measured in cells from the first node
+
+    // keys outside the grid are clamped to its ends, and nans give a nan fraction.
+    // only comparisons, which are vectorized, are involved
+    template <class T>
+    constexpr cell<T> clamp_cell(const T s, const std::size_t cells) {
+      const T c = std::clamp(s, T(0), T(cells));
+      const std::size_t i = (c < T(cells))? std::size_t(c) : cells - 1;
+      return {i, c - T(i)};
+    }
+
+    // * logarithm of a key, the same in scalar and in batch lookups
+    template <class T>
+    T log(const T x) {
+      return _kernel::log::fast(x)? _kernel::log::lane(x) : _kernel::log::exact(x);
+    }
+
+  }
+
+  // - grids
+
+  // a grid holds the keys of the nodes of a table. keys may be given in any unit
+  // compatible with the key type of the grid, and are converted once on construction.
+  // each grid measures keys in a coordinate of its own, in which tables interpolate:
+  // the key for uniform and irregular grids, and its logarithm for logarithmic grids
+
+  // * uniform grid: nodes equally spaced between two keys
+
+  template <concepts::floating_point_quantity K>
+  class uniform_grid {
+  public:
+    using key_type = K;
+    using value_type = typename K::value_type;
+
+  private:
+    std::size_t m_cells;
+    value_type m_lo;
+    value_type m_hi;
+    value_type m_scale;
+
+  public:
+    // there must be at least two nodes
+    uniform_grid(const std::size_t nodes, const concepts::quantity_compatible<K> auto lo, const concepts::quantity_compatible<K> auto hi)
+    : m_cells(nodes - 1),
+      m_lo(_histogram::value_in<K>(lo)),
+      m_hi(_histogram::value_in<K>(hi)),
+      m_scale(value_type(m_cells)/(m_hi - m_lo)) {}
+
+    std::size_t size() const {return m_cells + 1;}
+
+    K node(const std::size_t i) const {
+      return K((i == m_cells)? m_hi : m_lo + value_type(i)/m_scale);
+    }
+
+    // spacing of the nodes, in the coordinate of the grid (here, in cells)
+    value_type spacing(const std::size_t) const {return 1;}
+
+    _interpolation::cell<value_type> locate(const value_type v) const {
+      return _interpolation::clamp_cell((v - m_lo)*m_scale, m_cells);
+    }
+
+    template <std::size_t W>
+    void locate(const value_type (&v)[W], std::size_t (&index)[W], value_type (&fraction)[W]) const {
+      for (std::size_t j = 0; j < W; ++j) {
+        const auto c = locate(v[j]);
+        index[j] = c.index;
+        fraction[j] = c.fraction;
+      }
+    }
+  };
+
+  // * logarithmic grid: nodes equally spaced in the logarithm of the key
+
+  // the keys of the nodes must be positive. interpolation is linear or cubic in the
+  // logarithm of the key, and zero or negative keys are clamped to the first node
+  template <concepts::floating_point_quantity K>
+  class log_grid {
+  public:
+    using key_type = K;
+    using value_type = typename K::value_type;
+
+  private:
+    std::size_t m_cells;
+    value_type m_lo;
+    value_type m_hi;
+    value_type m_log_lo;
+    value_type m_scale;
+
+  public:
+    // there must be at least two nodes
+    log_grid(const std::size_t nodes, const concepts::quantity_compatible<K> auto lo, const concepts::quantity_compatible<K> auto hi)
+    : m_cells(nodes - 1),
+      m_lo(_histogram::value_in<K>(lo)),
+      m_hi(_histogram::value_in<K>(hi)),
+      m_log_lo(_interpolation::log(m_lo)),
+      m_scale(value_type(m_cells)/(_interpolation::log(m_hi) - m_log_lo)) {}
+
+    std::size_t size() const {return m_cells + 1;}
+
+    K node(const std::size_t i) const {
+      if (i == 0)
+        return K(m_lo);
+      return K((i == m_cells)? m_hi : std::exp(m_log_lo + value_type(i)/m_scale));
+    }
+
+    value_type spacing(const std::size_t) const {return 1;}
+
+    _interpolation::cell<value_type> locate(const value_type v) const {
+      // the clamp sends the nan of a negative key to the last cell, so they are
+      // sent to the first one here
+      if (!(v > 0))
+        return {0, std::isnan(v)? v : 0};
+      return _interpolation::clamp_cell((_interpolation::log(v) - m_log_lo)*m_scale, m_cells);
+    }
+
+    // logarithms are computed in vector registers, and keys out of the range of the
+    // vectorized logarithm are then located one by one
+    template <std::size_t W>
+    void locate(const value_type (&v)[W], std::size_t (&index)[W], value_type (&fraction)[W]) const {
+      value_type s[W];
+      for (std::size_t j = 0; j < W; ++j)
+        s[j] = _kernel::log::lane(v[j]);
+
+      for (std::size_t j = 0; j < W; ++j) {
+        const auto c = _interpolation::clamp_cell((s[j] - m_log_lo)*m_scale, m_cells);
+        index[j] = c.index;
+        fraction[j] = c.fraction;
+      }
+
+      _kernel::refine(W,
+        [&](const std::size_t j) {return _kernel::log::fast(v[j]);},
+        [&](const std::size_t j) {
+          const auto c = locate(v[j]);
+          index[j] = c.index;
+          fraction[j] = c.fraction;
+        });
+    }
+  };
+
+  // * irregular grid: nodes at arbitrary increasing keys
+
+  // cells are found through the lookup grid of a variable_axis, which takes a
+  // constant time unless nodes are much more clustered than elsewhere
+  template <concepts::floating_point_quantity K>
+  class irregular_grid {
+  public:
+    using key_type = K;
+    using value_type = typename K::value_type;
+
+  private:
+    variable_axis<K> m_axis;
+
+  public:
+    template <concepts::quantity_compatible<K> E>
+    irregular_grid(const std::initializer_list<E> nodes)
+    : m_axis(nodes) {}
+
+    // the nodes must be increasing, and there must be at least two of them
+    template <std::ranges::input_range R>
+    requires concepts::quantity_compatible<K, std::ranges::range_value_t<R>>
+    explicit irregular_grid(const R& nodes)
+    : m_axis(nodes) {}
+
+    std::size_t size() const {return m_axis.bins() + 1;}
+
+    K node(const std::size_t i) const {
+      return m_axis.edge(i);
+    }
+
+    value_type spacing(const std::size_t i) const {
+      return (m_axis.edge(i + 1) - m_axis.edge(i)).get_value();
+    }
+
+    _interpolation::cell<value_type> locate(const value_type v) const {
+      const std::size_t cells = m_axis.bins();
+      const std::size_t i = std::clamp<std::size_t>(m_axis.index(K(v)), 1, cells) - 1;
+      const value_type lo = m_axis.edge(i).get_value();
+      const value_type hi = m_axis.edge(i + 1).get_value();
+      return {i, std::clamp((v - lo)/(hi - lo), value_type(0), value_type(1))};
+    }
+
+    template <std::size_t W>
+    void locate(const value_type (&v)[W], std::size_t (&index)[W], value_type (&fraction)[W]) const {
+      for (std::size_t j = 0; j < W; ++j) {
+        const auto c = locate(v[j]);
+        index[j] = c.index;
+        fraction[j] = c.fraction;
+      }
+    }
+  };
+
+  namespace traits {
+    template <class T>
+    struct is_grid : std::false_type {};
+
+    template <class K>
+    struct is_grid<uniform_grid<K>> : std::true_type {};
+
+    template <class K>
+    struct is_grid<log_grid<K>> : std::true_type {};
+
+    template <class K>
+    struct is_grid<irregular_grid<K>> : std::true_type {};
+
+    template <class T>
+    constexpr inline bool is_grid_v = is_grid<T>::value;
+  }
+
+  namespace concepts {
+    template <class T>
+    concept grid = traits::is_grid_v<T>;
+  }
+
+  // - interpolation tables
+
+  // a table of values of type Y at the nodes of a grid. values may be given in any
+  // unit compatible with Y, and are converted once on construction, along with the
+  // coefficients of the polynomial interpolating each cell. a lookup locates the
+  // cell of the key, in constant time for uniform and logarithmic grids, and
+  // evaluates the polynomial of the cell, whose coefficients are adjacent in memory
+
+  template <concepts::grid G, concepts::floating_point_quantity Y, concepts::interpolation_policy P = interpolation::linear>
+  class table {
+  public:
+    using grid_type = G;
+    using key_type = typename G::key_type;
+    using quantity_type = Y;
+    using value_type = typename Y::value_type;
+
+  private:
+    using key_value_type = typename key_type::value_type;
+
+    static constexpr std::size_t order = std::is_same_v<P, interpolation::cubic>? 4 : 2;
+
+    // coefficients of the polynomial of a cell, in powers of the fraction
+    struct alignas(order*sizeof(value_type)) polynomial {
+      value_type c[order];
+    };
+
+    G m_grid;
+    std::vector<polynomial> m_cells;
+
+    value_type evaluate(const std::size_t i, const value_type t) const {
+      const auto& p = m_cells[i].c;
+      if constexpr (order == 2)
+        return p[0] + t*p[1];
+      else
+        return p[0] + t*(p[1] + t*(p[2] + t*p[3]));
+    }
+
+  public:
+    // * constructors
+
+    // there must be one value per node of the grid, otherwise std::invalid_argument
+    // is thrown
+    template <std::ranges::input_range R>
+    requires concepts::quantity_compatible<Y, std::ranges::range_value_t<R>>
+    table(const G& grid, const R& values)
+    : m_grid(grid), m_cells(grid.size() - 1) {
+      std::vector<value_type> y;
+      for (const auto& v : values)
+        y.push_back(_histogram::value_in<Y>(v));
+
+      const std::size_t n = y.size();
+      if (n != m_grid.size())
+        throw std::invalid_argument("interpolation table needs one value per node of its grid");
+
+      if constexpr (order == 2) {
+        for (std::size_t i = 0; i + 1 < n; ++i)
+          m_cells[i] = {{y[i], y[i + 1] - y[i]}};
+      } else {
+        // second derivatives m of the natural spline, with m[0] = m[n - 1] = 0, from
+        // the tridiagonal system solved by the thomas algorithm
+        std::vector<value_type> h(n - 1), m(n, 0), c(n, 0);
+        for (std::size_t i = 0; i + 1 < n; ++i)
+          h[i] = value_type(grid.spacing(i));
+
+        for (std::size_t i = 1; i + 1 < n; ++i) {
+          const value_type rhs = 6*((y[i + 1] - y[i])/h[i] - (y[i] - y[i - 1])/h[i - 1]);
+          const value_type diag = 2*(h[i - 1] + h[i]) - h[i - 1]*c[i - 1];
+          c[i] = h[i]/diag;
+          m[i] = (rhs - h[i - 1]*m[i - 1])/diag;
+        }
+
+        for (std::size_t i = n - 2; i > 0; --i)
+          m[i] -= c[i]*m[i + 1];
+
+        for (std::size_t i = 0; i + 1 < n; ++i) {
+          const value_type hh = h[i]*h[i];
+          m_cells[i] = {{
+            y[i],
+            (y[i + 1] - y[i]) - hh*(2*m[i] + m[i + 1])/6,
+            hh*m[i]/2,
+            hh*(m[i + 1] - m[i])/6}};
+        }
+      }
+    }
+
+    template <concepts::quantity_compatible<Y> E>
+    table(const G& grid, const std::initializer_list<E> values)
+    : table(grid, std::vector<E>(values)) {}
+
+    const G& grid() const {return m_grid;}
+
+    std::size_t size() const {return m_grid.size();}
+
+    // * lookup of a single key, in any compatible unit
+    Y operator()(const concepts::quantity_compatible<key_type> auto x) const {
+      const auto c = m_grid.locate(_histogram::value_in<key_type>(x));
+      return Y(evaluate(c.index, value_type(c.fraction)));
+    }
+
+    // * lookup of a contiguous range of keys
+
+    // results are written into a contiguous range of Y. as for the batch math
+    // functions, min(in.size(), out.size()) keys are looked up, and the span of
+    // written results is returned. keys are located in blocks, which is vectorized
+    // for uniform and logarithmic grids, and the results are the same as those of
+    // single lookups
+    template <_math::_batch::input In, _math::_batch::output<Y> Out>
+    requires concepts::quantity_compatible<key_type, _math::_batch::element_t<In>>
+    auto operator()(const In& in, Out&& out) const {
+      constexpr std::size_t width = 4*_simd::lanes<key_value_type>;
+
+      const auto n = std::min<std::size_t>(std::ranges::size(in), std::ranges::size(out));
+      const auto x = std::ranges::data(in);
+      const auto y = std::ranges::data(out);
+
+      key_value_type v[width];
+      std::size_t index[width];
+      key_value_type fraction[width];
+
+      for (std::size_t i = 0; i < n; i += width) {
+        // unused lanes of a partial block repeat its first element
+        const std::size_t m = std::min(width, n - i);
+        for (std::size_t j = 0; j < width; ++j)
+          v[j] = _histogram::value_in<key_type>(x[i + (j < m? j : 0)]);
+
+        m_grid.locate(v, index, fraction);
+
+        for (std::size_t j = 0; j < m; ++j)
+          y[i + j] = Y(evaluate(index[j], value_type(fraction[j])));
+      }
+
+      return std::span(y, n);
+    }
+  };
+
+}
+
+namespace units {
+
+  // * interpolation policies
+
+  namespace interpolation = _details::interpolation;
+
+  // * interpolation tables keyed by quantities
+
+  using _details::uniform_grid;
+  using _details::log_grid;
+  using _details::irregular_grid;
+  using _details::table;
+
+}
+
+#endif
@@ -0,0 +1,734 @@
+#ifndef _include_units_linalg_h
+#define _include_units_linalg_h
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <units/details/kernels.h>
+#include <units/details/quantity.h>
+#include <units/details/unit.h>
+#include <units/math.h>
+
+namespace units::_details {
+
+  template <std::size_t N, concepts::quantity Q>
+  requires (N > 0)
+  class vec;
+
+  template <std::size_t R, std::size_t C, concepts::quantity Q>
+  requires (R > 0 && C > 0)
+  class mat;
+
+  namespace _linalg {
+
+    // * alignment of n values of type V: the smallest power of two holding all of
+    // * them, up to 16 bytes
+
+    // the limit is fixed rather than the width of the vector registers, which depends
+    // on compiler flags: the layout of a vec is then the same in every translation
+    // unit and library, whether or not they are built with AVX. a vec<3, double> is
+    // aligned to 16 bytes, with 8 bytes of padding, and loaded by two instructions
+    constexpr inline std::size_t max_alignment = 16;
+
+    template <class V, std::size_t N>
+    constexpr inline std::size_t alignment = std::max(std::min(std::bit_ceil(N*sizeof(V)), max_alignment), alignof(V));
+
+    // * types of the results of operations between elements
+
+    // dimensionless results of divisions, which are plain numbers, are kept as
+    // quantities of make_unit<> so that they can be elements of a vec
+    template <class T>
+    struct as_quantity {using type = T;};
+
+    template <concepts::arithmetic T>
+    struct as_quantity<T> {using type = quantity<make_unit<>, T>;};
+
+    template <class Qa, class Qb>
+    using sum_t = decltype(std::declval<Qa>() + std::declval<Qb>());
+
+    template <class Qa, class Qb>
+    using product_t = typename as_quantity<decltype(std::declval<Qa>() * std::declval<Qb>())>::type;
+
+    template <class Qa, class Qb>
+    using quotient_t = typename as_quantity<decltype(std::declval<Qa>() / std::declval<Qb>())>::type;
+
+    template <class Q>
+    using norm_t = decltype(_math::hypot(std::declval<Q>(), std::declval<Q>()));
+
+  }
+
+  // - vectors of quantities
+
+  // a vec holds n quantities of the same type, packed and aligned as described above.
+  // operations between vectors accept quantities of compatible units, and give the
+  // units of their results just as the operations between single quantities do:
+  // the sum of vectors of meters and kilometers is in meters, and the product of
+  // a vector of newtons by a length is in newton-meters
+
+  template <std::size_t N, concepts::quantity Q>
+  requires (N > 0)
+  class vec {
+  public:
+    using quantity_type = Q;
+    using unit_type = typename Q::unit_type;
+    using value_type = typename Q::value_type;
+
+    static constexpr std::size_t extent = N;
+
+  private:
+    alignas(_linalg::alignment<value_type, N>) Q m_data[N];
+
+  public:
+    // * constructors
+
+    // all elements are zero
+    constexpr vec() = default;
+
+    // from n quantities of compatible units, converted to Q
+    template <class... Qs>
+    requires (sizeof...(Qs) == N && (concepts::quantity_compatible<Q, Qs> && ...))
+    constexpr vec(const Qs... xs) : m_data{Q(xs)...} {}
+
+    // from a vector of compatible unit
+    template <concepts::quantity_compatible<Q> Qb>
+    explicit constexpr vec(const vec<N, Qb>& other) {
+      for (std::size_t i = 0; i < N; ++i)
+        m_data[i] = Q(other[i]);
+    }
+
+    // * access to the elements
+
+    constexpr Q& operator[](const std::size_t i) {return m_data[i];}
+    constexpr const Q& operator[](const std::size_t i) const {return m_data[i];}
+
+    static constexpr std::size_t size() {return N;}
+
+    constexpr Q* data() {return m_data;}
+    constexpr const Q* data() const {return m_data;}
+
+    constexpr Q* begin() {return m_data;}
+    constexpr const Q* begin() const {return m_data;}
+
+    constexpr Q* end() {return m_data + N;}
+    constexpr const Q* end() const {return m_data + N;}
+
+    // * assignment operations
+
+    template <concepts::quantity_compatible<Q> Qb>
+    constexpr vec& operator+=(const vec<N, Qb>& other) {
+      for (std::size_t i = 0; i < N; ++i)
+        m_data[i] = Q(m_data[i] + other[i]);
+      return *this;
+    }
+
+    template <concepts::quantity_compatible<Q> Qb>
+    constexpr vec& operator-=(const vec<N, Qb>& other) {
+      for (std::size_t i = 0; i < N; ++i)
+        m_data[i] = Q(m_data[i] - other[i]);
+      return *this;
+    }
+
+    constexpr vec& operator*=(const std::convertible_to<value_type> auto& x) {
+      for (std::size_t i = 0; i < N; ++i)
+        m_data[i] *= x;
+      return *this;
+    }
+
+    constexpr vec& operator/=(const std::convertible_to<value_type> auto& x) {
+      for (std::size_t i = 0; i < N; ++i)
+        m_data[i] /= x;
+      return *this;
+    }
+
+    // * unary operators
+
+    constexpr vec operator+() const {
+      return *this;
+    }
+
+    constexpr vec operator-() const {
+      vec ret;
+      for (std::size_t i = 0; i < N; ++i)
+        ret[i] = -m_data[i];
+      return ret;
+    }
+
+    // * comparison
+
+    template <concepts::quantity_compatible<Q> Qb>
+    constexpr bool operator==(const vec<N, Qb>& other) const {
+      for (std::size_t i = 0; i < N; ++i)
+        if (m_data[i] != other[i])
+          return false;
+      return true;
+    }
+  };
+
+  namespace traits {
+    template <class T>
+    struct is_vec : std::false_type {};
+
+    template <std::size_t N, class Q>
+    struct is_vec<vec<N, Q>> : std::true_type {};
+
+    template <class T>
+    constexpr inline bool is_vec_v = is_vec<T>::value;
+  }
+
+  namespace concepts {
+    template <class T>
+    concept vec = traits::is_vec_v<T>;
+  }
+
+  // * element-wise arithmetic
+
+  template <std::size_t N, class Qa, concepts::quantity_compatible<Qa> Qb>
+  constexpr auto operator+(const vec<N, Qa>& a, const vec<N, Qb>& b) {
+    vec<N, _linalg::sum_t<Qa, Qb>> ret;
+    for (std::size_t i = 0; i < N; ++i)
+      ret[i] = a[i] + b[i];
+    return ret;
+  }
+
+  template <std::size_t N, class Qa, concepts::quantity_compatible<Qa> Qb>
+  constexpr auto operator-(const vec<N, Qa>& a, const vec<N, Qb>& b) {
+    vec<N, _linalg::sum_t<Qa, Qb>> ret;
+    for (std::size_t i = 0; i < N; ++i)
+      ret[i] = a[i] - b[i];
+    return ret;
+  }
+
+  // * product and division by a number or by a quantity
+
+  template <std::size_t N, class Q, class S>
+  requires concepts::arithmetic<S> || concepts::quantity<S>
+  constexpr auto operator*(const vec<N, Q>& v, const S s) {
+    vec<N, _linalg::product_t<Q, S>> ret;
+    for (std::size_t i = 0; i < N; ++i)
+      ret[i] = v[i] * s;
+    return ret;
+  }
+
+  template <std::size_t N, class Q, class S>
+  requires concepts::arithmetic<S> || concepts::quantity<S>
+  constexpr auto operator*(const S s, const vec<N, Q>& v) {
+    vec<N, _linalg::product_t<S, Q>> ret;
+    for (std::size_t i = 0; i < N; ++i)
+      ret[i] = s * v[i];
+    return ret;
+  }
+
+  template <std::size_t N, class Q, class S>
+  requires concepts::arithmetic<S> || concepts::quantity<S>
+  constexpr auto operator/(const vec<N, Q>& v, const S s) {
+    using R = _linalg::quotient_t<Q, S>;
+    vec<N, R> ret;
+    for (std::size_t i = 0; i < N; ++i)
+      ret[i] = R(v[i] / s);
+    return ret;
+  }
+
+  namespace _linalg {
+
+    // - products of vectors
+
+    // * dot product, in the product of the units of the vectors
+    template <std::size_t N, class Qa, class Qb>
+    constexpr auto dot(const vec<N, Qa>& a, const vec<N, Qb>& b) {
+      auto ret = product_t<Qa, Qb>(a[0] * b[0]);
+      for (std::size_t i = 1; i < N; ++i)
+        ret += a[i] * b[i];
+      return ret;
+    }
+
+    // * cross product of three-dimensional vectors
+    template <class Qa, class Qb>
+    constexpr auto cross(const vec<3, Qa>& a, const vec<3, Qb>& b) {
+      return vec<3, product_t<Qa, Qb>>(
+        a[1]*b[2] - a[2]*b[1],
+        a[2]*b[0] - a[0]*b[2],
+        a[0]*b[1] - a[1]*b[0]);
+    }
+
+    // - euclidean norm
+
+    // computed with math::hypot, which neither overflows nor underflows when the
+    // squares of the elements would
+    template <std::size_t N, class Q>
+    auto norm(const vec<N, Q>& v) {
+      if constexpr (N == 1)
+        return _math::hypot(v[0], Q(0));
+      else if constexpr (N == 2)
+        return _math::hypot(v[0], v[1]);
+      else if constexpr (N == 3)
+        return _math::hypot(v[0], v[1], v[2]);
+      else {
+        auto ret = _math::hypot(v[0], v[1], v[2]);
+        for (std::size_t i = 3; i < N; ++i)
+          ret = _math::hypot(ret, v[i]);
+        return ret;
+      }
+    }
+
+    // * square of the norm, exact for integral quantities
+    template <std::size_t N, class Q>
+    constexpr auto squared_norm(const vec<N, Q>& v) {
+      return dot(v, v);
+    }
+
+    // * vector of unit length along v, whose elements are dimensionless
+    template <std::size_t N, class Q>
+    auto normalize(const vec<N, Q>& v) {
+      return v / norm(v);
+    }
+
+  }
+
+  // - matrices of quantities
+
+  // an r x c matrix is stored as r rows, each a vec of c quantities, so that each
+  // row is aligned as a vec is
+
+  template <std::size_t R, std::size_t C, concepts::quantity Q>
+  requires (R > 0 && C > 0)
+  class mat {
+  public:
+    using quantity_type = Q;
+    using unit_type = typename Q::unit_type;
+    using value_type = typename Q::value_type;
+    using row_type = vec<C, Q>;
+
+    static constexpr std::size_t rows = R;
+    static constexpr std::size_t columns = C;
+
+  private:
+    row_type m_rows[R];
+
+  public:
+    // * constructors
+
+    // all elements are zero
+    constexpr mat() = default;
+
+    // from r rows of compatible units
+    template <class... Qs>
+    requires (sizeof...(Qs) == R && (concepts::quantity_compatible<Q, Qs> && ...))
+    constexpr mat(const vec<C, Qs>&... rs) : m_rows{row_type(rs)...} {}
+
+    // the identity matrix, for dimensionless quantities
+    static constexpr mat identity()
+    requires (R == C && concepts::dimensionless_quantity<Q>) {
+      mat ret;
+      for (std::size_t i = 0; i < R; ++i)
+        ret(i, i) = Q(1);
+      return ret;
+    }
+
+    // * access to the elements
+
+    constexpr row_type& operator[](const std::size_t i) {return m_rows[i];}
+    constexpr const row_type& operator[](const std::size_t i) const {return m_rows[i];}
+
+    constexpr Q& operator()(const std::size_t i, const std::size_t j) {return m_rows[i][j];}
+    constexpr const Q& operator()(const std::size_t i, const std::size_t j) const {return m_rows[i][j];}
+
+    constexpr vec<R, Q> column(const std::size_t j) const {
+      vec<R, Q> ret;
+      for (std::size_t i = 0; i < R; ++i)
+        ret[i] = m_rows[i][j];
+      return ret;
+    }
+
+    // * assignment operations
+
+    template <concepts::quantity_compatible<Q> Qb>
+    constexpr mat& operator+=(const mat<R, C, Qb>& other) {
+      for (std::size_t i = 0; i < R; ++i)
+        m_rows[i] += other[i];
+      return *this;
+    }
+
+    template <concepts::quantity_compatible<Q> Qb>
+    constexpr mat& operator-=(const mat<R, C, Qb>& other) {
+      for (std::size_t i = 0; i < R; ++i)
+        m_rows[i] -= other[i];
+      return *this;
+    }
+
+    constexpr mat& operator*=(const std::convertible_to<value_type> auto& x) {
+      for (std::size_t i = 0; i < R; ++i)
+        m_rows[i] *= x;
+      return *this;
+    }
+
+    constexpr mat& operator/=(const std::convertible_to<value_type> auto& x) {
+      for (std::size_t i = 0; i < R; ++i)
+        m_rows[i] /= x;
+      return *this;
+    }
+
+    // * unary operators
+
+    constexpr mat operator+() const {
+      return *this;
+    }
+
+    constexpr mat operator-() const {
+      mat ret;
+      for (std::size_t i = 0; i < R; ++i)
+        ret[i] = -m_rows[i];
+      return ret;
+    }
+
+    // * comparison
+
+    template <concepts::quantity_compatible<Q> Qb>
+    constexpr bool operator==(const mat<R, C, Qb>& other) const {
+      for (std::size_t i = 0; i < R; ++i)
+        if (!(m_rows[i] == other[i]))
+          return false;
+      return true;
+    }
+  };
+
+  // * element-wise arithmetic
+
+  template <std::size_t R, std::size_t C, class Qa, concepts::quantity_compatible<Qa> Qb>
+  constexpr auto operator+(const mat<R, C, Qa>& a, const mat<R, C, Qb>& b) {
+    mat<R, C, _linalg::sum_t<Qa, Qb>> ret;
+    for (std::size_t i = 0; i < R; ++i)
+      ret[i] = a[i] + b[i];
+    return ret;
+  }
+
+  template <std::size_t R, std::size_t C, class Qa, concepts::quantity_compatible<Qa> Qb>
+  constexpr auto operator-(const mat<R, C, Qa>& a, const mat<R, C, Qb>& b) {
+    mat<R, C, _linalg::sum_t<Qa, Qb>> ret;
+    for (std::size_t i = 0; i < R; ++i)
+      ret[i] = a[i] - b[i];
+    return ret;
+  }
+
+  template <std::size_t R, std::size_t C, class Q, class S>
+  requires concepts::arithmetic<S> || concepts::quantity<S>
+  constexpr auto operator*(const mat<R, C, Q>& m, const S s) {
+    mat<R, C, _linalg::product_t<Q, S>> ret;
+    for (std::size_t i = 0; i < R; ++i)
+      ret[i] = m[i] * s;
+    return ret;
+  }
+
+  template <std::size_t R, std::size_t C, class Q, class S>
+  requires concepts::arithmetic<S> || concepts::quantity<S>
+  constexpr auto operator*(const S s, const mat<R, C, Q>& m) {
+    mat<R, C, _linalg::product_t<S, Q>> ret;
+    for (std::size_t i = 0; i < R; ++i)
+      ret[i] = s * m[i];
+    return ret;
+  }
+
+  // * matrix-vector and matrix-matrix products
+
+  // each row of the product is accumulated as a linear combination of the rows (or
+  // elements) of the right operand, which vectorizes along the rows
+  template <std::size_t R, std::size_t C, class Qa, class Qb>
+  constexpr auto operator*(const mat<R, C, Qa>& m, const vec<C, Qb>& v) {
+    vec<R, _linalg::product_t<Qa, Qb>> ret;
+    for (std::size_t i = 0; i < R; ++i)
+      ret[i] = _linalg::dot(m[i], v);
+    return ret;
+  }
+
+  template <std::size_t R, std::size_t K, std::size_t C, class Qa, class Qb>
+  constexpr auto operator*(const mat<R, K, Qa>& a, const mat<K, C, Qb>& b) {
+    mat<R, C, _linalg::product_t<Qa, Qb>> ret;
+    for (std::size_t i = 0; i < R; ++i)
+      for (std::size_t k = 0; k < K; ++k)
+        ret[i] += a(i, k) * b[k];
+    return ret;
+  }
+
+  namespace _linalg {
+
+    template <std::size_t R, std::size_t C, class Q>
+    constexpr auto transpose(const mat<R, C, Q>& m) {
+      mat<C, R, Q> ret;
+      for (std::size_t i = 0; i < R; ++i)
+        for (std::size_t j = 0; j < C; ++j)
+          ret(j, i) = m(i, j);
+      return ret;
+    }
+
+  }
+
+  // - batches of vectors
+
+  // particles and other collections of vectors are stored either as an array of
+  // vectors (aos), a std::vector of vec, or as a structure of arrays (soa), one
+  // contiguous array for each element of the vectors. the soa layout lets batch
+  // operations process as many vectors as fit in a vector register at once
+
+  namespace _linalg {
+
+    // * allocator of memory aligned to a cache line, so that all arrays of a batch
+    // * start at the same offset within their cache lines
+    template <class T>
+    struct aligned_allocator {
+      using value_type = T;
+
+      static constexpr std::align_val_t alignment{std::max<std::size_t>(64, alignof(T))};
+
+      constexpr aligned_allocator() = default;
+
+      template <class U>
+      constexpr aligned_allocator(const aligned_allocator<U>&) {}
+
+      T* allocate(const std::size_t n) {
+        return static_cast<T*>(::operator new(n*sizeof(T), alignment));
+      }
+
+      void deallocate(T* const p, const std::size_t) {
+        ::operator delete(p, alignment);
+      }
+
+      template <class U>
+      constexpr bool operator==(const aligned_allocator<U>&) const {return true;}
+    };
+
+  }
+
+  template <std::size_t N, concepts::quantity Q>
+  requires (N > 0)
+  class vec_soa {
+  public:
+    using quantity_type = Q;
+    using vec_type = vec<N, Q>;
+
+    static constexpr std::size_t extent = N;
+
+  private:
+    std::array<std::vector<Q, _linalg::aligned_allocator<Q>>, N> m_elements;
+
+  public:
+    // * constructors
+
+    vec_soa() = default;
+
+    // n zero vectors
+    explicit vec_soa(const std::size_t n) {
+      resize(n);
+    }
+
+    // * size
+
+    std::size_t size() const {return m_elements[0].size();}
+    bool empty() const {return m_elements[0].empty();}
+
+    void resize(const std::size_t n) {
+      for (auto& e : m_elements)
+        e.resize(n, Q(0));
+    }
+
+    void reserve(const std::size_t n) {
+      for (auto& e : m_elements)
+        e.reserve(n);
+    }
+
+    void clear() {
+      for (auto& e : m_elements)
+        e.clear();
+    }
+
+    // * access to the vectors, which are gathered from the arrays of their elements
+
+    vec_type operator[](const std::size_t i) const {
+      vec_type ret;
+      for (std::size_t j = 0; j < N; ++j)
+        ret[j] = m_elements[j][i];
+      return ret;
+    }
+
+    template <concepts::quantity_compatible<Q> Qb>
+    void set(const std::size_t i, const vec<N, Qb>& v) {
+      for (std::size_t j = 0; j < N; ++j)
+        m_elements[j][i] = v[j];
+    }
+
+    template <concepts::quantity_compatible<Q> Qb>
+    void push_back(const vec<N, Qb>& v) {
+      for (std::size_t j = 0; j < N; ++j)
+        m_elements[j].push_back(Q(v[j]));
+    }
+
+    // * the array of the j-th elements of all vectors
+
+    std::span<Q> elements(const std::size_t j) {return m_elements[j];}
+    std::span<const Q> elements(const std::size_t j) const {return m_elements[j];}
+  };
+
+  template <std::size_t N, concepts::quantity Q>
+  using vec_aos = std::vector<vec<N, Q>>;
+
+  namespace _linalg {
+
+    // * element j of vector i of a batch, in either layout
+
+    template <class B>
+    struct is_soa : std::false_type {};
+
+    template <std::size_t N, class Q>
+    struct is_soa<vec_soa<N, Q>> : std::true_type {};
+
+    template <class B>
+    concept soa_batch = is_soa<B>::value;
+
+    template <class B>
+    concept aos_batch = std::ranges::contiguous_range<B> && concepts::vec<std::ranges::range_value_t<B>>;
+
+    template <class B>
+    concept batch = soa_batch<B> || aos_batch<B>;
+
+    template <class B>
+    struct batch_traits {
+      using vec_type = std::ranges::range_value_t<B>;
+    };
+
+    template <std::size_t N, class Q>
+    struct batch_traits<vec_soa<N, Q>> {
+      using vec_type = vec<N, Q>;
+    };
+
+    template <batch B>
+    using batch_vec_t = typename batch_traits<B>::vec_type;
+
+    template <batch B>
+    std::size_t batch_size(const B& b) {
+      return std::ranges::size(b);
+    }
+
+    // a function returning the value of element j of vector i. for soa batches it
+    // reads from the arrays of elements, hoisted out of the loop
+    template <batch B>
+    auto batch_access(const B& b) {
+      using V = typename batch_vec_t<B>::value_type;
+      constexpr std::size_t N = batch_vec_t<B>::extent;
+
+      if constexpr (soa_batch<B>) {
+        std::array<const V*, N> data;
+        for (std::size_t j = 0; j < N; ++j)
+          data[j] = reinterpret_cast<const V*>(b.elements(j).data());
+        return [data](const std::size_t i, const std::size_t j) {return data[j][i];};
+      } else {
+        const auto data = std::ranges::data(b);
+        return [data](const std::size_t i, const std::size_t j) {return data[i][j].get_value();};
+      }
+    }
+
+    // * kernel of the euclidean norm of n elements, as _kernel::hypot is for two
+    struct norm_kernel {
+      template <class T, class... Ts>
+      static bool fast(const T x, const Ts... xs) {
+        const T s = x*x + ((xs*xs) + ... + T(0));
+        return s >= std::numeric_limits<T>::min()*T(0x1p54) && s <= std::numeric_limits<T>::max();
+      }
+
+      template <class T, class... Ts>
+      static T lane(const T x, const Ts... xs)
+      {return x*x + ((xs*xs) + ... + T(0));}
+
+      template <class T, std::size_t N>
+      static void finish(T (&block)[N])
+      {_kernel::sqrt::finish(block);}
+
+      template <class T, class... Ts>
+      static T exact(const T x, const Ts... xs) {
+        T ret = std::abs(x);
+        ((ret = std::hypot(ret, xs)), ...);
+        return ret;
+      }
+    };
+
+    // - batch operations
+
+    // as the batch math functions, they write into a contiguous range whose elements
+    // have exactly the type returned for a single vector, compute min(in.size(),
+    // out.size()) elements, and return the span of written elements
+
+    // * dot products of the vectors of two batches
+    template <batch Ba, batch Bb, _math::_batch::output<decltype(dot(std::declval<batch_vec_t<Ba>>(), std::declval<batch_vec_t<Bb>>()))> Out>
+    requires (batch_vec_t<Ba>::extent == batch_vec_t<Bb>::extent)
+    auto dot(const Ba& a, const Bb& b, Out&& out) {
+      using R = std::ranges::range_value_t<Out>;
+      using T = typename R::value_type;
+      constexpr std::size_t N = batch_vec_t<Ba>::extent;
+
+      const auto n = std::min({batch_size(a), batch_size(b), std::size_t(std::ranges::size(out))});
+      const auto x = batch_access(a);
+      const auto y = batch_access(b);
+      const auto data = std::ranges::data(out);
+
+      for (std::size_t i = 0; i < n; ++i) {
+        T sum = T(x(i, 0)) * T(y(i, 0));
+        for (std::size_t j = 1; j < N; ++j)
+          sum += T(x(i, j)) * T(y(i, j));
+        data[i] = R(sum);
+      }
+
+      return std::span(data, n);
+    }
+
+    // * norms of the vectors of a batch
+
+    // the squares are summed in vector registers, as by the batch version of
+    // math::hypot, and vectors whose squares overflow or underflow are recomputed
+    // with std::hypot
+    template <batch B, _math::_batch::output<decltype(norm(std::declval<batch_vec_t<B>>()))> Out>
+    auto norm(const B& b, Out&& out) {
+      using R = std::ranges::range_value_t<Out>;
+      using T = typename R::value_type;
+      constexpr std::size_t N = batch_vec_t<B>::extent;
+
+      const auto n = std::min<std::size_t>(batch_size(b), std::ranges::size(out));
+      const auto x = batch_access(b);
+
+      [&]<std::size_t... J>(std::index_sequence<J...>) {
+        _math::_batch::apply<T>(norm_kernel(), n, std::ranges::data(out),
+          [x](const std::size_t i) {return T(x(i, J));}...);
+      }(std::make_index_sequence<N>());
+
+      return std::span(std::ranges::data(out), n);
+    }
+
+  }
+
+}
+
+namespace units {
+
+  // * vectors and matrices of quantities
+
+  using _details::vec;
+  using _details::mat;
+  using _details::vec_soa;
+  using _details::vec_aos;
+
+  using _details::_linalg::dot;
+  using _details::_linalg::cross;
+  using _details::_linalg::norm;
+  using _details::_linalg::squared_norm;
+  using _details::_linalg::normalize;
+  using _details::_linalg::transpose;
+
+}
+
+#endif
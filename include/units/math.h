@@ -6,9 +6,14 @@
 #include <cmath>
 #include <concepts>
 #include <cstdlib>
+#include <ranges>
+#include <span>
 
+#include <units/algorithm.h>
+#include <units/details/kernels.h>
 #include <units/details/power.h>
 #include <units/details/quantity.h>
+#include <units/details/simd.h>
 
 // - MACROS: only visible inside this file (they are undef below)
 
@@ -27,6 +32,25 @@
   auto _fname_(const concepts::quantity auto q)                               \
   {return _fname_(q.get_value());}
 
+#define units_math_pack_function(_fname_)                                     \
+  template <std::floating_point T, std::size_t N>                             \
+  constexpr pack<T, N> _fname_(const pack<T, N>& a)                           \
+  {return apply([](const T x) {return std::_fname_(x);}, a);}
+
+#define units_math_pack_binary_function(_fname_)                              \
+  template <std::floating_point T, std::size_t N>                             \
+  constexpr pack<T, N> _fname_(const pack<T, N>& a, const pack<T, N>& b)      \
+  {return apply([](const T x, const T y) {return std::_fname_(x, y);}, a, b);}
+
+#define units_math_pack_classification(_fname_)                               \
+  template <std::floating_point T, std::size_t N>                             \
+  constexpr mask<N> _fname_(const pack<T, N>& a) {                            \
+    mask<N> ret;                                                              \
+    for (std::size_t j = 0; j < N; ++j)                                       \
+      ret[j] = std::_fname_(a[j]);                                            \
+    return ret;                                                               \
+  }
+
 
 // - import declarations to the units::math namespace
 
@@ -36,10 +60,163 @@ namespace units::math {
   using namespace units::_details::_math;
 }
 
+namespace units {
+  // fixed-width packs of numbers, which quantities may hold as values
+  using _details::_simd::pack;
+}
+
+// - functions of packs
+
+// the functions of <cmath>, element by element, found by argument-dependent lookup
+// as those of std::experimental::simd are: the functions of quantities below, which
+// call them unqualified, are then computed for quantities holding packs. they are
+// also declared in units::math, so that math::f(x) takes packs as it takes numbers;
+// the functions of other packs are only found in the namespace of the pack. sqrt,
+// exp, log and hypot are computed by the kernels of the batch functions, as a block
+// of elements, so that their results are those of the batch functions; the others
+// call <cmath> once per element
+
+namespace units::_details::_simd {
+
+  // * kernel k applied to the elements of packs, as to a block by _batch::apply
+  template <class K, class T, std::size_t N, class... Ps>
+  pack<T, N> evaluate(const K& k, const Ps&... x) {
+    T values[N];
+
+    for (std::size_t j = 0; j < N; ++j)
+      values[j] = k.lane(x[j]...);
+
+    if constexpr (requires {k.finish(values);})
+      k.finish(values);
+
+    _kernel::refine(N,
+      [&](const std::size_t j) {return k.fast(x[j]...);},
+      [&](const std::size_t j) {values[j] = k.exact(x[j]...);});
+
+    pack<T, N> ret;
+    ret.copy_from(values);
+    return ret;
+  }
+
+  template <class T, std::size_t N>
+  constexpr pack<T, N> abs(const pack<T, N>& a)
+  {return apply([](const T x) {return (x < 0)? -x : x;}, a);}
+
+  template <class T, std::size_t N>
+  constexpr pack<T, N> min(const pack<T, N>& a, const pack<T, N>& b)
+  {return apply([](const T x, const T y) {return (y < x)? y : x;}, a, b);}
+
+  template <class T, std::size_t N>
+  constexpr pack<T, N> max(const pack<T, N>& a, const pack<T, N>& b)
+  {return apply([](const T x, const T y) {return (x < y)? y : x;}, a, b);}
+
+  template <std::floating_point T, std::size_t N>
+  pack<T, N> sqrt(const pack<T, N>& a)
+  {return evaluate<_kernel::sqrt, T, N>(_kernel::sqrt(), a);}
+
+  template <std::floating_point T, std::size_t N>
+  pack<T, N> exp(const pack<T, N>& a)
+  {return evaluate<_kernel::exp, T, N>(_kernel::exp(), a);}
+
+  template <std::floating_point T, std::size_t N>
+  pack<T, N> log(const pack<T, N>& a)
+  {return evaluate<_kernel::log, T, N>(_kernel::log(), a);}
+
+  template <std::floating_point T, std::size_t N>
+  pack<T, N> hypot(const pack<T, N>& a, const pack<T, N>& b)
+  {return evaluate<_kernel::hypot, T, N>(_kernel::hypot(), a, b);}
+
+  template <std::floating_point T, std::size_t N>
+  constexpr pack<T, N> hypot(const pack<T, N>& a, const pack<T, N>& b, const pack<T, N>& c)
+  {return pack<T, N>([&](const std::size_t j) {return std::hypot(a[j], b[j], c[j]);});}
+
+  template <std::floating_point T, std::size_t N>
+  constexpr pack<T, N> pow(const pack<T, N>& a, const T y)
+  {return apply([y](const T x) {return std::pow(x, y);}, a);}
+
+  units_math_pack_binary_function(pow)
+  units_math_pack_binary_function(atan2)
+
+  units_math_pack_function(exp2)
+  units_math_pack_function(expm1)
+  units_math_pack_function(log10)
+  units_math_pack_function(log2)
+  units_math_pack_function(log1p)
+  units_math_pack_function(cbrt)
+  units_math_pack_function(sin)
+  units_math_pack_function(cos)
+  units_math_pack_function(tan)
+  units_math_pack_function(asin)
+  units_math_pack_function(acos)
+  units_math_pack_function(atan)
+  units_math_pack_function(sinh)
+  units_math_pack_function(cosh)
+  units_math_pack_function(tanh)
+  units_math_pack_function(asinh)
+  units_math_pack_function(acosh)
+  units_math_pack_function(atanh)
+  units_math_pack_function(erf)
+  units_math_pack_function(erfc)
+  units_math_pack_function(tgamma)
+  units_math_pack_function(lgamma)
+  units_math_pack_function(ceil)
+  units_math_pack_function(floor)
+  units_math_pack_function(trunc)
+  units_math_pack_function(round)
+  units_math_pack_function(nearbyint)
+  units_math_pack_function(rint)
+
+  units_math_pack_classification(isfinite)
+  units_math_pack_classification(isinf)
+  units_math_pack_classification(isnan)
+  units_math_pack_classification(isnormal)
+  units_math_pack_classification(signbit)
+
+}
+
 // - math functions
 
 namespace units::_details::_math {
 
+  // * functions of packs, but the trigonometric ones, which units::math defines for
+  // * angles and, for inverse functions, returns as angles (see angular.h)
+
+  using _simd::abs;
+  using _simd::min;
+  using _simd::max;
+  using _simd::sqrt;
+  using _simd::exp;
+  using _simd::log;
+  using _simd::hypot;
+  using _simd::pow;
+  using _simd::exp2;
+  using _simd::expm1;
+  using _simd::log10;
+  using _simd::log2;
+  using _simd::log1p;
+  using _simd::cbrt;
+  using _simd::sinh;
+  using _simd::cosh;
+  using _simd::tanh;
+  using _simd::asinh;
+  using _simd::acosh;
+  using _simd::atanh;
+  using _simd::erf;
+  using _simd::erfc;
+  using _simd::tgamma;
+  using _simd::lgamma;
+  using _simd::ceil;
+  using _simd::floor;
+  using _simd::trunc;
+  using _simd::round;
+  using _simd::nearbyint;
+  using _simd::rint;
+  using _simd::isfinite;
+  using _simd::isinf;
+  using _simd::isnan;
+  using _simd::isnormal;
+  using _simd::signbit;
+
   // * basic operations
 
   using std::fmod;
@@ -103,15 +280,40 @@ namespace units::_details::_math {
   constexpr auto fma(const concepts::quantity auto a, const concepts::quantity auto b, const concepts::quantity auto c)
   {return (a*b) + c;}
 
-  // min/max value
+  // min/max value. the minimum and maximum of packs are taken element by element
+  constexpr auto min(const concepts::quantity auto a, const concepts::quantity auto b)
+  requires concepts::quantity_compatible<decltype(a), decltype(b)> {
+    if constexpr (concepts::pack_quantity<decltype(a)>)
+      return decltype(a)(min(a.get_value(), decltype(a)(b).get_value()));
+    else
+      return b < a? decltype(a)(b) : a;
+  }
+
   constexpr auto max(const concepts::quantity auto a, const concepts::quantity auto b)
-  requires concepts::quantity_compatible<decltype(a), decltype(b)>
-  {return a >= b? a : decltype(a)(b);}
+  requires concepts::quantity_compatible<decltype(a), decltype(b)> {
+    if constexpr (concepts::pack_quantity<decltype(a)>)
+      return decltype(a)(max(a.get_value(), decltype(a)(b).get_value()));
+    else
+      return a >= b? a : decltype(a)(b);
+  }
+
+  // packs of the same type, which would otherwise be taken by std::min and std::max
+  template <concepts::pack_quantity Q>
+  constexpr Q min(const Q& a, const Q& b)
+  {return Q(min(a.get_value(), b.get_value()));}
+
+  template <concepts::pack_quantity Q>
+  constexpr Q max(const Q& a, const Q& b)
+  {return Q(max(a.get_value(), b.get_value()));}
 
   // fdim
   constexpr auto fdim(const concepts::quantity auto a, const concepts::quantity auto b)
-  requires concepts::quantity_compatible<decltype(a), decltype(b)>
-  {return (a > b)? (a - b) : decltype(a-b)(0);}
+  requires concepts::quantity_compatible<decltype(a), decltype(b)> {
+    if constexpr (concepts::pack_quantity<decltype(a - b)>)
+      return max(a - b, decltype(a - b)(0));
+    else
+      return (a > b)? (a - b) : decltype(a-b)(0);
+  }
 
   // * exponential functions
 
@@ -131,7 +333,7 @@ namespace units::_details::_math {
   units_math_import_function_for_dimensionless(hypot)
 
   // square root restricted to units without factor and even powers
-  template <concepts::reduced_power... Ps, concepts::arithmetic V>
+  template <concepts::reduced_power... Ps, concepts::value V>
   auto sqrt(const quantity<unit<one, Ps...>, V> q) {
     using unit_sqrt = unit<one, power_t<Ps, 1, 2>...>;
     return quantity<unit_sqrt, decltype(sqrt(V{}))>(sqrt(q.get_value()));
@@ -152,8 +354,24 @@ namespace units::_details::_math {
     }
   }
 
+  // compile-time integer power of a pack, whose elements keep their type
+  template <int p>
+  auto pow(const concepts::pack auto x) -> decltype(x) {
+    using T = decltype(x);
+    if constexpr (p == 0)
+      return T(1);
+    else if constexpr (p == 1)
+      return x;
+    else if constexpr (p < 0)
+      return T(1)/pow<-p>(x);
+    else {
+      const auto y = pow<p/2>(x);
+      return (p%2 == 1)? y * y * x : y * y;
+    }
+  }
+
   // compile-time integer power of a quantity
-  template <int p, concepts::unit U, concepts::arithmetic V>
+  template <int p, concepts::unit U, concepts::value V>
   auto pow(const quantity<U, V> q) {
     auto value = pow<p>(q.get_value());
     return quantity<make_unit<power<U, p>>, decltype(value)>(value);
@@ -283,6 +501,223 @@ namespace units::_details::_math {
 
   constexpr auto isunordered(const concepts::quantity auto a, const concepts::quantity auto b)
   {return isnan(a) || isnan(b);}
+
+  // * batch versions
+
+  // abs, ceil, floor, trunc, round, sqrt, exp, log, pow<p>, hypot and fmod also take
+  // a contiguous range of quantities, and write their results into a contiguous
+  // range whose elements have exactly the type returned for a single quantity. as in
+  // convert_into, min(in.size(), out.size()) elements are computed, and the span of
+  // written elements is returned.
+  //
+  // elements are processed in blocks of as many float or double values as fit in a
+  // vector register. sqrt is correctly rounded, exp and log are within 1 ulp and
+  // hypot within 1.5 ulp of the correctly rounded result. arguments out of the range
+  // of the vectorized kernels (infinities, nans, results that overflow or underflow)
+  // are recomputed with the functions from <cmath>
+
+  namespace _batch {
+    // * ranges of inputs and outputs
+    template <class R>
+    concept input = std::ranges::contiguous_range<R> && concepts::quantity<std::ranges::range_value_t<R>>;
+
+    template <class R, class T>
+    concept output =
+      std::ranges::contiguous_range<R> && std::ranges::output_range<R, T> &&
+      std::same_as<std::ranges::range_value_t<R>, T>;
+
+    template <input R>
+    using element_t = std::ranges::range_value_t<R>;
+
+    // * raw value type of a quantity or number
+    template <class T>
+    struct raw {using type = T;};
+
+    template <concepts::quantity Q>
+    struct raw<Q> {using type = typename Q::value_type;};
+
+    template <class T>
+    using raw_t = typename raw<T>::type;
+
+    // * kernel of a function without a vectorized approximation
+    template <class F>
+    struct plain {
+      F function;
+
+      static bool fast(const auto...) {return true;}
+      auto lane(const auto... x) const {return function(x...);}
+      auto exact(const auto... x) const {return function(x...);}
+    };
+
+    template <class F>
+    plain(F) -> plain<F>;
+
+    // * call block(i, m) for the blocks of width elements covering n elements, m
+    // * being a compile-time constant for full blocks. the tail is computed as a
+    // * partial block, so that results do not depend on the position of the elements
+    // * in the range
+    template <std::size_t width, class B>
+    void blocks(const std::size_t n, const B& block) {
+      std::size_t i = 0;
+
+      for (; i + width <= n; i += width)
+        block(i, std::integral_constant<std::size_t, width>());
+
+      if (i < n)
+        block(i, std::size_t(n - i));
+    }
+
+    // * element computed by lane j of a block of m elements: unused lanes of a
+    // * partial block repeat its first element
+    template <class M>
+    constexpr std::size_t lane(const std::size_t j, const M m) {
+      if constexpr (std::is_same_v<M, std::size_t>)
+        return j < m? j : 0;
+      else
+        return j;
+    }
+
+    // * compute n elements with kernel k, whose arguments of type T are given by
+    // * the functions in, and write them into out
+    template <class T, class K, class R, class... In>
+    void apply(const K& k, const std::size_t n, R* out, const In&... in) {
+      constexpr std::size_t width = _simd::lanes<T>;
+
+      if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+        blocks<width>(n, [&](const std::size_t i, const auto m) {
+          T values[width];
+
+          for (std::size_t j = 0; j < width; ++j)
+            values[j] = k.lane(in(i + lane(j, m))...);
+
+          if constexpr (requires {k.finish(values);})
+            k.finish(values);
+
+          _kernel::refine(m,
+            [&](const std::size_t j) {return k.fast(in(i+j)...);},
+            [&](const std::size_t j) {values[j] = k.exact(in(i+j)...);});
+
+          for (std::size_t j = 0; j < m; ++j)
+            out[i+j] = R(values[j]);
+        });
+      } else {
+        for (std::size_t i = 0; i < n; ++i)
+          out[i] = R(k.exact(in(i)...));
+      }
+    }
+
+    // * apply kernel k to the values of in, scaled by F into T
+    template <concepts::ratio F, class T, class K, class In, class Out>
+    auto unary(const K& k, const In& in, Out&& out) {
+      const auto n = std::min<std::size_t>(std::ranges::size(in), std::ranges::size(out));
+      const auto x = std::ranges::data(in);
+
+      apply<T>(k, n, std::ranges::data(out), [x](const std::size_t i)
+        {return _algorithm::scale<F, T>(x[i].get_value());});
+
+      return std::span(std::ranges::data(out), n);
+    }
+
+    // * factor applied to the values of Q before the function that returns R:
+    // * functions returning numbers act on values of dimensionless quantities
+    // * converted to make_unit<>, see units_math_import_function_for_dimensionless
+    template <class Q, class R>
+    using input_factor = std::conditional_t<concepts::quantity<R>, one, typename Q::unit_type::factor>;
+  }
+
+  template <_batch::input In, _batch::output<decltype(abs(std::declval<_batch::element_t<In>>()))> Out>
+  auto abs(const In& in, Out&& out) {
+    using R = std::ranges::range_value_t<Out>;
+    return _batch::unary<one, _batch::raw_t<R>>(_batch::plain([](const auto x) {return abs(x);}), in, out);
+  }
+
+  template <_batch::input In, _batch::output<decltype(ceil(std::declval<_batch::element_t<In>>()))> Out>
+  auto ceil(const In& in, Out&& out) {
+    using R = std::ranges::range_value_t<Out>;
+    return _batch::unary<one, _batch::raw_t<R>>(_batch::plain([](const auto x) {return std::ceil(x);}), in, out);
+  }
+
+  template <_batch::input In, _batch::output<decltype(floor(std::declval<_batch::element_t<In>>()))> Out>
+  auto floor(const In& in, Out&& out) {
+    using R = std::ranges::range_value_t<Out>;
+    return _batch::unary<one, _batch::raw_t<R>>(_batch::plain([](const auto x) {return std::floor(x);}), in, out);
+  }
+
+  template <_batch::input In, _batch::output<decltype(trunc(std::declval<_batch::element_t<In>>()))> Out>
+  auto trunc(const In& in, Out&& out) {
+    using R = std::ranges::range_value_t<Out>;
+    return _batch::unary<one, _batch::raw_t<R>>(_batch::plain([](const auto x) {return std::trunc(x);}), in, out);
+  }
+
+  template <_batch::input In, _batch::output<decltype(round(std::declval<_batch::element_t<In>>()))> Out>
+  auto round(const In& in, Out&& out) {
+    using R = std::ranges::range_value_t<Out>;
+    return _batch::unary<one, _batch::raw_t<R>>(_batch::plain([](const auto x) {return std::round(x);}), in, out);
+  }
+
+  template <_batch::input In, _batch::output<decltype(sqrt(std::declval<_batch::element_t<In>>()))> Out>
+  auto sqrt(const In& in, Out&& out) {
+    using Q = _batch::element_t<In>;
+    using R = std::ranges::range_value_t<Out>;
+    return _batch::unary<_batch::input_factor<Q, R>, _batch::raw_t<R>>(_kernel::sqrt(), in, out);
+  }
+
+  template <_batch::input In, _batch::output<decltype(exp(std::declval<_batch::element_t<In>>()))> Out>
+  auto exp(const In& in, Out&& out) {
+    using Q = _batch::element_t<In>;
+    using R = std::ranges::range_value_t<Out>;
+    return _batch::unary<_batch::input_factor<Q, R>, _batch::raw_t<R>>(_kernel::exp(), in, out);
+  }
+
+  template <_batch::input In, _batch::output<decltype(log(std::declval<_batch::element_t<In>>()))> Out>
+  auto log(const In& in, Out&& out) {
+    using Q = _batch::element_t<In>;
+    using R = std::ranges::range_value_t<Out>;
+    return _batch::unary<_batch::input_factor<Q, R>, _batch::raw_t<R>>(_kernel::log(), in, out);
+  }
+
+  template <int p, _batch::input In, _batch::output<decltype(pow<p>(std::declval<_batch::element_t<In>>()))> Out>
+  auto pow(const In& in, Out&& out) {
+    using R = std::ranges::range_value_t<Out>;
+    return _batch::unary<one, _batch::raw_t<R>>(_batch::plain([](const auto x) {return pow<p>(x);}), in, out);
+  }
+
+  template <
+    _batch::input InA, _batch::input InB,
+    _batch::output<decltype(hypot(std::declval<_batch::element_t<InA>>(), std::declval<_batch::element_t<InB>>()))> Out>
+  auto hypot(const InA& a, const InB& b, Out&& out) {
+    using R = std::ranges::range_value_t<Out>;
+    using T = _batch::raw_t<R>;
+    using Fa = ratio_divide<typename _batch::element_t<InA>::unit_type::factor, typename R::unit_type::factor>;
+    using Fb = ratio_divide<typename _batch::element_t<InB>::unit_type::factor, typename R::unit_type::factor>;
+
+    const auto n = std::min({std::ranges::size(a), std::ranges::size(b), std::ranges::size(out)});
+    const auto x = std::ranges::data(a);
+    const auto y = std::ranges::data(b);
+
+    _batch::apply<T>(_kernel::hypot(), n, std::ranges::data(out),
+      [x](const std::size_t i) {return _algorithm::scale<Fa, T>(x[i].get_value());},
+      [y](const std::size_t i) {return _algorithm::scale<Fb, T>(y[i].get_value());});
+
+    return std::span(std::ranges::data(out), n);
+  }
+
+  // the divisor is the same for all elements
+  template <_batch::input In, class D, _batch::output<decltype(fmod(std::declval<_batch::element_t<In>>(), std::declval<D>()))> Out>
+  requires concepts::arithmetic<D> || concepts::quantity_compatible<D, _batch::element_t<In>>
+  auto fmod(const In& in, const D b, Out&& out) {
+    using R = std::ranges::range_value_t<Out>;
+    using T = _batch::raw_t<R>;
+
+    if constexpr (concepts::arithmetic<D>) {
+      return _batch::unary<one, T>(_batch::plain([b](const auto x) {return fmod(x, b);}), in, out);
+    } else {
+      // as for single quantities, a - trunc(a/b)*b, with b converted to the unit of a
+      using F = ratio_divide<typename _batch::element_t<In>::unit_type::factor, typename R::unit_type::factor>;
+      const auto c = quantity<typename R::unit_type, T>(b).get_value();
+      return _batch::unary<F, T>(_batch::plain([c](const auto x) {return x - std::trunc(x/c)*c;}), in, out);
+    }
+  }
 }
 
 // - undefine macros
@@ -290,5 +725,8 @@ namespace units::_details::_math {
 #undef units_math_import_function_for_dimensionless
 #undef units_math_import_function_for_get_value_returning_quantity
 #undef units_math_import_function_for_get_value_returning_value
+#undef units_math_pack_function
+#undef units_math_pack_binary_function
+#undef units_math_pack_classification
 
 #endif
\ No newline at end of file
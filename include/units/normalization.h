@@ -0,0 +1,267 @@
+#ifndef _include_units_normalization_h
+#define _include_units_normalization_h
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <units/dynamic.h>
+#include <units/framework.h>
+#include <units/math.h>
+#include <units/parser.h>
+
+namespace units::_details {
+
+  // - conversion plans
+
+  // everything needed to convert values between two runtime units, worked out once:
+  // the exact ratio of the factors of the units and, for floating-point values, the
+  // single number the values are multiplied by. integral values are scaled exactly,
+  // as by dynamic_quantity, truncating the result if the ratio is not an integer
+
+  template <concepts::arithmetic V>
+  struct conversion_plan {
+    unit_descriptor source;
+    unit_descriptor target;
+    runtime_ratio ratio;
+    V factor;
+
+    // * convert a single value
+    constexpr V operator()(const V value) const {
+      if constexpr (std::is_floating_point_v<V>)
+        return value*factor;
+      else
+        return _dynamic::scale(value, ratio);
+    }
+
+    // * convert n values in place
+    constexpr void operator()(V* values, const std::size_t n) const {
+      if constexpr (std::is_floating_point_v<V>) {
+        // a plain product, which the compiler vectorizes
+        const V f = factor;
+        for (std::size_t i = 0; i < n; ++i)
+          values[i] *= f;
+      } else if (ratio != runtime_ratio{}) {
+        for (std::size_t i = 0; i < n; ++i)
+          values[i] = _dynamic::scale(values[i], ratio);
+      }
+    }
+  };
+
+  // * plan for the conversion between two units, if they are compatible
+  template <concepts::arithmetic V = double>
+  constexpr std::optional<conversion_plan<V>> make_plan(const unit_descriptor& source, const unit_descriptor& target) {
+    if (!source.compatible(target))
+      return std::nullopt;
+
+    const auto ratio = source.factor/target.factor;
+    if (!ratio.valid())
+      return std::nullopt;
+
+    V factor = 1;
+    if constexpr (std::is_floating_point_v<V>)
+      factor = ratio.template value<V>();
+
+    return conversion_plan<V>{source, target, ratio, factor};
+  }
+
+  // - definition of the normalizer class
+
+  // gathers values reported in any unit compatible with that of Q, and writes them
+  // out as quantities of type Q. every source unit is registered once, which builds
+  // its conversion plan and returns a small integer identifying it. records are then
+  // pushed with this identifier, into a column of sources and a column of values,
+  // with no conversion nor unit lookup at all, and converted all at once on flush
+
+  template <concepts::quantity Q>
+  requires concepts::describable_unit<typename Q::unit_type>
+  class normalizer {
+  public:
+    using quantity_type = Q;
+    using value_type = typename Q::value_type;
+    using source_id = std::size_t;
+
+  private:
+    std::vector<conversion_plan<value_type>> m_plans;
+    // the factors of the plans, contiguous, so that they are gathered by source
+    std::vector<value_type> m_factors;
+
+    std::vector<source_id> m_sources;
+    std::vector<value_type> m_values;
+
+    // the source of the last dynamic quantity pushed, as records come in runs
+    source_id m_last = 0;
+
+    // the source of records already converted to the target unit, which is never
+    // the identifier of a registered source
+    static constexpr source_id converted = std::numeric_limits<source_id>::max();
+
+  public:
+
+    // * the target unit
+    static constexpr const unit_descriptor& target() {return descriptor_of<typename Q::unit_type>;}
+
+    // * registration of source units
+
+    // the identifier of a source unit, registering it on first use. units that are
+    // incompatible with the target are rejected, as are symbols that cannot be parsed
+    std::optional<source_id> source(const unit_descriptor& unit) {
+      for (source_id id = 0; id < m_plans.size(); ++id)
+        if (m_plans[id].source == unit)
+          return id;
+
+      const auto plan = make_plan<value_type>(unit, target());
+      if (!plan)
+        return std::nullopt;
+
+      m_plans.push_back(*plan);
+      m_factors.push_back(plan->factor);
+      return m_plans.size() - 1;
+    }
+
+    std::optional<source_id> source(const std::string_view symbol) {
+      const auto unit = parse_unit(symbol);
+      return unit? source(*unit) : std::nullopt;
+    }
+
+    template <concepts::describable_unit U>
+    std::optional<source_id> source()
+    {return source(descriptor_of<U>);}
+
+    // * number of source units, and their conversion plans
+    std::size_t sources() const {return m_plans.size();}
+    const conversion_plan<value_type>& plan(const source_id id) const {return m_plans[id];}
+
+    // * records
+
+    // number of records pushed since the last flush
+    std::size_t size() const {return m_values.size();}
+
+    // a value in the unit of a registered source. false if id is not that of a
+    // registered source, in which case nothing is pushed
+    bool push(const source_id id, const value_type value) {
+      if (id >= sources())
+        return false;
+
+      m_sources.push_back(id);
+      m_values.push_back(value);
+      return true;
+    }
+
+    // records as parallel arrays of sources and values, which are copied as blocks.
+    // false if any of the ids is not that of a registered source, in which case
+    // none of the records is pushed
+    bool push(const std::span<const source_id> ids, const std::span<const value_type> values) {
+      const auto n = std::min(ids.size(), values.size());
+      const auto count = sources();
+
+      if (!std::all_of(ids.begin(), ids.begin() + n, [count](const source_id id) {return id < count;}))
+        return false;
+
+      m_sources.insert(m_sources.end(), ids.begin(), ids.begin() + n);
+      m_values.insert(m_values.end(), values.begin(), values.begin() + n);
+      return true;
+    }
+
+    // a dynamic quantity, whose unit is registered if needed. only the unit of the
+    // previous record is compared before the full lookup, which is then rare. false
+    // if the unit is incompatible with the target, in which case nothing is pushed.
+    // floating-point values pushed into an integral normalizer are converted right
+    // away, before they are truncated, and recorded as already converted, with no
+    // source. nothing is pushed if values do not fit in the value type, or are nan
+    template <concepts::arithmetic V>
+    bool push(const dynamic_quantity<V>& q) {
+      if (m_last >= m_plans.size() || m_plans[m_last].source != q.get_unit()) {
+        const auto id = source(q.get_unit());
+        if (!id)
+          return false;
+
+        m_last = *id;
+      }
+
+      if constexpr (std::is_floating_point_v<V> && !std::is_floating_point_v<value_type>) {
+        const auto value = _dynamic::checked_scale<value_type>(q.get_value(), m_plans[m_last].ratio);
+        if (!value)
+          return false;
+
+        m_sources.push_back(converted);
+        m_values.push_back(*value);
+        return true;
+      } else if constexpr (!std::is_same_v<V, value_type>) {
+        const auto value = _dynamic::checked_scale<value_type>(q.get_value(), runtime_ratio{});
+        return value && push(m_last, *value);
+      } else {
+        return push(m_last, q.get_value());
+      }
+    }
+
+    // * conversion of the records
+
+    // the records pushed since the last flush, in the order they were pushed, are
+    // written to out and then discarded. floating-point values are multiplied by
+    // the factor of their source, loaded from a table indexed by the source, which
+    // the compiler vectorizes. the plans are kept, so identifiers remain valid.
+    // returns the part of out that was written, which is empty if out is too short
+    // to hold all the records, or if an integral value does not fit in the value type
+    // once converted. in both cases, the records are kept, but out may be partly
+    // written in the latter
+    template <_math::_batch::output<Q> Out>
+    std::span<Q> flush(Out&& out) {
+      const auto n = m_values.size();
+      const auto y = std::ranges::data(out);
+
+      if (std::size_t(std::ranges::size(out)) < n)
+        return std::span(y, 0);
+
+      const auto ids = m_sources.data();
+      const auto values = m_values.data();
+
+      if constexpr (std::is_floating_point_v<value_type>) {
+        const auto factors = m_factors.data();
+        for (std::size_t i = 0; i < n; ++i)
+          y[i] = Q(values[i]*factors[ids[i]]);
+      } else {
+        for (std::size_t i = 0; i < n; ++i) {
+          if (ids[i] == converted) {
+            y[i] = Q(values[i]);
+          } else if (const auto value = _dynamic::checked_scale<value_type>(values[i], m_plans[ids[i]].ratio)) {
+            y[i] = Q(*value);
+          } else {
+            return std::span(y, 0);
+          }
+        }
+      }
+
+      m_sources.clear();
+      m_values.clear();
+      return std::span(y, n);
+    }
+
+    // empty if the records could not be converted, which are then kept
+    std::vector<Q> flush() {
+      std::vector<Q> out(size());
+      if (flush(out).size() != out.size())
+        out.clear();
+      return out;
+    }
+  };
+
+}
+
+namespace units {
+
+  // * normalization of values of mixed units
+
+  using _details::conversion_plan;
+  using _details::make_plan;
+  using _details::normalizer;
+
+}
+
+#endif
@@ -0,0 +1,289 @@
+#ifndef _include_units_numeric_h
+#define _include_units_numeric_h
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <execution>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+#include <units/details/quantity.h>
+#include <units/details/simd.h>
+#include <units/details/unit.h>
+
+namespace units::_details {
+
+  // - summation policies of floating-point reductions
+
+  // * naive: a plain sum, whose error grows linearly with the number of terms
+  // * kahan: compensated sum, whose error does not depend on the number of terms
+  // * pairwise: the terms are summed recursively by halves, so the error grows
+  // * with the logarithm of the number of terms, at the cost of a plain sum
+  namespace summation {
+    struct naive {};
+    struct kahan {};
+    struct pairwise {};
+  }
+
+  namespace traits {
+    template <class T>
+    struct is_summation_policy : std::false_type {};
+
+    template <>
+    struct is_summation_policy<summation::naive> : std::true_type {};
+
+    template <>
+    struct is_summation_policy<summation::kahan> : std::true_type {};
+
+    template <>
+    struct is_summation_policy<summation::pairwise> : std::true_type {};
+
+    template <class T>
+    constexpr inline bool is_summation_policy_v = is_summation_policy<T>::value;
+  }
+
+  namespace concepts {
+    template <class T>
+    concept summation_policy = traits::is_summation_policy_v<T>;
+
+    template <class T>
+    concept execution_policy = std::is_execution_policy_v<std::remove_cvref_t<T>>;
+
+    template <class R>
+    concept quantity_range = std::ranges::contiguous_range<R> && quantity<std::ranges::range_value_t<R>>;
+  }
+
+}
+
+namespace units::_details::_numeric {
+
+  // - kernels summing the terms term(i), for first <= i < last
+
+  // all kernels keep one accumulator per lane of a vector register, so that the loop
+  // is vectorized without reordering the operations of each accumulator. integral
+  // terms are always summed plainly, which is exact (modulo overflow). the kahan
+  // compensation is removed by -ffast-math or -fassociative-math, which reduce it
+  // to a plain sum
+
+  // * a partial sum, along with the rounding error it has not accounted for
+  template <class T>
+  struct partial {
+    T sum = 0;
+    T compensation = 0;
+
+    constexpr T value() const {return sum + compensation;}
+  };
+
+  // * naive summation
+  template <class T, class F>
+  constexpr partial<T> naive(const std::size_t first, const std::size_t last, const F& term) {
+    constexpr std::size_t width = _simd::lanes<T>;
+    T acc[width] = {};
+
+    std::size_t i = first;
+    for (; i + width <= last; i += width)
+      for (std::size_t j = 0; j < width; ++j)
+        acc[j] += term(i + j);
+
+    T sum = 0;
+    for (; i < last; ++i)
+      sum += term(i);
+
+    for (std::size_t j = 0; j < width; ++j)
+      sum += acc[j];
+
+    return {sum, 0};
+  }
+
+  // * pairwise summation, down to blocks summed naively
+  template <class T, class F>
+  constexpr partial<T> pairwise(const std::size_t first, const std::size_t last, const F& term) {
+    constexpr std::size_t width = _simd::lanes<T>;
+
+    if (last - first <= 16*width)
+      return naive<T>(first, last, term);
+
+    // halves are split at a multiple of the width, so they keep their blocks aligned
+    const std::size_t middle = first + ((last - first)/2/width)*width;
+    return {pairwise<T>(first, middle, term).sum + pairwise<T>(middle, last, term).sum, 0};
+  }
+
+  // * neumaier's compensated addition, also correct when x is larger than the sum
+  template <class T>
+  constexpr void neumaier(partial<T>& p, const T x) {
+    const T t = p.sum + x;
+    p.compensation += (std::abs(p.sum) >= std::abs(x))? (p.sum - t) + x : (x - t) + p.sum;
+    p.sum = t;
+  }
+
+  // * kahan summation: each lane is compensated, and lanes are merged with neumaier's
+  template <class T, class F>
+  constexpr partial<T> kahan(const std::size_t first, const std::size_t last, const F& term) {
+    constexpr std::size_t width = _simd::lanes<T>;
+    T acc[width] = {};
+    T err[width] = {};
+
+    std::size_t i = first;
+    for (; i + width <= last; i += width) {
+      for (std::size_t j = 0; j < width; ++j) {
+        const T y = term(i + j) - err[j];
+        const T t = acc[j] + y;
+        err[j] = (t - acc[j]) - y;
+        acc[j] = t;
+      }
+    }
+
+    partial<T> ret;
+    for (; i < last; ++i)
+      neumaier(ret, term(i));
+
+    for (std::size_t j = 0; j < width; ++j) {
+      neumaier(ret, acc[j]);
+      ret.compensation -= err[j];
+    }
+
+    return ret;
+  }
+
+  template <concepts::summation_policy S, class T, class F>
+  constexpr partial<T> accumulate(const std::size_t first, const std::size_t last, const F& term) {
+    if constexpr (std::is_integral_v<T> || std::is_same_v<S, summation::naive>)
+      return naive<T>(first, last, term);
+    else if constexpr (std::is_same_v<S, summation::kahan>)
+      return kahan<T>(first, last, term);
+    else
+      return pairwise<T>(first, last, term);
+  }
+
+  // - reduction of n terms, in parallel according to the execution policy
+
+  // the terms are split in chunks of fixed size, which are summed independently and
+  // then merged in order with the same summation policy. the chunks do not depend on
+  // the policy nor on the number of threads, so the result of a reduction does not
+  // either: reductions are reproducible, and the same with and without a policy
+
+  constexpr inline std::size_t chunk = std::size_t(1) << 16;
+
+  template <concepts::summation_policy S, class T, class P, class F>
+  T reduce_n(P&& policy, const std::size_t n, const F& term) {
+    if (n <= chunk)
+      return accumulate<S, T>(0, n, term).value();
+
+    std::vector<partial<T>> partials((n + chunk - 1)/chunk);
+
+    std::for_each(std::forward<P>(policy), partials.begin(), partials.end(), [&](partial<T>& p) {
+      const std::size_t first = std::size_t(&p - partials.data())*chunk;
+      p = accumulate<S, T>(first, std::min(first + chunk, n), term);
+    });
+
+    auto total = accumulate<S, T>(0, partials.size(), [&](const std::size_t i) {return partials[i].sum;});
+    for (const auto& p : partials)
+      total.compensation += p.compensation;
+
+    return total.value();
+  }
+
+  // - value types of the reductions
+
+  template <class R>
+  using value_t = typename std::ranges::range_value_t<R>::value_type;
+
+  template <class R>
+  using unit_t = typename std::ranges::range_value_t<R>::unit_type;
+
+  // the mean of integral quantities is a double
+  template <class R>
+  using mean_value_t = std::conditional_t<std::is_floating_point_v<value_t<R>>, value_t<R>, double>;
+
+  // - sum of the quantities of a contiguous range, in their unit
+
+  template <concepts::summation_policy S = summation::pairwise, concepts::execution_policy P, concepts::quantity_range R>
+  auto sum(P&& policy, const R& r) {
+    const auto data = std::ranges::data(r);
+    const auto value = reduce_n<S, value_t<R>>(std::forward<P>(policy), std::ranges::size(r),
+      [data](const std::size_t i) {return data[i].get_value();});
+    return quantity<unit_t<R>, value_t<R>>(value);
+  }
+
+  template <concepts::summation_policy S = summation::pairwise, concepts::quantity_range R>
+  auto sum(const R& r) {
+    return sum<S>(std::execution::seq, r);
+  }
+
+  // - sum of the quantities of a range, added to init
+
+  // the elements are summed in their own unit, and the sum is converted to the unit of
+  // init, so that the conversion factor is applied once instead of once per element
+  template <concepts::summation_policy S = summation::pairwise, concepts::execution_policy P, concepts::quantity_range R, concepts::quantity_compatible<std::ranges::range_value_t<R>> Q>
+  auto reduce(P&& policy, const R& r, const Q init) {
+    return init + sum<S>(std::forward<P>(policy), r);
+  }
+
+  template <concepts::summation_policy S = summation::pairwise, concepts::quantity_range R, concepts::quantity_compatible<std::ranges::range_value_t<R>> Q>
+  auto reduce(const R& r, const Q init) {
+    return reduce<S>(std::execution::seq, r, init);
+  }
+
+  // - dot product of two ranges of quantities, in the product of their units
+
+  // min(a.size(), b.size()) elements are multiplied. the summation policy applies to
+  // the sum of the products, whose own rounding errors are not compensated
+  template <concepts::summation_policy S = summation::pairwise, concepts::execution_policy P, concepts::quantity_range Ra, concepts::quantity_range Rb>
+  auto dot(P&& policy, const Ra& a, const Rb& b) {
+    using T = decltype(value_t<Ra>() * value_t<Rb>());
+    const auto x = std::ranges::data(a);
+    const auto y = std::ranges::data(b);
+    const auto n = std::min<std::size_t>(std::ranges::size(a), std::ranges::size(b));
+
+    const auto value = reduce_n<S, T>(std::forward<P>(policy), n,
+      [x, y](const std::size_t i) {return T(x[i].get_value()) * T(y[i].get_value());});
+    return quantity<unit_multiply<unit_t<Ra>, unit_t<Rb>>, T>(value);
+  }
+
+  template <concepts::summation_policy S = summation::pairwise, concepts::quantity_range Ra, concepts::quantity_range Rb>
+  auto dot(const Ra& a, const Rb& b) {
+    return dot<S>(std::execution::seq, a, b);
+  }
+
+  // - arithmetic mean of the quantities of a range
+
+  // integral quantities are summed exactly, and their mean is a double. the mean of an
+  // empty range is a nan
+  template <concepts::summation_policy S = summation::pairwise, concepts::execution_policy P, concepts::quantity_range R>
+  auto mean(P&& policy, const R& r) {
+    using T = mean_value_t<R>;
+    const auto n = std::ranges::size(r);
+
+    if (n == 0)
+      return quantity<unit_t<R>, T>(std::numeric_limits<T>::quiet_NaN());
+
+    return quantity<unit_t<R>, T>(T(sum<S>(std::forward<P>(policy), r).get_value()) / T(n));
+  }
+
+  template <concepts::summation_policy S = summation::pairwise, concepts::quantity_range R>
+  auto mean(const R& r) {
+    return mean<S>(std::execution::seq, r);
+  }
+
+}
+
+namespace units {
+
+  // * summation policies
+
+  namespace summation = _details::summation;
+
+  // * reductions of ranges of quantities
+
+  using _details::_numeric::sum;
+  using _details::_numeric::reduce;
+  using _details::_numeric::dot;
+  using _details::_numeric::mean;
+
+}
+
+#endif
@@ -0,0 +1,312 @@
+#ifndef _include_units_parser_h
+#define _include_units_parser_h
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include <units/angular.h>
+#include <units/details/registry.h>
+#include <units/framework.h>
+#include <units/units.h>
+
+namespace units::_details {
+
+  // - symbol tables
+
+  namespace _parser {
+
+    // * lists of units whose symbols are recognized by the parser
+
+    // units accepting any of the SI prefixes
+    using prefixable_units = unit_list<
+      meter, second, gram, ampere, kelvin, mole, candela, steradian,
+      hertz, newton, pascal, joule, watt, coulomb, volt, farad, ohm, siemens,
+      weber, tesla, henry, lumen, lux, becquerel, katal, electronvolt,
+      radian>;
+
+    // units that are only recognized by their own symbol
+    using plain_units = unit_list<
+      decay, angstrom, foot, thou, barleycorn, yard, chain, furlong, mile, league,
+      minute, hour, day, year, pi, degree, cycle, arcminute, arcsecond>;
+
+    // * table entries
+
+    struct unit_entry {
+      std::string_view symbol;
+      unit_descriptor unit;
+      bool prefixable;
+    };
+
+    struct prefix_entry {
+      std::string_view symbol;
+      runtime_ratio factor;
+    };
+
+    template <bool prefixable, class... Us>
+    constexpr auto make_entries(unit_list<Us...>)
+    {return std::array<unit_entry, sizeof...(Us)>{unit_entry{_unit::symbol<Us>, descriptor_of<Us>, prefixable}...};}
+
+    // symbols without a unit of their own
+    constexpr std::array<unit_entry, 2> alias_entries = {
+      unit_entry{"Gy", descriptor_of<gray>, true},
+      unit_entry{"Sv", descriptor_of<sievert>, true}
+    };
+
+    constexpr std::array<prefix_entry, 17> prefix_entries = {
+      prefix_entry{"f", runtime_ratio::of<femto>()},
+      prefix_entry{"p", runtime_ratio::of<pico>()},
+      prefix_entry{"n", runtime_ratio::of<nano>()},
+      prefix_entry{"u", runtime_ratio::of<micro>()},
+      prefix_entry{"µ", runtime_ratio::of<micro>()}, // micro sign
+      prefix_entry{"μ", runtime_ratio::of<micro>()}, // greek small letter mu
+      prefix_entry{"m", runtime_ratio::of<milli>()},
+      prefix_entry{"c", runtime_ratio::of<centi>()},
+      prefix_entry{"d", runtime_ratio::of<deci>()},
+      prefix_entry{"da", runtime_ratio::of<deca>()},
+      prefix_entry{"h", runtime_ratio::of<hecto>()},
+      prefix_entry{"k", runtime_ratio::of<kilo>()},
+      prefix_entry{"M", runtime_ratio::of<mega>()},
+      prefix_entry{"G", runtime_ratio::of<giga>()},
+      prefix_entry{"T", runtime_ratio::of<tera>()},
+      prefix_entry{"P", runtime_ratio::of<peta>()},
+      prefix_entry{"E", runtime_ratio::of<exa>()}
+    };
+
+    // * concatenation of entry arrays
+    template <class T, std::size_t... Ns>
+    constexpr auto concat(const std::array<T, Ns>&... arrays) {
+      std::array<T, (Ns + ...)> ret;
+      std::size_t i = 0;
+      ((std::copy(arrays.begin(), arrays.end(), ret.begin() + i), i += Ns), ...);
+      return ret;
+    }
+
+  }
+
+  // - symbol lookup tables
+
+  // the entries are indexed by their symbols with a perfect hash, see
+  // _registry::perfect_hash, so that a lookup costs one hash and a single string
+  // comparison
+
+  namespace _parser {
+
+    template <class Entry, std::size_t N>
+    class perfect_hash_table {
+    private:
+      std::array<Entry, N> m_entries;
+      _registry::perfect_hash<N> m_index;
+
+    public:
+      constexpr perfect_hash_table(const std::array<Entry, N>& entries)
+      : m_entries(entries), m_index(_registry::keys(entries, &Entry::symbol)) {}
+
+      // * the entry with the given symbol, if any
+      constexpr const Entry* find(const std::string_view symbol) const {
+        const auto index = m_index.candidate(symbol);
+        return (index < N && m_entries[index].symbol == symbol)? &m_entries[index] : nullptr;
+      }
+    };
+
+    constexpr auto unit_entries = concat(
+      make_entries<true>(prefixable_units{}),
+      make_entries<false>(plain_units{}),
+      alias_entries);
+
+    static_assert(_registry::distinct(_registry::keys(unit_entries, &unit_entry::symbol)), "Unit symbols of the parser are not unique.");
+    static_assert(_registry::distinct(_registry::keys(prefix_entries, &prefix_entry::symbol)), "Prefix symbols of the parser are not unique.");
+
+    constexpr perfect_hash_table unit_table = unit_entries;
+    constexpr perfect_hash_table prefix_table = prefix_entries;
+
+  }
+
+  // - parser implementation
+
+  // grammar of the accepted expressions:
+  //
+  //   expression := term { separator term }
+  //   separator  := '/' | '*' | '·' | whitespace
+  //   term       := ( symbol | integer | '(' expression ')' ) [ '^' exponent ]
+  //   exponent   := integer | '(' integer [ '/' integer ] ')', integers may have a sign
+  //
+  // a '/' divides by the next term only, so "J/kg K" is read as J K/kg. symbols are
+  // either registered symbols or a prefix followed by the symbol of a prefixable
+  // unit. as the symbols composed by the library (see unit::symbol) may begin with
+  // a '·', expressions can also begin with one
+
+  namespace _parser {
+
+    class parser {
+    private:
+      std::string_view m_text;
+      std::size_t m_pos = 0;
+
+      static constexpr std::string_view middle_dot = "·";
+
+      constexpr bool done() const {return m_pos >= m_text.size();}
+      constexpr char peek() const {return done()? '\0' : m_text[m_pos];}
+
+      constexpr bool accept(const std::string_view s) {
+        if (!m_text.substr(m_pos).starts_with(s))
+          return false;
+        m_pos += s.size();
+        return true;
+      }
+
+      constexpr bool skip_spaces() {
+        const auto start = m_pos;
+        while (peek() == ' ' || peek() == '\t')
+          ++m_pos;
+        return m_pos != start;
+      }
+
+      // symbols are made of letters and of any non-ascii character but the middle dot
+      constexpr bool at_symbol() const {
+        const auto c = static_cast<unsigned char>(peek());
+        return ((c|0x20) >= 'a' && (c|0x20) <= 'z') || (c >= 0x80 && !m_text.substr(m_pos).starts_with(middle_dot));
+      }
+
+      constexpr bool at_digit() const {return peek() >= '0' && peek() <= '9';}
+
+      // integers in unit expressions are small, 64 bits are enough to hold them
+      constexpr std::optional<std::int64_t> integer() {
+        const bool negative = accept("-");
+        if (!negative)
+          accept("+");
+
+        if (!at_digit())
+          return std::nullopt;
+
+        std::int64_t value = 0;
+        while (at_digit()) {
+          if (__builtin_mul_overflow(value, 10, &value) || __builtin_add_overflow(value, peek() - '0', &value))
+            return std::nullopt;
+          ++m_pos;
+        }
+
+        return negative? -value : value;
+      }
+
+      constexpr std::optional<int> exponent() {
+        const bool parenthesized = accept("(");
+        const auto num = integer();
+        const auto den = (parenthesized && accept("/"))? integer() : std::int64_t(1);
+
+        if (!num || !den || (parenthesized && !accept(")")))
+          return std::nullopt;
+
+        // exponents must be integral to be represented in a dimension
+        const auto e = runtime_ratio::make(*num, *den);
+        if (e.den != 1 || e.num < dimension::min_exponent || e.num > dimension::max_exponent)
+          return std::nullopt;
+
+        return int(e.num);
+      }
+
+      constexpr unit_descriptor symbol() {
+        const auto start = m_pos;
+        while (at_symbol())
+          ++m_pos;
+
+        const auto s = m_text.substr(start, m_pos - start);
+
+        if (const auto entry = unit_table.find(s))
+          return entry->unit;
+
+        // prefixes are at most two bytes long
+        for (std::size_t length = 1; length <= 2 && length < s.size(); ++length) {
+          const auto prefix = prefix_table.find(s.substr(0, length));
+          const auto entry = prefix? unit_table.find(s.substr(length)) : nullptr;
+
+          if (entry && entry->prefixable)
+            return unit_descriptor::make(prefix->factor*entry->unit.factor, entry->unit.dim);
+        }
+
+        return unit_descriptor::invalid();
+      }
+
+      constexpr unit_descriptor term() {
+        auto ret = unit_descriptor::invalid();
+
+        if (accept("(")) {
+          ret = expression();
+          if (!accept(")"))
+            return unit_descriptor::invalid();
+        } else if (at_digit()) {
+          const auto n = integer();
+          ret = n? unit_descriptor::make(runtime_ratio::make(*n, 1), dimension()) : unit_descriptor::invalid();
+        } else if (at_symbol()) {
+          ret = symbol();
+        }
+
+        if (accept("^")) {
+          const auto e = exponent();
+          ret = e? ret.pow(*e) : unit_descriptor::invalid();
+        }
+
+        return ret;
+      }
+
+      constexpr unit_descriptor expression() {
+        skip_spaces();
+
+        auto ret = term();
+
+        while (ret.valid()) {
+          const bool spaced = skip_spaces();
+
+          if (done() || peek() == ')')
+            break;
+
+          if (accept("/")) {
+            skip_spaces();
+            ret = ret/term();
+          } else if (accept("*") || accept(middle_dot) || spaced) {
+            skip_spaces();
+            ret = ret*term();
+          } else {
+            ret = unit_descriptor::invalid();
+          }
+        }
+
+        return ret;
+      }
+
+    public:
+      constexpr parser(const std::string_view text) : m_text(text) {}
+
+      constexpr std::optional<unit_descriptor> parse() {
+        skip_spaces();
+        accept(middle_dot);
+
+        const auto ret = expression();
+
+        if (!done() || !ret.valid())
+          return std::nullopt;
+
+        return ret;
+      }
+    };
+
+  }
+
+  // - parse a unit expression
+
+  // returns the descriptor of the unit, or nothing if the expression is malformed,
+  // contains unknown symbols, or results in a unit that cannot be described
+
+  constexpr std::optional<unit_descriptor> parse_unit(const std::string_view text)
+  {return _parser::parser(text).parse();}
+
+}
+
+namespace units {
+  using _details::parse_unit;
+}
+
+#endif
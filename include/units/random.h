@@ -0,0 +1,483 @@
+#ifndef _include_units_random_h
+#define _include_units_random_h
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include <units/details/descriptor.h>
+#include <units/details/kernels.h>
+#include <units/details/quantity.h>
+#include <units/math.h>
+#include <units/units.h>
+
+namespace units::_details {
+
+  // - a generator of independent streams stepped together
+
+  // xoshiro256++ in eight interleaved streams, seeded from a single word through
+  // splitmix64. each step advances all of them, which the compiler vectorizes, and
+  // produces eight words in a fixed order, so sequences do not depend on the target.
+  // words are handed out one at a time or written into arrays with generate
+  class batch_engine {
+  public:
+    using result_type = std::uint64_t;
+
+    static constexpr std::size_t streams = 8;
+
+    explicit batch_engine(std::uint64_t seed = 0x853c49e6748fea9b) {
+      for (auto& state : m_state)
+        for (auto& s : state) {
+          seed += 0x9e3779b97f4a7c15;
+          std::uint64_t z = seed;
+          z = (z ^ (z >> 30))*0xbf58476d1ce4e5b9;
+          z = (z ^ (z >> 27))*0x94d049bb133111eb;
+          s = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() {return 0;}
+    static constexpr result_type max() {return std::numeric_limits<result_type>::max();}
+
+    result_type operator()() {
+      if (m_next == streams) {
+        step(m_buffer);
+        m_next = 0;
+      }
+
+      return m_buffer[m_next++];
+    }
+
+    // * the next n words, as n calls to operator() would return them
+    void generate(result_type* out, std::size_t n) {
+      for (; n > 0 && m_next < streams; --n)
+        *out++ = m_buffer[m_next++];
+
+      for (; n >= streams; n -= streams, out += streams)
+        step(out);
+
+      for (; n > 0; --n)
+        *out++ = (*this)();
+    }
+
+    friend bool operator==(const batch_engine&, const batch_engine&) = default;
+
+  private:
+    alignas(64) result_type m_state[4][streams];
+    result_type m_buffer[streams] = {};
+    std::size_t m_next = streams;
+
+    void step(result_type* out) {
+      auto& [s0, s1, s2, s3] = m_state;
+
+      for (std::size_t j = 0; j < streams; ++j) {
+        out[j] = std::rotl(s0[j] + s3[j], 23) + s0[j];
+
+        const auto t = s1[j] << 17;
+        s2[j] ^= s0[j];
+        s3[j] ^= s1[j];
+        s1[j] ^= s2[j];
+        s0[j] ^= s3[j];
+        s2[j] ^= t;
+        s3[j] = std::rotl(s3[j], 45);
+      }
+    }
+  };
+
+  namespace _random {
+
+    // * generators of whole 64 or 32-bit words, as are std::mt19937_64 and std::mt19937
+    template <class G>
+    concept word_generator =
+      std::uniform_random_bit_generator<std::remove_reference_t<G>> &&
+      std::remove_reference_t<G>::min() == 0 &&
+      (std::remove_reference_t<G>::max() == std::numeric_limits<std::uint64_t>::max() ||
+       std::remove_reference_t<G>::max() == std::numeric_limits<std::uint32_t>::max());
+
+    // * 64 random bits
+    template <word_generator G>
+    std::uint64_t word(G& g) {
+      if constexpr (G::max() == std::numeric_limits<std::uint64_t>::max()) {
+        return g();
+      } else {
+        const std::uint64_t high = g();
+        return (high << 32) | std::uint64_t(g());
+      }
+    }
+
+    // * n words, in blocks when the generator produces them so
+    template <word_generator G>
+    void generate(G& g, std::uint64_t* out, const std::size_t n) {
+      if constexpr (requires {g.generate(out, n);}) {
+        g.generate(out, n);
+      } else {
+        for (std::size_t i = 0; i < n; ++i)
+          out[i] = word(g);
+      }
+    }
+
+    // * uniform numbers from the upper 52 bits of a word, in [0, 1) and in (0, 1]
+
+    // the bits are the mantissa of a number in [1, 2), as integer to floating-point
+    // conversions of 64-bit words are not vectorized before avx-512. the latter is
+    // the argument of logarithms, which is then always in the range of the kernel
+    inline double canonical(const std::uint64_t w)
+    {return std::bit_cast<double>((w >> 12) | 0x3ff0000000000000) - 1;}
+
+    inline double positive(const std::uint64_t w)
+    {return 2 - std::bit_cast<double>((w >> 12) | 0x3ff0000000000000);}
+
+    // * number of samples computed at once by batch fills
+    constexpr inline std::size_t block = 64;
+
+    // * fill n elements of out, each from a single word, with the vectorized kernel f
+    template <class R, word_generator G, class F>
+    std::span<R> fill(G& g, R* out, const std::size_t n, const F& f) {
+      using value_type = typename R::value_type;
+
+      std::uint64_t words[block];
+      double values[block];
+
+      for (std::size_t i = 0; i < n; i += block) {
+        const std::size_t m = std::min(block, n - i);
+        generate(g, words, m);
+
+        for (std::size_t j = 0; j < m; ++j)
+          values[j] = f(words[j]);
+
+        for (std::size_t j = 0; j < m; ++j)
+          out[i + j] = R(static_cast<value_type>(values[j]));
+      }
+
+      return std::span(out, n);
+    }
+
+    // * units counting events: dimensionless units, or units of decay counts
+    template <class U>
+    concept count_unit = concepts::dimensionless_unit<U> || concepts::unit_compatible<U, decay>;
+
+    // * number of events in a quantity of a counting unit
+    template <concepts::quantity C>
+    requires count_unit<typename C::unit_type>
+    double count(const C c) {
+      using U = std::conditional_t<concepts::dimensionless_unit<typename C::unit_type>, make_unit<>, decay>;
+      return double(quantity<U, double>(c).get_value());
+    }
+
+    // * quantities of which rate is a frequency, as events per unit of Q
+    template <class R, class Q>
+    concept rate_of = concepts::quantity<R> && concepts::quantity<Q> &&
+      count_unit<unit_multiply<typename R::unit_type, typename Q::unit_type>>;
+
+    // * unit of the time between events that occur at a rate of unit U
+
+    // decay counts in the rate are not part of the interval: an activity in
+    // becquerel gives decay times in seconds
+    constexpr inline unsigned decay_id = unsigned(std::countr_zero(descriptor_of<decay>.dim.bits()))/dimension::field_bits;
+
+    template <concepts::unit U>
+    using interval_t = std::conditional_t<(descriptor_of<U>.dim.exponent(decay_id) == 1), unit_divide<decay, U>, unit_divide<make_unit<>, U>>;
+
+    // * floating-point type of a sample from parameters of value type V
+    template <class V>
+    using floating_t = std::conditional_t<std::is_floating_point_v<V>, V, double>;
+
+    // * integral unit of the events counted in a quantity of unit U
+    template <count_unit U>
+    using events_t = std::conditional_t<concepts::dimensionless_unit<U>, make_unit<>, decay>;
+
+  }
+
+  // - distributions of quantities
+
+  // each distribution takes its parameters as quantities of any compatible unit and
+  // draws samples one at a time, g(rng), or fills a contiguous range of them,
+  // g(rng, out), in which case uniform numbers are computed from blocks of random
+  // words and transformed in vectorized loops. only generators of whole 64 or 32-bit
+  // words are accepted, and batch_engine makes the words themselves in blocks
+
+  // * time between events occurring at a constant rate
+  template <concepts::floating_point_quantity Q>
+  class exponential_distribution {
+  public:
+    using result_type = Q;
+    using value_type = typename Q::value_type;
+
+    // the product of the rate and Q counts events, as hertz and seconds, or as
+    // becquerel and seconds do
+    template <_random::rate_of<Q> R>
+    explicit exponential_distribution(const R rate)
+    : m_mean(1/_random::count(rate*Q(1)))
+    {}
+
+    Q mean() const {return Q(static_cast<value_type>(m_mean));}
+
+    template <_random::word_generator G>
+    Q operator()(G& g) const
+    {return Q(static_cast<value_type>(sample(_random::word(g))));}
+
+    template <_random::word_generator G, _math::_batch::output<Q> Out>
+    std::span<Q> operator()(G& g, Out&& out) const {
+      return _random::fill(g, std::ranges::data(out), std::ranges::size(out),
+        [this](const std::uint64_t w) {return sample(w);});
+    }
+
+  private:
+    double m_mean;
+
+    double sample(const std::uint64_t w) const
+    {return -m_mean*_kernel::log::lane(_random::positive(w));}
+  };
+
+  template <concepts::quantity R>
+  exponential_distribution(R) -> exponential_distribution<
+    quantity<_random::interval_t<typename R::unit_type>, _random::floating_t<typename R::value_type>>>;
+
+  // * uniform between a, included, and b
+  template <concepts::floating_point_quantity Q>
+  class uniform_distribution {
+  public:
+    using result_type = Q;
+    using value_type = typename Q::value_type;
+
+    uniform_distribution(const concepts::quantity_compatible<Q> auto a, const concepts::quantity_compatible<Q> auto b)
+    : m_a(double(Q(a).get_value())),
+      m_width(double(Q(b).get_value()) - m_a)
+    {}
+
+    Q a() const {return Q(static_cast<value_type>(m_a));}
+    Q b() const {return Q(static_cast<value_type>(m_a + m_width));}
+
+    template <_random::word_generator G>
+    Q operator()(G& g) const
+    {return Q(static_cast<value_type>(sample(_random::word(g))));}
+
+    template <_random::word_generator G, _math::_batch::output<Q> Out>
+    std::span<Q> operator()(G& g, Out&& out) const {
+      return _random::fill(g, std::ranges::data(out), std::ranges::size(out),
+        [this](const std::uint64_t w) {return sample(w);});
+    }
+
+  private:
+    double m_a;
+    double m_width;
+
+    double sample(const std::uint64_t w) const
+    {return m_a + m_width*_random::canonical(w);}
+  };
+
+  template <concepts::quantity A, concepts::quantity_compatible<A> B>
+  uniform_distribution(A, B) -> uniform_distribution<
+    quantity<typename A::unit_type, _random::floating_t<typename A::value_type>>>;
+
+  // * normal with the given mean and standard deviation
+
+  // samples come in pairs from the box-muller transform of two uniform numbers, u
+  // and v: sqrt(-2 log u) times the cosine and the sine of v turns, for which the
+  // vectorized kernels are exact at the quadrants. single samples keep the second
+  // of each pair for the next call
+  template <concepts::floating_point_quantity Q>
+  class normal_distribution {
+  public:
+    using result_type = Q;
+    using value_type = typename Q::value_type;
+
+    normal_distribution(const concepts::quantity_compatible<Q> auto mean, const concepts::quantity_compatible<Q> auto stddev)
+    : m_mean(double(Q(mean).get_value())),
+      m_stddev(double(Q(stddev).get_value()))
+    {}
+
+    Q mean() const {return Q(static_cast<value_type>(m_mean));}
+    Q stddev() const {return Q(static_cast<value_type>(m_stddev));}
+
+    template <_random::word_generator G>
+    Q operator()(G& g) {
+      if (m_spare) {
+        m_spare = false;
+        return Q(static_cast<value_type>(m_next));
+      }
+
+      const auto u = _random::word(g);
+      const auto v = _random::word(g);
+
+      double x, y;
+      sample(u, v, x, y);
+      m_next = y;
+      m_spare = true;
+      return Q(static_cast<value_type>(x));
+    }
+
+    template <_random::word_generator G, _math::_batch::output<Q> Out>
+    std::span<Q> operator()(G& g, Out&& out) const {
+      using _random::block;
+
+      const auto n = std::size_t(std::ranges::size(out));
+      const auto y = std::ranges::data(out);
+
+      // squared radii are kept whole, so that their square roots are taken over the
+      // block at once by the kernel, which the compiler would not vectorize
+      std::uint64_t words[2*block];
+      double radius[block] = {}, sin[block], cos[block];
+
+      for (std::size_t i = 0; i < n; i += 2*block) {
+        // pairs of samples, the last of them halved for odd sizes
+        const std::size_t m = std::min(block, (n - i + 1)/2);
+        _random::generate(g, words, 2*m);
+
+        for (std::size_t j = 0; j < m; ++j)
+          radius[j] = squared_radius(words[2*j]);
+
+        _kernel::sqrt::finish(radius);
+
+        for (std::size_t j = 0; j < m; ++j)
+          _kernel::sincos<ratio<1, 4>>::lane(_random::canonical(words[2*j + 1]), sin[j], cos[j]);
+
+        for (std::size_t j = 0; j < m; ++j) {
+          y[i + 2*j] = Q(static_cast<value_type>(m_mean + m_stddev*radius[j]*cos[j]));
+          if (i + 2*j + 1 < n)
+            y[i + 2*j + 1] = Q(static_cast<value_type>(m_mean + m_stddev*radius[j]*sin[j]));
+        }
+      }
+
+      return std::span(y, n);
+    }
+
+  private:
+    double m_mean;
+    double m_stddev;
+    double m_next = 0;
+    bool m_spare = false;
+
+    static double squared_radius(const std::uint64_t u)
+    {return -2*_kernel::log::lane(_random::positive(u));}
+
+    void sample(const std::uint64_t u, const std::uint64_t v, double& x, double& y) const {
+      double sin, cos;
+      _kernel::sincos<ratio<1, 4>>::lane(_random::canonical(v), sin, cos);
+      const double r = std::sqrt(squared_radius(u));
+      x = m_mean + m_stddev*r*cos;
+      y = m_mean + m_stddev*r*sin;
+    }
+  };
+
+  template <concepts::quantity M, concepts::quantity_compatible<M> S>
+  normal_distribution(M, S) -> normal_distribution<
+    quantity<typename M::unit_type, _random::floating_t<typename M::value_type>>>;
+
+  // * number of events, given their expected number, as a rate times a time
+
+  // small means are sampled by inversion of the cumulative distribution, larger
+  // ones by the transformed rejection of hormann (PTRS), which takes about two
+  // uniform numbers per sample. both take a variable number of words, so batch
+  // fills draw samples one at a time
+  template <concepts::quantity Q>
+  requires std::is_integral_v<typename Q::value_type> && _random::count_unit<typename Q::unit_type>
+  class poisson_distribution {
+  public:
+    using result_type = Q;
+    using value_type = typename Q::value_type;
+
+    template <concepts::quantity C>
+    requires concepts::unit_compatible<typename C::unit_type, typename Q::unit_type>
+    explicit poisson_distribution(const C mean)
+    : m_mean(double(quantity<typename Q::unit_type, double>(mean).get_value()))
+    {
+      if (m_mean >= 10) {
+        m_log_mean = std::log(m_mean);
+        m_b = 0.931 + 2.53*std::sqrt(m_mean);
+        m_a = -0.059 + 0.02483*m_b;
+        m_log_alpha = std::log(1.1239 + 1.1328/(m_b - 3.4));
+        m_vr = 0.9277 - 3.6224/(m_b - 2);
+      } else {
+        m_exp_mean = std::exp(-m_mean);
+      }
+    }
+
+    quantity<typename Q::unit_type, double> mean() const
+    {return quantity<typename Q::unit_type, double>(m_mean);}
+
+    template <_random::word_generator G>
+    Q operator()(G& g) const
+    {return Q(static_cast<value_type>((m_mean >= 10)? rejection(g) : inversion(g)));}
+
+    template <_random::word_generator G, _math::_batch::output<Q> Out>
+    std::span<Q> operator()(G& g, Out&& out) const {
+      const auto n = std::size_t(std::ranges::size(out));
+      const auto y = std::ranges::data(out);
+
+      for (std::size_t i = 0; i < n; ++i)
+        y[i] = (*this)(g);
+
+      return std::span(y, n);
+    }
+
+  private:
+    double m_mean;
+    double m_exp_mean = 0;
+    double m_log_mean = 0;
+    double m_a = 0;
+    double m_b = 0;
+    double m_log_alpha = 0;
+    double m_vr = 0;
+
+    // the cumulative sum stops growing once its terms are below its ulp
+    template <class G>
+    double inversion(G& g) const {
+      const double u = _random::canonical(_random::word(g));
+
+      double k = 0, p = m_exp_mean, sum = p;
+      while (u >= sum && p > 0) {
+        p *= m_mean/++k;
+        sum += p;
+      }
+
+      return k;
+    }
+
+    template <class G>
+    double rejection(G& g) const {
+      for (;;) {
+        const double u = _random::canonical(_random::word(g)) - 0.5;
+        const double v = _random::positive(_random::word(g));
+        const double us = 0.5 - std::abs(u);
+        const double k = std::floor((2*m_a/us + m_b)*u + m_mean + 0.43);
+
+        if (us >= 0.07 && v <= m_vr)
+          return k;
+
+        if (k < 0 || (us < 0.013 && v > us))
+          continue;
+
+        if (std::log(v) + m_log_alpha - std::log(m_a/(us*us) + m_b) <= -m_mean + k*m_log_mean - std::lgamma(k + 1))
+          return k;
+      }
+    }
+  };
+
+  template <concepts::quantity C>
+  requires _random::count_unit<typename C::unit_type>
+  poisson_distribution(C) -> poisson_distribution<quantity<_random::events_t<typename C::unit_type>, long long>>;
+
+}
+
+namespace units {
+
+  // * random numbers
+
+  using _details::batch_engine;
+  using _details::exponential_distribution;
+  using _details::uniform_distribution;
+  using _details::normal_distribution;
+  using _details::poisson_distribution;
+
+}
+
+#endif
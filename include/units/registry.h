@@ -0,0 +1,48 @@
+#ifndef _include_units_registry_h
+#define _include_units_registry_h
+
+#include <units/angular.h>
+#include <units/framework.h>
+#include <units/units.h>
+
+namespace units {
+
+  // - lists of the units defined by the library
+
+  // * the SI base and derived units, along with the steradian and the decay count.
+  // * the gray has no name of its own, see units.h
+  using si_units = unit_list<
+    meter, second, kilogram, ampere, kelvin, mole, candela, steradian, decay,
+    hertz, newton, pascal, joule, watt, coulomb, volt, farad, ohm, siemens, weber,
+    tesla, henry, lumen, lux, becquerel, katal>;
+
+  // * units of length
+  using length_units = unit_list<
+    femtometer, picometer, nanometer, micrometer, millimeter, centimeter, decimeter,
+    decameter, hectometer, kilometer, megameter, gigameter, terameter, petameter,
+    exameter, angstrom, foot, thou, barleycorn, yard, chain, furlong, mile, league>;
+
+  // * units of time
+  using time_units = unit_list<
+    femtosecond, picosecond, nanosecond, microsecond, millisecond, centisecond,
+    decisecond, decasecond, hectosecond, kilosecond, megasecond, gigasecond,
+    terasecond, petasecond, exasecond, minute, hour, day, year>;
+
+  // * units of mass and energy
+  using mass_units = unit_list<gram, microgram, milligram, centigram, decigram>;
+  using energy_units = unit_list<electronvolt>;
+
+  // * units of angle
+  using angular_units = unit_list<radian, pi, degree, cycle, arcminute, arcsecond>;
+
+  using library_units = unit_list_cat<si_units, length_units, time_units, mass_units, energy_units, angular_units>;
+
+  // - registry of the units defined by the library
+
+  // units defined elsewhere are registered by listing them in another registry,
+  // for example unit_registry<unit_list_cat<library_units, unit_list<...>>>
+  using registry = unit_registry<library_units>;
+
+}
+
+#endif
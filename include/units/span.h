@@ -0,0 +1,115 @@
+#ifndef _include_units_span_h
+#define _include_units_span_h
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <version>
+
+#if defined(__cpp_lib_mdspan)
+#include <mdspan>
+#endif
+
+#include <units/details/quantity.h>
+#include <units/details/unit.h>
+
+namespace units::_details {
+
+  // - quantity type viewing a (possibly const) value of type V with unit U
+
+  namespace _span {
+    template <concepts::unit U, class V>
+    struct element_of {
+      using type = quantity<U, V>;
+    };
+
+    template <concepts::unit U, class V>
+    struct element_of<U, const V> {
+      using type = const quantity<U, V>;
+    };
+
+    template <concepts::unit U, class V>
+    using element = typename element_of<U, V>::type;
+
+    template <class Q, class V>
+    using value = std::conditional_t<std::is_const_v<Q>, const V, V>;
+  }
+
+  // - span of quantities over memory that is not owned by the span
+
+  // quantity_span<meter, const double> is a std::span<const meter_t<double>>
+  template <concepts::unit U, class V = double, std::size_t Extent = std::dynamic_extent>
+  requires concepts::arithmetic<std::remove_const_t<V>>
+  using quantity_span = std::span<_span::element<U, V>, Extent>;
+
+  // * view a buffer of raw values as quantities of unit U (no copies involved)
+
+  template <concepts::unit U, class V, std::size_t Extent>
+  requires concepts::arithmetic<std::remove_const_t<V>>
+  auto as_quantities(const std::span<V, Extent> values) {
+    using element_type = _span::element<U, V>;
+    static_assert(sizeof(element_type) == sizeof(V) && alignof(element_type) == alignof(V));
+    return quantity_span<U, V, Extent>(reinterpret_cast<element_type*>(values.data()), values.size());
+  }
+
+  template <concepts::unit U, class V>
+  requires concepts::arithmetic<std::remove_const_t<V>>
+  auto as_quantities(V* const data, const std::size_t size) {
+    return as_quantities<U>(std::span<V>(data, size));
+  }
+
+  // * view a buffer of quantities as its raw values (no copies involved)
+
+  template <class Q, std::size_t Extent>
+  requires concepts::quantity<Q>
+  auto as_values(const std::span<Q, Extent> quantities) {
+    using value_type = _span::value<Q, typename Q::value_type>;
+    return std::span<value_type, Extent>(reinterpret_cast<value_type*>(quantities.data()), quantities.size());
+  }
+
+  // - accessor policy presenting a buffer of raw values as quantities
+
+  // the data handle is a plain pointer to the raw values, so that an mdspan using
+  // this accessor can be constructed directly from the buffer of a numerical library
+  template <concepts::unit U, class V = double>
+  requires concepts::arithmetic<std::remove_const_t<V>>
+  struct quantity_accessor {
+    using offset_policy = quantity_accessor;
+    using element_type = _span::element<U, V>;
+    using reference = element_type&;
+    using data_handle_type = V*;
+
+    constexpr quantity_accessor() noexcept = default;
+
+    reference access(const data_handle_type p, const std::size_t i) const noexcept {
+      return reinterpret_cast<reference>(p[i]);
+    }
+
+    constexpr data_handle_type offset(const data_handle_type p, const std::size_t i) const noexcept {
+      return p + i;
+    }
+  };
+
+#if defined(__cpp_lib_mdspan)
+  // * multidimensional view of a buffer of raw values as quantities
+  template <concepts::unit U, class V, class Extents, class Layout = std::layout_right>
+  using quantity_mdspan = std::mdspan<_span::element<U, V>, Extents, Layout, quantity_accessor<U, V>>;
+#endif
+
+}
+
+namespace units {
+
+  // * zero-copy views of raw buffers
+
+  using _details::quantity_span;
+  using _details::as_quantities;
+  using _details::as_values;
+  using _details::quantity_accessor;
+#if defined(__cpp_lib_mdspan)
+  using _details::quantity_mdspan;
+#endif
+
+}
+
+#endif
@@ -42,6 +42,14 @@ namespace units {
   units_add_derived_unit(becquerel,  Bq, make_unit<decay, inverse<second>>);
   units_add_derived_unit(    katal, kat, make_unit<mole, inverse<second>>);
 
+  // the gray, and the sievert with the same dimension and factor, are the same type
+  // as m²/s²: they are given no name or symbol, which would be printed for squared
+  // velocities as well. the parser still recognizes their symbols
+  using gray = make_unit<joule, inverse<kilogram>>;
+  using sievert = gray;
+  units_set_literal(gray, Gy);
+  units_set_quantity_alias(gray);
+
   // - derived units
 
   // * units of length
@@ -75,6 +83,16 @@ namespace units {
 
   units_add_derived_unit(gram, g, make_unit<ratio<1, 1000>, kilogram>);
   units_set_prefixes(gram, g, micro, milli, centi, deci);
+
+  // * units of energy
+
+  units_add_derived_unit(electronvolt, eV, make_unit<ratio<1'602'176'634, 1'000'000'000'000'000'000>, ratio<1, 10'000'000'000>, joule>);
 }
 
+// - explicit instantiations of the compiled library, when it is linked
+
+#if defined(units_prebuilt)
+#include <units/details/prebuilt.h>
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef _modules_global_h
+#define _modules_global_h
+
+// the global module fragment shared by the module interfaces of the library.
+// every header included by the exported headers must be included here, before
+// the module declaration, so that it is not attached to the units modules
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cinttypes>
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <iosfwd>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+// macros are not exported by modules: importers that define their own units
+// include this header too
+#include <units/details/macros.h>
+
+// the namespace check of the macros cannot declare its dummy type again in the
+// purview of the modules, where only the library itself uses the macros
+#undef units_assert_namespace
+#define units_assert_namespace units_assert_namespace_lookup
+
+#endif
@@ -0,0 +1,40 @@
+module;
+#include "global.h"
+
+// - the angular units, and the trigonometric functions reduced in their native unit
+
+export module units.angular;
+
+export import units.framework;
+export import units.math;
+
+// the framework and math headers are provided by the imported modules (see units.si.cppm)
+#define _include_units_details_descriptor_h
+#define _include_units_details_fixed_h
+#define _include_units_details_power_h
+#define _include_units_details_quantity_h
+#define _include_units_details_ratio_h
+#define _include_units_details_registry_h
+#define _include_units_details_string_h
+#define _include_units_details_unit_h
+#define _include_units_framework_h
+#define _include_units_algorithm_h
+#define _include_units_details_kernels_h
+#define _include_units_details_simd_h
+#define _include_units_math_h
+
+export {
+  #include <units/angular.h>
+}
+
+// as in units.math
+export namespace units::math {
+  using _details::_math::sin;
+  using _details::_math::cos;
+  using _details::_math::tan;
+  using _details::_math::asin;
+  using _details::_math::acos;
+  using _details::_math::atan;
+  using _details::_math::atan2;
+  using _details::_math::sincos;
+}
@@ -0,0 +1,13 @@
+// - the units module, exporting the whole library
+//
+// the library is split in the named modules units.framework, units.si, units.math
+// and units.angular, which may be imported on their own. module partitions would
+// be the natural choice, but gcc 12 fails when they are exported by the primary
+// module interface
+
+export module units;
+
+export import units.framework;
+export import units.si;
+export import units.math;
+export import units.angular;
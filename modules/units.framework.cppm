@@ -0,0 +1,10 @@
+module;
+#include "global.h"
+
+// - the framework: units, quantities, ratios, descriptors and the unit registry
+
+export module units.framework;
+
+export {
+  #include <units/framework.h>
+}
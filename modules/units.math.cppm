@@ -0,0 +1,91 @@
+module;
+#include "global.h"
+
+// - the units::math functions, and their batch overloads
+
+export module units.math;
+
+export import units.framework;
+
+// the framework headers are provided by units.framework (see units.si.cppm)
+#define _include_units_details_descriptor_h
+#define _include_units_details_fixed_h
+#define _include_units_details_power_h
+#define _include_units_details_quantity_h
+#define _include_units_details_ratio_h
+#define _include_units_details_registry_h
+#define _include_units_details_string_h
+#define _include_units_details_unit_h
+#define _include_units_framework_h
+
+export {
+  #include <units/math.h>
+}
+
+// the using-directive of units::math is not exported, so the functions are declared
+// in units::math for the programs that import the module
+export namespace units::math {
+  using _details::_math::fmod;
+  using _details::_math::remainder;
+  using _details::_math::remquo;
+  using _details::_math::fma;
+  using _details::_math::fmax;
+  using _details::_math::fmin;
+  using _details::_math::max;
+  using _details::_math::min;
+  using _details::_math::fdim;
+  using _details::_math::nan;
+  using _details::_math::abs;
+  using _details::_math::div_t;
+  using _details::_math::ldiv_t;
+  using _details::_math::lldiv_t;
+  using _details::_math::div;
+  using _details::_math::exp;
+  using _details::_math::exp2;
+  using _details::_math::expm1;
+  using _details::_math::log;
+  using _details::_math::log10;
+  using _details::_math::log2;
+  using _details::_math::log1p;
+  using _details::_math::pow;
+  using _details::_math::sqrt;
+  using _details::_math::cbrt;
+  using _details::_math::hypot;
+  using _details::_math::sinh;
+  using _details::_math::cosh;
+  using _details::_math::tanh;
+  using _details::_math::asinh;
+  using _details::_math::acosh;
+  using _details::_math::atanh;
+  using _details::_math::erf;
+  using _details::_math::erfc;
+  using _details::_math::tgamma;
+  using _details::_math::lgamma;
+  using _details::_math::ceil;
+  using _details::_math::floor;
+  using _details::_math::trunc;
+  using _details::_math::round;
+  using _details::_math::nearbyint;
+  using _details::_math::rint;
+  using _details::_math::frexp;
+  using _details::_math::ldexp;
+  using _details::_math::modf;
+  using _details::_math::scalbn;
+  using _details::_math::ilogb;
+  using _details::_math::logb;
+  using _details::_math::nextafter;
+  using _details::_math::nexttoward;
+  using _details::_math::copysign;
+  using _details::_math::fpclassify;
+  using _details::_math::isfinite;
+  using _details::_math::isinf;
+  using _details::_math::isnan;
+  using _details::_math::isnormal;
+  using _details::_math::signbit;
+  using _details::_math::isgreater;
+  using _details::_math::isgreaterequal;
+  using _details::_math::isless;
+  using _details::_math::islessequal;
+  using _details::_math::islessgreater;
+  using _details::_math::isunordered;
+}
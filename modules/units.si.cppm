@@ -0,0 +1,25 @@
+module;
+#include "global.h"
+
+// - the units defined by the library, and their quantity aliases and literals
+
+export module units.si;
+
+export import units.framework;
+
+// declarations are imported from units.framework, but include guards are not:
+// they are defined here so that the framework headers are not included again,
+// which would attach a second copy of their declarations to this module
+#define _include_units_details_descriptor_h
+#define _include_units_details_fixed_h
+#define _include_units_details_power_h
+#define _include_units_details_quantity_h
+#define _include_units_details_ratio_h
+#define _include_units_details_registry_h
+#define _include_units_details_string_h
+#define _include_units_details_unit_h
+#define _include_units_framework_h
+
+export {
+  #include <units/units.h>
+}
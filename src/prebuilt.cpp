@@ -0,0 +1,8 @@
+// the definitions of the instantiations declared extern by units/details/prebuilt.h,
+// compiled once in libphys-units
+
+#include <units/details/prebuilt.h>
+
+namespace units {
+  FOR_EACH(units_instantiate_quantity, template, double, units_prebuilt_units)
+}
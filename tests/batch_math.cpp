@@ -0,0 +1,166 @@
+#include <units/math.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#define ASSERT_SAME(...) ASSERT_TRUE((std::is_same_v<__VA_ARGS__>))
+
+using namespace units;
+
+// distance, in units in the last place, between a result and a reference
+template <class T>
+double ulps(const T value, const T reference) {
+  if (std::isnan(reference))
+    return std::isnan(value)? 0 : std::numeric_limits<double>::infinity();
+  if (std::isinf(reference))
+    return (value == reference)? 0 : std::numeric_limits<double>::infinity();
+
+  const T ulp = std::nextafter(std::abs(reference), std::numeric_limits<T>::infinity()) - std::abs(reference);
+  return std::abs(double(value) - double(reference)) / double(ulp);
+}
+
+TEST(batchMath, squareRoot) {
+  using area_t = quantity<make_unit<squared<meter>>>;
+
+  // 37 elements: several full blocks and a partial one, whatever the vector width
+  std::vector<area_t> in(37);
+  for (std::size_t i = 0; i < in.size(); ++i)
+    in[i] = area_t(0.37 * i * i + 1.1);
+
+  std::vector<meter_t<>> out(in.size());
+  const auto written = math::sqrt(in, out);
+
+  ASSERT_EQ(written.size(), in.size());
+  for (std::size_t i = 0; i < in.size(); ++i)
+    ASSERT_EQ(out[i], math::sqrt(in[i]));
+
+  // the output unit is deduced as for single quantities
+  std::vector<area_t> few(3, area_t(16));
+  ASSERT_EQ(math::sqrt(few, out).size(), 3);
+  ASSERT_EQ(out[2].get_value(), 4);
+
+  // numbers: dimensionless quantities with a factor are converted first
+  std::vector<quantity<make_unit<ratio<1, 100>>, float>> percents(9, quantity<make_unit<ratio<1, 100>>, float>(25));
+  std::vector<float> roots(percents.size());
+
+  math::sqrt(percents, roots);
+  for (const auto r : roots)
+    ASSERT_FLOAT_EQ(r, 0.5f);
+}
+
+TEST(batchMath, hypotenuse) {
+  std::vector<meter_t<>> x;
+  std::vector<centimeter_t<>> y;
+
+  for (int i = -20; i < 21; ++i) {
+    x.emplace_back(0.731 * i);
+    y.emplace_back(113.3 * i * i - 7);
+  }
+
+  // extreme values are handled by std::hypot
+  x.emplace_back(1e300); y.emplace_back(1e302);
+  x.emplace_back(3e-310); y.emplace_back(4e-308);
+  x.emplace_back(std::numeric_limits<double>::infinity()); y.emplace_back(std::numeric_limits<double>::quiet_NaN());
+
+  std::vector<meter_t<>> out(x.size());
+  ASSERT_SAME(decltype(math::hypot(x[0], y[0])), meter_t<>);
+  ASSERT_EQ(math::hypot(x, y, out).size(), x.size());
+
+  for (std::size_t i = 0; i < x.size(); ++i)
+    ASSERT_LE(ulps(out[i].get_value(), math::hypot(x[i], y[i]).get_value()), 1.5) << i;
+}
+
+TEST(batchMath, exponentialAndLogarithm) {
+  std::vector<quantity<unit<one>>> in;
+
+  for (int i = 0; i < 2000; ++i)
+    in.emplace_back(-745.5 + 0.7463 * i);
+
+  for (const double v : {0.0, -0.0, 1e-310, -1e-310, 1e-30, 709.9, 710.0, -746.0})
+    in.emplace_back(v);
+
+  in.emplace_back(std::numeric_limits<double>::infinity());
+  in.emplace_back(-std::numeric_limits<double>::infinity());
+  in.emplace_back(std::numeric_limits<double>::quiet_NaN());
+
+  std::vector<double> out(in.size());
+
+  math::exp(in, out);
+  for (std::size_t i = 0; i < in.size(); ++i)
+    ASSERT_LE(ulps(out[i], std::exp(in[i].get_value())), 1) << in[i].get_value();
+
+  math::log(in, out);
+  for (std::size_t i = 0; i < in.size(); ++i)
+    ASSERT_LE(ulps(out[i], std::log(in[i].get_value())), 1) << in[i].get_value();
+
+  // logarithms over the whole range of positive numbers
+  std::vector<quantity<unit<one>>> positive;
+  for (double v = 1e-300; v < 1e300; v *= 1.0137)
+    positive.emplace_back(v);
+
+  std::vector<double> logs(positive.size());
+  math::log(positive, logs);
+  for (std::size_t i = 0; i < positive.size(); ++i)
+    ASSERT_LE(ulps(logs[i], std::log(positive[i].get_value())), 1) << positive[i].get_value();
+
+  // float values
+  std::vector<quantity<unit<one>, float>> small(50);
+  for (std::size_t i = 0; i < small.size(); ++i)
+    small[i] = quantity<unit<one>, float>(0.3f * i - 7.f);
+
+  std::vector<float> fout(small.size());
+  math::exp(small, fout);
+  for (std::size_t i = 0; i < small.size(); ++i)
+    ASSERT_LE(ulps(fout[i], std::exp(small[i].get_value())), 1);
+}
+
+TEST(batchMath, elementwise) {
+  std::vector<meter_t<>> in;
+  for (int i = -10; i < 10; ++i)
+    in.emplace_back(0.75 * i);
+
+  std::vector<meter_t<>> out(in.size());
+
+  math::floor(in, out);
+  for (std::size_t i = 0; i < in.size(); ++i)
+    ASSERT_EQ(out[i], math::floor(in[i]));
+
+  math::abs(in, out);
+  for (std::size_t i = 0; i < in.size(); ++i)
+    ASSERT_EQ(out[i], math::abs(in[i]));
+
+  math::fmod(in, centimeter_t<>(40), out);
+  for (std::size_t i = 0; i < in.size(); ++i)
+    ASSERT_NEAR(out[i].get_value(), math::fmod(in[i], centimeter_t<>(40)).get_value(), 1e-12);
+
+  std::vector<quantity<make_unit<power<meter, 3>>>> cubes(in.size());
+  math::pow<3>(in, cubes);
+  for (std::size_t i = 0; i < in.size(); ++i)
+    ASSERT_EQ(cubes[i], math::pow<3>(in[i]));
+
+  // integral quantities go through the scalar functions
+  std::vector<second_t<int>> ticks = {second_t<int>(-3), second_t<int>(4)};
+  std::vector<second_t<int>> magnitudes(ticks.size());
+  math::abs(ticks, magnitudes);
+  ASSERT_EQ(magnitudes[0].get_value(), 3);
+}
+
+// units::math is a namespace, to which programs may add functions
+namespace units::math {
+  constexpr auto twice(const concepts::quantity auto q) {return 2*q;}
+}
+
+TEST(batchMath, mathNamespace) {
+  ASSERT_EQ(math::twice(meter_t<int>(2)), meter_t<int>(4));
+  ASSERT_EQ(math::sqrt(quantity<make_unit<squared<meter>>>(4)), meter_t<>(2));
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,217 @@
+#include <units/columnar.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <vector>
+
+using namespace units;
+
+namespace {
+  // a file in the temporary directory, removed when going out of scope
+  struct temporary_file {
+    std::filesystem::path path;
+
+    temporary_file(const char* name)
+    : path(std::filesystem::temp_directory_path() / name) {}
+
+    ~temporary_file() {std::filesystem::remove(path);}
+  };
+
+  bool write_file(const std::filesystem::path& path, const std::vector<char>& bytes) {
+    const auto file = std::fopen(path.c_str(), "wb");
+    const bool ok = file && std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return file && std::fclose(file) == 0 && ok;
+  }
+
+  std::vector<char> read_file(const std::filesystem::path& path) {
+    std::vector<char> bytes(std::filesystem::file_size(path));
+    const auto file = std::fopen(path.c_str(), "rb");
+    if (!file || std::fread(bytes.data(), 1, bytes.size(), file) != bytes.size())
+      bytes.clear();
+    if (file)
+      std::fclose(file);
+    return bytes;
+  }
+}
+
+TEST(columnar, roundTrip) {
+  const temporary_file file("phys-units-columnar-round-trip.bin");
+
+  std::vector<meter_t<>> position(1000);
+  std::vector<quantity<make_unit<kilometer, inverse<hour>>, float>> speed(333);
+  std::vector<second_t<std::int64_t>> time(7);
+
+  for (std::size_t i = 0; i < position.size(); ++i)
+    position[i] = meter_t<>(0.5 * i);
+  for (std::size_t i = 0; i < speed.size(); ++i)
+    speed[i].set_value(3.6f * i);
+  for (std::size_t i = 0; i < time.size(); ++i)
+    time[i] = second_t<std::int64_t>(90 * i);
+
+  column_writer writer;
+  ASSERT_TRUE(writer.add("position", position));
+  ASSERT_TRUE(writer.add("speed", speed));
+  ASSERT_TRUE(writer.add("time", time));
+  ASSERT_FALSE(writer.add("time", time));
+  ASSERT_TRUE(writer.write(file.path));
+
+  const auto reader = column_file::open(file.path);
+  ASSERT_TRUE(reader.has_value());
+  ASSERT_EQ(reader->size(), 3);
+
+  const auto info = reader->info("speed");
+  ASSERT_TRUE(info.has_value());
+  ASSERT_EQ(info->size, speed.size());
+  ASSERT_EQ(info->unit, (descriptor_of<make_unit<kilometer, inverse<hour>>>));
+  ASSERT_FALSE(reader->info("mass").has_value());
+
+  // units and value types match: views point into the mapped file
+  const auto view = reader->view<meter>("position");
+  ASSERT_TRUE(view.has_value());
+  ASSERT_EQ(view->size(), position.size());
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(view->data()) % 64, 0);
+  for (std::size_t i = 0; i < position.size(); ++i)
+    ASSERT_EQ((*view)[i], position[i]);
+
+  // no views for different units or value types
+  ASSERT_FALSE(reader->view<kilometer>("position").has_value());
+  ASSERT_FALSE((reader->view<meter, float>("position").has_value()));
+  ASSERT_FALSE(reader->view<meter>("unknown").has_value());
+}
+
+TEST(columnar, conversion) {
+  const temporary_file file("phys-units-columnar-conversion.bin");
+
+  std::vector<quantity<make_unit<kilometer, inverse<hour>>, float>> speed(100);
+  std::vector<second_t<std::int64_t>> time(50);
+
+  for (std::size_t i = 0; i < speed.size(); ++i)
+    speed[i].set_value(3.6f * i);
+  for (std::size_t i = 0; i < time.size(); ++i)
+    time[i] = second_t<std::int64_t>(90 * i);
+
+  column_writer writer;
+  writer.add("speed", speed);
+  writer.add("time", time);
+  ASSERT_TRUE(writer.write(file.path));
+
+  const auto reader = column_file::open(file.path);
+  ASSERT_TRUE(reader.has_value());
+
+  std::vector<quantity<make_unit<meter, inverse<second>>>> ms(speed.size());
+  ASSERT_TRUE(reader->read("speed", ms));
+  for (std::size_t i = 0; i < ms.size(); ++i)
+    ASSERT_NEAR(ms[i].get_value(), i, 1e-5 * i);
+
+  std::vector<millisecond_t<std::int64_t>> msec(time.size());
+  std::vector<minute_t<std::int64_t>> min(time.size());
+  ASSERT_TRUE(reader->read("time", msec));
+  ASSERT_TRUE(reader->read("time", min));
+  for (std::size_t i = 0; i < time.size(); ++i) {
+    ASSERT_EQ(msec[i].get_value(), 90'000 * static_cast<std::int64_t>(i));
+    ASSERT_EQ(min[i].get_value(), (90 * static_cast<std::int64_t>(i)) / 60);
+  }
+
+  // incompatible units and mismatched sizes
+  std::vector<meter_t<>> wrong(time.size());
+  ASSERT_FALSE(reader->read("time", wrong));
+  msec.resize(3);
+  ASSERT_FALSE(reader->read("time", msec));
+}
+
+TEST(columnar, overflow) {
+  const temporary_file file("phys-units-columnar-overflow.bin");
+
+  const std::vector<kilometer_t<std::int32_t>> km = {kilometer_t<std::int32_t>(1), kilometer_t<std::int32_t>(3'000'000)};
+  const std::vector<meter_t<double>> m = {meter_t<double>(1.5), meter_t<double>(1e12)};
+  const std::vector<meter_t<double>> nan = {meter_t<double>(std::numeric_limits<double>::quiet_NaN())};
+
+  column_writer writer;
+  writer.add("km", km);
+  writer.add("m", m);
+  writer.add("nan", nan);
+  ASSERT_TRUE(writer.write(file.path));
+
+  const auto reader = column_file::open(file.path);
+  ASSERT_TRUE(reader.has_value());
+
+  // integral values that overflow once scaled
+  std::vector<meter_t<std::int32_t>> m32(km.size());
+  std::vector<meter_t<std::int64_t>> m64(km.size());
+  ASSERT_FALSE(reader->read("km", m32));
+  ASSERT_EQ(m32[0], meter_t<std::int32_t>(1000));
+  ASSERT_TRUE(reader->read("km", m64));
+  ASSERT_EQ(m64[1], meter_t<std::int64_t>(3'000'000'000));
+
+  // floating-point values out of the range of an integral type, or nan
+  std::vector<meter_t<std::int32_t>> truncated(m.size());
+  std::vector<millimeter_t<std::int64_t>> mm(m.size());
+  std::vector<meter_t<std::int32_t>> none(nan.size());
+  ASSERT_FALSE(reader->read("m", truncated));
+  ASSERT_EQ(truncated[0], meter_t<std::int32_t>(1));
+  ASSERT_TRUE(reader->read("m", mm));
+  ASSERT_EQ(mm[1], millimeter_t<std::int64_t>(1'000'000'000'000'000));
+  ASSERT_FALSE(reader->read("nan", none));
+}
+
+TEST(columnar, malformedFiles) {
+  const temporary_file file("phys-units-columnar-malformed.bin");
+
+  ASSERT_FALSE(column_file::open(file.path).has_value());
+
+  ASSERT_TRUE(write_file(file.path, {'n', 'o', 't', ' ', 'a', ' ', 'f', 'i', 'l', 'e'}));
+  ASSERT_FALSE(column_file::open(file.path).has_value());
+
+  // truncate a valid file in the middle of its values
+  std::vector<meter_t<>> values(100);
+  column_writer writer;
+  writer.add("values", values);
+  ASSERT_TRUE(writer.write(file.path));
+  ASSERT_TRUE(column_file::open(file.path).has_value());
+
+  std::filesystem::resize_file(file.path, std::filesystem::file_size(file.path) - 64);
+  ASSERT_FALSE(column_file::open(file.path).has_value());
+}
+
+TEST(columnar, corruptedFactors) {
+  using header = _details::_columnar::file_header;
+  using column = _details::_columnar::column_header;
+
+  const temporary_file file("phys-units-columnar-factors.bin");
+
+  std::vector<kilometer_t<>> values(10, kilometer_t<>(1));
+  column_writer writer;
+  writer.add("values", values);
+  ASSERT_TRUE(writer.write(file.path));
+
+  const auto bytes = read_file(file.path);
+  ASSERT_FALSE(bytes.empty());
+
+  // the factor of the first column, whose numerator or denominator are overwritten
+  const auto corrupt = [&](const std::size_t offset, const std::int64_t value) {
+    auto copy = bytes;
+    const std::uint64_t halves[2] = {std::uint64_t(value), value < 0? ~std::uint64_t(0) : 0};
+    std::memcpy(copy.data() + sizeof(header) + offset, halves, sizeof(halves));
+    return write_file(file.path, copy) && !column_file::open(file.path).has_value();
+  };
+
+  ASSERT_TRUE(corrupt(offsetof(column, num), 0));
+  ASSERT_TRUE(corrupt(offsetof(column, num), -1000));
+  ASSERT_TRUE(corrupt(offsetof(column, den), 0));
+  ASSERT_TRUE(corrupt(offsetof(column, den), -1));
+
+  ASSERT_TRUE(write_file(file.path, bytes));
+  ASSERT_TRUE(column_file::open(file.path).has_value());
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,99 @@
+#include <units/atomic.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace units;
+
+namespace units {
+  units_set_prefixes(electronvolt, eV, kilo, mega);
+}
+
+template <class A, class Q>
+concept can_add = requires (A& a, const Q q) {a.fetch_add(q);};
+
+TEST(concurrency, atomicQuantity) {
+  std::atomic<meter_t<>> length(meter_t<>(1));
+  static_assert(std::atomic<meter_t<>>::is_always_lock_free);
+  static_assert(sizeof(std::atomic<meter_t<>>) == sizeof(double));
+
+  // compatible quantities are converted to the unit of the atomic
+  ASSERT_EQ(length.fetch_add(kilometer_t<>(2)), meter_t<>(1));
+  ASSERT_EQ(length.load(), meter_t<>(2001));
+  ASSERT_EQ((length -= millimeter_t<>(1000)), meter_t<>(2000));
+  ASSERT_EQ((length += meter_t<int>(5)).get_value(), 2005);
+
+  ASSERT_EQ(length.exchange(meter_t<>(3)), meter_t<>(2005));
+  meter_t<> expected(4);
+  ASSERT_FALSE(length.compare_exchange_strong(expected, meter_t<>(5)));
+  ASSERT_EQ(expected, meter_t<>(3));
+  ASSERT_TRUE(length.compare_exchange_strong(expected, meter_t<>(5)));
+  ASSERT_EQ(meter_t<>(length), meter_t<>(5));
+
+  // integral atomics accept the quantities whose conversion stays integral
+  std::atomic<electronvolt_t<std::int64_t>> energy;
+  energy.fetch_add(kiloelectronvolt_t<std::int64_t>(3));
+  energy += electronvolt_t<int>(7);
+  ASSERT_EQ(energy.load().get_value(), 3007);
+
+  static_assert(can_add<std::atomic<electronvolt_t<std::int64_t>>, megaelectronvolt_t<int>>);
+  static_assert(!can_add<std::atomic<kiloelectronvolt_t<std::int64_t>>, electronvolt_t<int>>);
+  static_assert(!can_add<std::atomic<meter_t<>>, second_t<>>);
+}
+
+TEST(concurrency, concurrentAtomic) {
+  std::atomic<electronvolt_t<std::int64_t>> energy;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t)
+    threads.emplace_back([&]{
+      for (int i = 0; i < 10000; ++i)
+        energy.fetch_add(kiloelectronvolt_t<std::int64_t>(1), std::memory_order_relaxed);
+    });
+
+  for (auto& t : threads)
+    t.join();
+
+  ASSERT_EQ(energy.load().get_value(), 8*10000*1000);
+}
+
+TEST(concurrency, shardedAccumulator) {
+  sharded_accumulator<kiloelectronvolt_t<std::int64_t>> deposits(5);
+  ASSERT_EQ(deposits.shards(), 8);
+  ASSERT_EQ(deposits.load().get_value(), 0);
+
+  // more threads than shards: some of them share a shard
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 12; ++t)
+    threads.emplace_back([&, t]{
+      for (int i = 0; i < 10000; ++i) {
+        deposits.add(kiloelectronvolt_t<std::int64_t>(t));
+        deposits += megaelectronvolt_t<int>(1);
+      }
+    });
+
+  for (auto& t : threads)
+    t.join();
+
+  ASSERT_EQ(deposits.load().get_value(), 10000*(66 + 12*1000));
+  ASSERT_EQ(deposits.exchange().get_value(), 10000*(66 + 12*1000));
+  ASSERT_EQ(kiloelectronvolt_t<std::int64_t>(deposits).get_value(), 0);
+
+  // floating-point accumulators accept any compatible quantity
+  sharded_accumulator<joule_t<>> heat;
+  heat += joule_t<>(1.5);
+  heat += quantity<make_unit<kilo, joule>, int>(2);
+  ASSERT_EQ(heat.load(), joule_t<>(2001.5));
+  heat.reset();
+  ASSERT_EQ(heat.load(), joule_t<>(0));
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,184 @@
+#include <units/algorithm.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace units;
+
+TEST(batchConversion, floatingPoint) {
+  std::vector<nanosecond_t<>> ns(37);
+  std::vector<second_t<>> s(ns.size());
+
+  for (std::size_t i = 0; i < ns.size(); ++i)
+    ns[i] = nanosecond_t<>(1.5e9 * i);
+
+  const auto written = convert_into(ns, s);
+
+  ASSERT_EQ(written.size(), ns.size());
+  for (std::size_t i = 0; i < s.size(); ++i)
+    ASSERT_DOUBLE_EQ(s[i].get_value(), 1.5 * i);
+
+  std::array<kilometer_t<float>, 11> km;
+  std::array<meter_t<float>, 11> m;
+
+  for (std::size_t i = 0; i < km.size(); ++i)
+    km[i] = kilometer_t<float>(0.25f * i);
+
+  ASSERT_EQ(convert_n(km.data(), km.size(), m.data()), m.data() + m.size());
+  for (std::size_t i = 0; i < m.size(); ++i)
+    ASSERT_FLOAT_EQ(m[i].get_value(), 250.f * i);
+}
+
+TEST(batchConversion, integral) {
+  std::vector<second_t<std::int64_t>> s(21);
+  std::vector<millisecond_t<std::int64_t>> ms(s.size());
+  std::vector<minute_t<std::int64_t>> min(s.size());
+
+  for (std::size_t i = 0; i < s.size(); ++i)
+    s[i] = second_t<std::int64_t>(50 * i);
+
+  convert_into(s, ms);
+  convert_into(s, min);
+
+  for (std::size_t i = 0; i < s.size(); ++i) {
+    ASSERT_EQ(ms[i].get_value(), 50'000 * static_cast<std::int64_t>(i));
+    ASSERT_EQ(min[i].get_value(), (50 * static_cast<std::int64_t>(i)) / 60);
+  }
+
+  // mixed value types and a general (non-integral, non-unit) factor
+  std::vector<foot_t<int>> ft(5, foot_t<int>(1000));
+  std::vector<meter_t<>> m(ft.size());
+  std::vector<yard_t<int>> yd(ft.size());
+
+  convert_into(ft, m);
+  convert_into(ft, yd);
+
+  for (std::size_t i = 0; i < ft.size(); ++i) {
+    ASSERT_DOUBLE_EQ(m[i].get_value(), 304.8);
+    ASSERT_EQ(yd[i].get_value(), 333);
+  }
+}
+
+TEST(batchConversion, sizes) {
+  std::vector<meter_t<>> m(10, meter_t<>(1));
+  std::vector<centimeter_t<>> cm(4);
+
+  const auto written = convert_into(m, cm);
+
+  ASSERT_EQ(written.size(), cm.size());
+  ASSERT_EQ(written.data(), cm.data());
+  ASSERT_DOUBLE_EQ(cm.back().get_value(), 100);
+}
+
+TEST(integralConversion, promotion) {
+  // without policies, non-integral factors still promote to long double
+  const auto min = second_t<int>(90).convert<minute>();
+
+  ASSERT_TRUE((std::is_same_v<decltype(min)::value_type, long double>));
+  ASSERT_DOUBLE_EQ(min.get_value(), 1.5);
+}
+
+TEST(integralConversion, rounding) {
+  using std::int64_t;
+
+  ASSERT_EQ((nanosecond_t<int64_t>(2'499'999'999).convert<second, rounding::truncate>().get_value()), 2);
+  ASSERT_EQ((nanosecond_t<int64_t>(2'499'999'999).convert<second, rounding::nearest>().get_value()), 2);
+  ASSERT_EQ((nanosecond_t<int64_t>(2'500'000'000).convert<second, rounding::nearest>().get_value()), 3);
+  ASSERT_EQ((nanosecond_t<int64_t>(-2'500'000'000).convert<second, rounding::nearest>().get_value()), -3);
+  ASSERT_EQ((nanosecond_t<int64_t>(-2'999'999'999).convert<second, rounding::truncate>().get_value()), -2);
+
+  // general factors: 1 ft = 1/3 yd, 1 yd = 0.9144 m
+  ASSERT_EQ((foot_t<int>(1001).convert<yard, rounding::truncate>().get_value()), 333);
+  ASSERT_EQ((foot_t<int>(1001).convert<yard, rounding::nearest>().get_value()), 334);
+  ASSERT_EQ((yard_t<int>(-1000).convert<meter, rounding::nearest>().get_value()), -914);
+  ASSERT_EQ((yard_t<unsigned>(1000).convert<centimeter, rounding::truncate>().get_value()), 91440u);
+
+  // exact for the whole range of 64-bit integers
+  const auto big = std::numeric_limits<int64_t>::max();
+  ASSERT_EQ((nanosecond_t<int64_t>(big).convert<microsecond, rounding::truncate>().get_value()), big/1000);
+  ASSERT_EQ((minute_t<int64_t>(big/60).convert<second, rounding::truncate>().get_value()), (big/60)*60);
+  ASSERT_EQ((foot_t<int64_t>(big).convert<yard, rounding::truncate>().get_value()), big/3);
+}
+
+TEST(integralConversion, overflow) {
+  using std::int16_t;
+
+  const auto km = kilometer_t<int16_t>(100);
+
+  ASSERT_EQ((km.convert<meter, rounding::truncate, overflow::saturate>().get_value()), std::numeric_limits<int16_t>::max());
+  ASSERT_EQ(((-km).convert<meter, rounding::truncate, overflow::saturate>().get_value()), std::numeric_limits<int16_t>::min());
+  ASSERT_EQ((kilometer_t<int16_t>(32).convert<meter, rounding::truncate, overflow::saturate>().get_value()), 32000);
+
+  ASSERT_FALSE((km.convert<meter, rounding::truncate, overflow::checked>()));
+  ASSERT_EQ((kilometer_t<int16_t>(32).convert<meter, rounding::truncate, overflow::checked>()->get_value()), 32000);
+
+  const auto s = second_t<std::int64_t>(std::numeric_limits<std::int64_t>::max()/100);
+  ASSERT_FALSE((s.convert<millisecond, rounding::truncate, overflow::checked>()));
+  ASSERT_TRUE((s.convert<centisecond, rounding::truncate, overflow::checked>()));
+
+  // factors that do not fit in 64 bits, whose products with values overflow intm_t
+  const auto em = exameter_t<std::int64_t>(1'000'000);
+  ASSERT_FALSE((em.convert<femtometer, rounding::truncate, overflow::checked>()));
+  ASSERT_EQ((em.convert<femtometer, rounding::truncate, overflow::saturate>().get_value()), std::numeric_limits<std::int64_t>::max());
+  ASSERT_EQ(((-em).convert<femtometer, rounding::truncate, overflow::saturate>().get_value()), std::numeric_limits<std::int64_t>::min());
+}
+
+TEST(integralConversion, conversionOperator) {
+  // the conversion operator, used to copy-initialize quantities of another type
+
+  // integral to integral: scaled exactly and truncated, as convert<U, rounding::truncate>
+  const kilometer_t<int> km = meter_t<int>(1999);
+  const kilometer_t<int> negative_km = meter_t<int>(-1999);
+  const yard_t<int> yd = foot_t<int>(1001);
+  const meter_t<std::int64_t> m = kilometer_t<int>(3'000'000);
+  const microsecond_t<std::int64_t> us = nanosecond_t<std::int64_t>(std::numeric_limits<std::int64_t>::max());
+
+  ASSERT_EQ(km.get_value(), 1);
+  ASSERT_EQ(negative_km.get_value(), -1);
+  ASSERT_EQ(yd.get_value(), 333);
+  ASSERT_EQ(m.get_value(), 3'000'000'000);
+  ASSERT_EQ(us.get_value(), std::numeric_limits<std::int64_t>::max()/1000);
+
+  // floating point to integral: scaled in floating point, then truncated
+  const kilometer_t<int> truncated_km = meter_t<>(1999.);
+  const meter_t<int> scaled_m = kilometer_t<>(1.5);
+
+  ASSERT_EQ(truncated_km.get_value(), 1);
+  ASSERT_EQ(scaled_m.get_value(), 1500);
+
+  // integral to floating point: scaled by the factor in the requested type
+  const meter_t<> ft = foot_t<int>(1);
+  const kilometer_t<float> float_km = meter_t<int>(1500);
+
+  ASSERT_DOUBLE_EQ(ft.get_value(), 0.3048);
+  ASSERT_FLOAT_EQ(float_km.get_value(), 1.5f);
+}
+
+TEST(integralConversion, batch) {
+  std::vector<nanosecond_t<std::int64_t>> ns = {
+    nanosecond_t<std::int64_t>(1'499), nanosecond_t<std::int64_t>(1'500), nanosecond_t<std::int64_t>(-1'500)};
+  std::vector<microsecond_t<std::int64_t>> us(ns.size());
+
+  convert_into<rounding::nearest>(ns, us);
+
+  ASSERT_EQ(us[0].get_value(), 1);
+  ASSERT_EQ(us[1].get_value(), 2);
+  ASSERT_EQ(us[2].get_value(), -2);
+
+  std::vector<meter_t<std::int32_t>> m(3, meter_t<std::int32_t>(100'000));
+  std::vector<millimeter_t<std::int16_t>> mm(m.size());
+
+  convert_n<rounding::truncate, overflow::saturate>(m.data(), m.size(), mm.data());
+
+  ASSERT_EQ(mm[0].get_value(), std::numeric_limits<std::int16_t>::max());
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
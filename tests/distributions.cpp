@@ -0,0 +1,171 @@
+#include <units/random.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace units;
+
+namespace units {
+  units_set_prefixes(electronvolt, eV, kilo);
+  units_set_prefixes(becquerel, Bq, kilo);
+}
+
+// * mean and variance of the values of a range of quantities
+template <class R>
+std::pair<double, double> moments(const R& samples) {
+  double sum = 0, squares = 0;
+  for (const auto x : samples) {
+    sum += double(x.get_value());
+    squares += double(x.get_value())*double(x.get_value());
+  }
+
+  const double mean = sum/double(samples.size());
+  return {mean, squares/double(samples.size()) - mean*mean};
+}
+
+TEST(distributions, engine) {
+  static_assert(std::uniform_random_bit_generator<batch_engine>);
+
+  batch_engine a(42), b(42);
+  ASSERT_EQ(a, b);
+  ASSERT_NE(batch_engine(42)(), batch_engine(43)());
+
+  // words written in blocks are those handed out one at a time
+  std::vector<std::uint64_t> words(37);
+  b();
+  b.generate(words.data(), 3);
+  b.generate(words.data() + 3, 34);
+
+  a();
+  for (const auto w : words)
+    ASSERT_EQ(w, a());
+  ASSERT_EQ(a, b);
+}
+
+TEST(distributions, exponential) {
+  // decay times from an activity
+  const exponential_distribution t(becquerel_t<double>(250));
+  static_assert(std::is_same_v<decltype(t)::result_type, second_t<double>>);
+  ASSERT_DOUBLE_EQ(t.mean().get_value(), 0.004);
+
+  // any compatible unit, for the rate and for the samples
+  const exponential_distribution<millisecond_t<double>> ms(kilobecquerel_t<double>(0.25));
+  ASSERT_DOUBLE_EQ(ms.mean().get_value(), 4);
+  static_assert(std::is_same_v<decltype(exponential_distribution(hertz_t<int>(2)))::result_type, second_t<double>>);
+  static_assert(std::is_constructible_v<exponential_distribution<meter_t<double>>, quantity<make_unit<inverse<meter>>, double>>);
+  static_assert(!std::is_constructible_v<exponential_distribution<meter_t<double>>, becquerel_t<double>>);
+
+  batch_engine rng(1);
+  std::vector<millisecond_t<double>> samples(100001);
+  ASSERT_EQ(ms(rng, samples).size(), samples.size());
+
+  const auto [mean, variance] = moments(samples);
+  ASSERT_NEAR(mean, 4, 0.05);
+  ASSERT_NEAR(variance, 16, 0.5);
+
+  for (const auto x : samples)
+    ASSERT_GT(x.get_value(), 0);
+
+  // single samples, from a standard generator of 32-bit words
+  std::mt19937 mt(3);
+  double sum = 0;
+  for (int i = 0; i < 100000; ++i)
+    sum += t(mt).get_value();
+  ASSERT_NEAR(sum/100000, 0.004, 0.00005);
+}
+
+TEST(distributions, uniform) {
+  const uniform_distribution x(centimeter_t<double>(10), meter_t<double>(2));
+  static_assert(std::is_same_v<decltype(x)::result_type, centimeter_t<double>>);
+  ASSERT_EQ(x.b(), centimeter_t<double>(200));
+
+  std::mt19937_64 rng(5);
+  std::vector<centimeter_t<double>> samples(10000);
+  x(rng, samples);
+
+  for (const auto s : samples) {
+    ASSERT_GE(s.get_value(), 10);
+    ASSERT_LT(s.get_value(), 200);
+  }
+
+  const auto [mean, variance] = moments(samples);
+  ASSERT_NEAR(mean, 105, 1.5);
+  ASSERT_NEAR(variance, 190*190/12.0, 60);
+
+  // batches and single samples are the same numbers
+  batch_engine a(9), b(9);
+  const uniform_distribution<meter_t<float>> y(meter_t<double>(-1), meter_t<double>(1));
+  std::vector<meter_t<float>> batch(70);
+  y(a, batch);
+  for (const auto s : batch)
+    ASSERT_EQ(s, y(b));
+}
+
+TEST(distributions, normal) {
+  normal_distribution energy(kiloelectronvolt_t<double>(511), electronvolt_t<double>(1500));
+  static_assert(std::is_same_v<decltype(energy)::result_type, kiloelectronvolt_t<double>>);
+  ASSERT_EQ(energy.stddev(), kiloelectronvolt_t<double>(1.5));
+
+  batch_engine rng(11);
+  std::vector<kiloelectronvolt_t<double>> samples(100001);
+  energy(rng, samples);
+
+  const auto [mean, variance] = moments(samples);
+  ASSERT_NEAR(mean, 511, 0.02);
+  ASSERT_NEAR(variance, 2.25, 0.04);
+
+  std::size_t within = 0;
+  for (const auto s : samples)
+    within += std::abs(s.get_value() - 511) < 1.5;
+  ASSERT_NEAR(double(within)/double(samples.size()), 0.6827, 0.005);
+
+  // single samples come in the same pairs
+  batch_engine a(13), b(13);
+  std::vector<kiloelectronvolt_t<double>> pairs(6);
+  energy(a, pairs);
+  for (const auto s : pairs)
+    ASSERT_DOUBLE_EQ(s.get_value(), energy(b).get_value());
+}
+
+TEST(distributions, poisson) {
+  // decays in a time window, from an activity
+  const poisson_distribution n(becquerel_t<double>(3) * second_t<double>(1));
+  static_assert(std::is_same_v<decltype(n)::result_type, quantity<decay, long long>>);
+  ASSERT_DOUBLE_EQ(n.mean().get_value(), 3);
+
+  const poisson_distribution<quantity<decay, int>> large(kilobecquerel_t<double>(2) * millisecond_t<double>(50));
+  ASSERT_DOUBLE_EQ(large.mean().get_value(), 100);
+  static_assert(!std::is_constructible_v<poisson_distribution<quantity<decay, int>>, second_t<double>>);
+
+  batch_engine rng(17);
+
+  std::vector<quantity<decay, long long>> small_samples(100000);
+  n(rng, small_samples);
+  const auto [small_mean, small_variance] = moments(small_samples);
+  ASSERT_NEAR(small_mean, 3, 0.03);
+  ASSERT_NEAR(small_variance, 3, 0.06);
+
+  std::vector<quantity<decay, int>> large_samples(100000);
+  large(rng, large_samples);
+  const auto [large_mean, large_variance] = moments(large_samples);
+  ASSERT_NEAR(large_mean, 100, 0.2);
+  ASSERT_NEAR(large_variance, 100, 2);
+
+  for (const auto k : large_samples)
+    ASSERT_GE(k.get_value(), 0);
+
+  // dimensionless counts
+  const poisson_distribution<quantity<make_unit<>, int>> none(quantity<make_unit<>, double>(0));
+  ASSERT_EQ(none(rng).get_value(), 0);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
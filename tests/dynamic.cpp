@@ -0,0 +1,165 @@
+#include <units/dynamic.h>
+#include <units/parser.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+using namespace units;
+
+TEST(dynamicQuantity, construction) {
+  const dynamic_quantity a(kilometer_t<>(2));
+  const dynamic_quantity b(3.5, *parse_unit("km"));
+
+  ASSERT_TRUE(a.valid());
+  ASSERT_EQ(a.get_value(), 2);
+  ASSERT_EQ(a.get_unit(), b.get_unit());
+  ASSERT_EQ(b.get_unit(), descriptor_of<kilometer>);
+
+  // default constructed quantities are dimensionless
+  ASSERT_TRUE(dynamic_quantity<>().get_unit().dim.dimensionless());
+  ASSERT_FALSE(dynamic_quantity(1.0, unit_descriptor::invalid()).valid());
+}
+
+TEST(dynamicQuantity, arithmetic) {
+  const dynamic_quantity km(kilometer_t<>(1.5));
+  const dynamic_quantity m(meter_t<>(500));
+  const dynamic_quantity h(hour_t<>(2));
+
+  const auto sum = km + m;
+  ASSERT_TRUE(sum.valid());
+  ASSERT_EQ(sum.get_unit(), descriptor_of<kilometer>);
+  ASSERT_DOUBLE_EQ(sum.get_value(), 2);
+  ASSERT_DOUBLE_EQ((m - km).get_value(), -1000);
+
+  const auto speed = (km + m) / h;
+  ASSERT_EQ(speed.get_unit(), (descriptor_of<make_unit<kilometer, inverse<hour>>>));
+  ASSERT_DOUBLE_EQ(speed.get_value(), 1);
+
+  ASSERT_DOUBLE_EQ((2 * km * 3).get_value(), 9);
+  ASSERT_DOUBLE_EQ((km / 3.).get_value(), 0.5);
+
+  auto x = m;
+  x += km;
+  x *= 2;
+  ASSERT_DOUBLE_EQ(x.get_value(), 4000);
+  x /= h;
+  ASSERT_EQ(x.get_unit(), (descriptor_of<make_unit<meter, inverse<hour>>>));
+}
+
+TEST(dynamicQuantity, invalidPropagation) {
+  const dynamic_quantity m(meter_t<>(1));
+  const dynamic_quantity s(second_t<>(1));
+
+  const auto bad = m + s;
+  ASSERT_FALSE(bad.valid());
+  ASSERT_TRUE(std::isnan(bad.get_value()));
+
+  // once invalid, results of all further operations are invalid
+  ASSERT_FALSE((bad * m).valid());
+  ASSERT_FALSE((bad / s + m).valid());
+  ASSERT_FALSE((bad - bad).valid());
+  ASSERT_FALSE(bad.convert(descriptor_of<meter>).valid());
+
+  // integral quantities hold a null value when invalid
+  ASSERT_EQ((dynamic_quantity(meter_t<int>(1)) - dynamic_quantity(second_t<int>(1))).get_value(), 0);
+}
+
+TEST(dynamicQuantity, comparison) {
+  const dynamic_quantity km(kilometer_t<>(1));
+  const dynamic_quantity m(meter_t<>(1000));
+  const dynamic_quantity s(second_t<>(1));
+
+  ASSERT_EQ(km, m);
+  ASSERT_LT(m, km * 2);
+  ASSERT_GT(km, m / 2);
+  ASSERT_NE(m, s);
+
+  // quantities of incompatible units are unordered
+  ASSERT_FALSE(m < s);
+  ASSERT_FALSE(m > s);
+  ASSERT_EQ(m <=> s, std::partial_ordering::unordered);
+}
+
+TEST(dynamicQuantity, integralMixedUnits) {
+  const dynamic_quantity km(kilometer_t<int>(1));
+  const dynamic_quantity m(meter_t<int>(1500));
+  const dynamic_quantity ft(foot_t<int>(1));
+
+  // values are compared exactly, as for quantities
+  ASSERT_NE(km, m);
+  ASSERT_LT(km, m);
+  ASSERT_GT(m, km);
+  ASSERT_EQ(km, dynamic_quantity(meter_t<int>(1000)));
+  ASSERT_LT(dynamic_quantity(meter_t<int>(999)), km);
+  ASSERT_EQ(kilometer_t<int>(1) == meter_t<int>(1500), km == m);
+
+  // sums and differences are kept in the finer unit
+  const auto sum = km + m;
+  ASSERT_EQ(sum.get_unit(), descriptor_of<meter>);
+  ASSERT_EQ(sum.get_value(), 2500);
+  ASSERT_EQ((m - km).get_value(), 500);
+  ASSERT_EQ((m + km).get_unit(), descriptor_of<meter>);
+
+  // or in a unit of which both are multiples, 1 ft being 381/1250 m
+  const auto mixed = dynamic_quantity(meter_t<int>(1)) + ft;
+  ASSERT_EQ(mixed.get_value(), 1250 + 381);
+  ASSERT_DOUBLE_EQ((mixed.convert<micrometer, double>()->get_value()), 1304800);
+  ASSERT_LT(ft, dynamic_quantity(meter_t<int>(1)));
+
+  // results that do not fit in the value type are invalid
+  ASSERT_FALSE((dynamic_quantity(meter_t<int>(1)) + dynamic_quantity(kilometer_t<int>(3'000'000))).valid());
+  ASSERT_FALSE((dynamic_quantity(meter_t<int>(1)) - dynamic_quantity(kilometer_t<int>(3'000'000))).valid());
+  ASSERT_TRUE((dynamic_quantity(meter_t<int>(1)) + dynamic_quantity(kilometer_t<int>(2'000'000))).valid());
+
+  // as are products that overflow in the common unit, or in a conversion
+  const dynamic_quantity big(std::numeric_limits<std::int64_t>::max(), descriptor_of<meter>);
+  const auto yoctometer = descriptor_of<meter>.factor*runtime_ratio::of<yocto>();
+  ASSERT_FALSE((big + dynamic_quantity(std::int64_t(1), unit_descriptor::make(yoctometer, big.get_unit().dim))).valid());
+  ASSERT_FALSE(big.convert(unit_descriptor::make(yoctometer, big.get_unit().dim)).valid());
+  ASSERT_EQ(big <=> big.convert(descriptor_of<kilometer>), std::partial_ordering::greater);
+}
+
+TEST(dynamicQuantity, conversion) {
+  const dynamic_quantity speed(36., *parse_unit("km/h"));
+
+  const auto ms = speed.convert<make_unit<meter, inverse<second>>>();
+  ASSERT_TRUE(ms.has_value());
+  ASSERT_DOUBLE_EQ(ms->get_value(), 10);
+
+  ASSERT_FALSE(speed.convert<meter>().has_value());
+  ASSERT_FALSE(speed.convert(descriptor_of<second>).valid());
+
+  const auto back = dynamic_quantity(*ms).convert(speed.get_unit());
+  ASSERT_EQ(back.get_unit(), speed.get_unit());
+  ASSERT_DOUBLE_EQ(back.get_value(), 36);
+
+  // integral values are scaled exactly, and truncated
+  const dynamic_quantity s(std::int64_t(150), descriptor_of<second>);
+  ASSERT_EQ(s.convert<millisecond>()->get_value(), 150'000);
+  ASSERT_EQ(s.convert<minute>()->get_value(), 2);
+  ASSERT_DOUBLE_EQ((s.convert<minute, double>()->get_value()), 2.5);
+
+  // floating-point values are scaled before they are truncated
+  const dynamic_quantity km(1.5, descriptor_of<kilometer>);
+  ASSERT_EQ((km.convert<meter, int>()->get_value()), 1500);
+  ASSERT_EQ((km.convert<kilometer, int>()->get_value()), 1);
+
+  // conversions to integral types fail if the value does not fit
+  const dynamic_quantity short_km(std::int16_t(3), descriptor_of<kilometer>);
+  ASSERT_FALSE((short_km.convert<millimeter, std::int16_t>().has_value()));
+  ASSERT_EQ((short_km.convert<meter, std::int16_t>()->get_value()), 3000);
+  ASSERT_EQ((short_km.convert<millimeter, std::int32_t>()->get_value()), 3'000'000);
+  ASSERT_FALSE((dynamic_quantity(1e10, descriptor_of<meter>).convert<meter, int>().has_value()));
+  ASSERT_FALSE((dynamic_quantity(std::nan(""), descriptor_of<meter>).convert<meter, int>().has_value()));
+  ASSERT_FALSE((dynamic_quantity(-1., descriptor_of<meter>).convert<meter, unsigned>().has_value()));
+  ASSERT_EQ((dynamic_quantity(-0.5, descriptor_of<meter>).convert<meter, unsigned>()->get_value()), 0u);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
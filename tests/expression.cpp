@@ -0,0 +1,94 @@
+#include <units/expression.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+using namespace units;
+
+TEST(expression, energy) {
+  const std::size_t n = 101;
+
+  std::vector<kilogram_t<>> m(n);
+  std::vector<quantity<make_unit<meter, inverse<second>>>> v(n);
+  std::vector<kilometer_t<>> h(n);
+  const auto g = quantity<make_unit<meter, inverse_squared<second>>>(9.81);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    m[i] = kilogram_t<>(1 + 0.5 * i);
+    v[i].set_value(0.25 * i);
+    h[i] = kilometer_t<>(0.001 * i);
+  }
+
+  // the expression carries its unit: the unit of the first term of the sum
+  const auto e = 0.5 * lazy(m) * lazy(v) * lazy(v) + lazy(m) * g * lazy(h);
+  static_assert(concepts::unit_compatible<std::remove_cvref_t<decltype(e)>::unit_type, joule>);
+  ASSERT_EQ(e.size(), n);
+
+  std::vector<joule_t<>> energy(n);
+  std::vector<quantity<make_unit<kilo, joule>>> kj(n);
+
+  ASSERT_EQ(evaluate_into(e, energy).size(), n);
+  ASSERT_EQ(evaluate_into(e, kj).size(), n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto expected = 0.5 * m[i].get_value() * v[i].get_value() * v[i].get_value()
+      + m[i].get_value() * 9.81 * 1000 * h[i].get_value();
+    ASSERT_DOUBLE_EQ(energy[i].get_value(), expected);
+    ASSERT_DOUBLE_EQ(kj[i].get_value(), expected / 1000);
+  }
+}
+
+TEST(expression, mixedUnits) {
+  std::vector<kilometer_t<>> km = {kilometer_t<>(1), kilometer_t<>(2), kilometer_t<>(3)};
+  std::vector<meter_t<>> m = {meter_t<>(10), meter_t<>(20), meter_t<>(30)};
+  std::vector<second_t<>> s = {second_t<>(1), second_t<>(2), second_t<>(4)};
+
+  std::vector<meter_t<>> sum(3);
+  evaluate_into(lazy(km) + lazy(m) - meter_t<>(5), sum);
+  ASSERT_DOUBLE_EQ(sum[0].get_value(), 1005);
+  ASSERT_DOUBLE_EQ(sum[2].get_value(), 3025);
+
+  std::vector<quantity<make_unit<kilometer, inverse<hour>>>> speed(3);
+  evaluate_into((lazy(km) + lazy(m)) / lazy(s), speed);
+  ASSERT_DOUBLE_EQ(speed[0].get_value(), 1010 * 3.6);
+  ASSERT_DOUBLE_EQ(speed[2].get_value(), 3030 / 4. * 3.6);
+
+  std::vector<meter_t<>> negated(3);
+  evaluate_into(-lazy(m) * 2, negated);
+  ASSERT_DOUBLE_EQ(negated[1].get_value(), -40);
+
+  // dimensionless expressions
+  std::vector<quantity<unit<one>>> ratio(3);
+  evaluate_into(lazy(m) / lazy(km) + 1, ratio);
+  ASSERT_DOUBLE_EQ(ratio[0].get_value(), 1.01);
+}
+
+TEST(expression, sizes) {
+  std::vector<meter_t<>> a(10, meter_t<>(1)), b(4, meter_t<>(2)), out(7);
+
+  // only as many elements as the shortest range are evaluated
+  const auto written = evaluate_into(lazy(a) + lazy(b), out);
+  ASSERT_EQ(written.size(), 4);
+  ASSERT_EQ(written.data(), out.data());
+  ASSERT_DOUBLE_EQ(out[3].get_value(), 3);
+  ASSERT_DOUBLE_EQ(out[4].get_value(), 0);
+}
+
+TEST(expression, integral) {
+  std::vector<second_t<std::int64_t>> s = {second_t<std::int64_t>(1), second_t<std::int64_t>(90)};
+  std::vector<minute_t<std::int64_t>> min = {minute_t<std::int64_t>(1), minute_t<std::int64_t>(2)};
+  std::vector<second_t<std::int64_t>> out(2);
+
+  evaluate_into(lazy(s) + lazy(min) * 2, out);
+  ASSERT_EQ(out[0].get_value(), 121);
+  ASSERT_EQ(out[1].get_value(), 330);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,119 @@
+#include <units/format.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace units;
+
+namespace {
+  // formats into a fixed buffer and returns the written text, or the error name
+  template <class Q>
+  std::string_view format(const Q& q, const std::string_view spec = {}) {
+    static std::array<char, 128> buffer;
+    const auto [end, ec] = to_chars(buffer.data(), buffer.data() + buffer.size(), q, spec);
+
+    if (ec == std::errc::invalid_argument)
+      return "invalid";
+    if (ec == std::errc::value_too_large)
+      return "too large";
+
+    return std::string_view(buffer.data(), end - buffer.data());
+  }
+}
+
+TEST(formatting, defaultFormat) {
+  ASSERT_EQ(format(meter_t<>(1.5)), "1.5 m");
+  ASSERT_EQ(format(kilometer_t<int>(-42)), "-42 km");
+  ASSERT_EQ(format(newton_t<float>(0.25f)), "0.25 N");
+
+  // the output matches the one of the stream operator
+  std::array<char, 64> buffer;
+  const auto q = quantity<make_unit<meter, inverse<second>>>(3);
+  const auto [end, ec] = to_chars(buffer.data(), buffer.data() + buffer.size(), q);
+  ASSERT_EQ(ec, std::errc());
+  ASSERT_EQ(std::string_view(buffer.data(), end - buffer.data()), "3 m s^-1 ");
+
+  // squared velocities, of the same unit type as the gray, have no symbol of their own
+  const auto v = meter_t<>(3)/second_t<>(1);
+  ASSERT_EQ(format(v*v), "9 m^2 s^-2 ");
+}
+
+TEST(formatting, precisionAndType) {
+  ASSERT_EQ(format(meter_t<>(1234.5678), ".2f"), "1234.57 m");
+  ASSERT_EQ(format(meter_t<>(1234.5678), ".3e"), "1.235e+03 m");
+  ASSERT_EQ(format(meter_t<>(1234.5678), ".3"), "1.23e+03 m");
+  ASSERT_EQ(format(meter_t<>(0.5), "f"), "0.500000 m");
+  ASSERT_EQ(format(second_t<int>(3), ".1f"), "3.0 s");
+}
+
+TEST(formatting, targetUnit) {
+  ASSERT_EQ(format(meter_t<>(1500), ".3f:km"), "1.500 km");
+  ASSERT_EQ(format(meter_t<>(1500), ":km"), "1.5 km");
+  ASSERT_EQ(format(meter_t<std::int64_t>(1), ":mm"), "1000 mm");
+  ASSERT_EQ(format(quantity<make_unit<meter, inverse<second>>>(10), ".1f:km/h"), "36.0 km/h");
+  ASSERT_EQ(format(joule_t<>(1), ".4g:kg m^2 s^-2"), "1 kg m^2 s^-2");
+}
+
+TEST(formatting, errors) {
+  ASSERT_EQ(format(meter_t<>(1), ":s"), "invalid");
+  ASSERT_EQ(format(meter_t<>(1), ":furlongs"), "invalid");
+  ASSERT_EQ(format(meter_t<>(1), ".f"), "invalid");
+  ASSERT_EQ(format(meter_t<>(1), "x"), "invalid");
+  ASSERT_EQ(format(meter_t<>(1), ".2fkm"), "invalid");
+
+  std::array<char, 4> small;
+  ASSERT_EQ(to_chars(small.data(), small.data() + small.size(), meter_t<>(12.5)).ec, std::errc::value_too_large);
+  ASSERT_EQ(to_chars(small.data(), small.data() + small.size(), kilometer_t<>(1.5)).ec, std::errc::value_too_large);
+}
+
+TEST(formatting, longestValues) {
+  // the longest numbers are the largest values, in fixed notation with the largest precision
+  const auto fits = [](const auto q) {
+    using V = typename decltype(q)::value_type;
+    std::vector<char> buffer(_details::_format::max_length<V>);
+    const auto [end, ec] = to_chars(buffer.data(), buffer.data() + buffer.size(), -q, ".1000f:m");
+    return ec == std::errc() && std::string_view(buffer.data(), end).ends_with("000 m");
+  };
+
+  ASSERT_TRUE(fits(meter_t<float>(std::numeric_limits<float>::max())));
+  ASSERT_TRUE(fits(meter_t<double>(std::numeric_limits<double>::max())));
+  ASSERT_TRUE(fits(meter_t<long double>(std::numeric_limits<long double>::max())));
+  ASSERT_TRUE(fits(meter_t<std::int64_t>(std::numeric_limits<std::int64_t>::max())));
+}
+
+// specifications are parsed in constant expressions, as std::format checks format
+// strings at compile time. this is tested whether std::format is available or not
+static_assert(_details::_format::parse_spec(".1f:km/h")->unit == parse_unit("km/h"));
+static_assert(_details::_format::parse_spec(".3e")->precision == 3);
+static_assert(!_details::_format::parse_spec(".2fkm"));
+
+#if defined(__cpp_lib_format)
+
+TEST(formatting, stdFormat) {
+  ASSERT_EQ(std::format("{}", meter_t<>(1.5)), "1.5 m");
+  ASSERT_EQ(std::format("{:.3f:km}", meter_t<>(1500)), "1.500 km");
+
+  char buffer[32];
+  const auto result = std::format_to_n(buffer, sizeof(buffer), "{:.1f}", second_t<>(2));
+  ASSERT_EQ(std::string_view(buffer, result.out), "2.0 s");
+
+  // values longer than any double
+  const auto text = std::format("{:f}", meter_t<long double>(std::numeric_limits<long double>::max()));
+  ASSERT_EQ(text.size(), std::size_t(std::numeric_limits<long double>::max_exponent10 + 1 + 7 + 2));
+  ASSERT_TRUE(text.ends_with(".000000 m"));
+}
+
+#endif
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
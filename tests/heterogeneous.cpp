@@ -0,0 +1,146 @@
+#include <units/angular.h>
+#include <units/heterogeneous.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <type_traits>
+
+using namespace units;
+
+using velocity = make_unit<meter, inverse<second>>;
+using state = unit_list<meter, velocity, radian>;
+using measurement = unit_list<meter, radian>;
+
+template <class A, class B>
+concept multipliable = requires (const A a, const B b) {a * b;};
+
+template <class A, class B>
+concept addable = requires (const A a, const B b) {a + b;};
+
+TEST(heterogeneous, vectors) {
+  // values are stored packed, in the unit of each element, and aligned as a vec
+  static_assert(sizeof(hvec<state>) == sizeof(vec<3, meter_t<double>>));
+  static_assert(sizeof(hvec<measurement>) == 2*sizeof(double));
+
+  hvec<state> x(kilometer_t<double>(1), quantity<velocity, double>(2), degree_t<double>(180));
+  ASSERT_EQ(x.get<0>(), meter_t<double>(1000));
+  ASSERT_EQ(x.get<1>().get_value(), 2);
+  ASSERT_DOUBLE_EQ(x.get<2>().get_value(), M_PI);
+  static_assert(std::is_same_v<decltype(x.get<2>()), radian_t<double>>);
+
+  x.set<0>(centimeter_t<double>(50));
+  ASSERT_EQ(x.values()[0], 0.5);
+
+  // elements are converted to the units of the left operand
+  const hvec<unit_list<kilometer, velocity, radian>> y(kilometer_t<double>(1), quantity<velocity, double>(0), radian_t<double>(0));
+  const auto z = x + y;
+  static_assert(std::is_same_v<decltype(z), const hvec<state>>);
+  ASSERT_EQ(z.get<0>(), meter_t<double>(1000.5));
+  ASSERT_EQ((z - y).get<0>(), meter_t<double>(0.5));
+  ASSERT_EQ((2.0 * x).get<1>().get_value(), 4);
+
+  // vectors of other units are not added
+  static_assert(!addable<hvec<state>, hvec<measurement>>);
+  static_assert(!addable<hvec<state>, hvec<unit_list<meter, meter, radian>>>);
+  static_assert(!std::is_constructible_v<hvec<state>, meter_t<double>, meter_t<double>, radian_t<double>>);
+}
+
+TEST(heterogeneous, matrices) {
+  using transition = jacobian<state, state>;
+
+  // the units of the elements of a jacobian are the ratios of the units of the vectors
+  static_assert(std::is_same_v<transition::quantity_type<0, 1>::unit_type, make_unit<meter, inverse<velocity>>>);
+  static_assert(concepts::unit_compatible<transition::quantity_type<0, 1>::unit_type, second>);
+  static_assert(concepts::dimensionless_unit<transition::quantity_type<2, 2>::unit_type>);
+
+  // and those of a covariance are products
+  static_assert(concepts::unit_compatible<covariance<state>::quantity_type<0, 1>::unit_type, make_unit<meter, meter, inverse<second>>>);
+
+  transition f = transition::identity();
+  f.set<0, 1>(millisecond_t<double>(100));
+
+  const hvec<state> x(meter_t<double>(1), quantity<velocity, double>(2), radian_t<double>(0.5));
+  const auto y = f * x;
+  static_assert(concepts::unit_compatible<decltype(y.get<0>())::unit_type, meter>);
+  static_assert(concepts::unit_compatible<decltype(y.get<1>())::unit_type, velocity>);
+  ASSERT_DOUBLE_EQ(y.get<0>().get_value(), 1.2);
+  ASSERT_EQ(y.get<1>().get_value(), 2);
+  ASSERT_EQ(y.get<2>().get_value(), 0.5);
+
+  // products only compile when the units of the inner dimension agree
+  using observation = jacobian<measurement, state>;
+  static_assert(multipliable<covariance<state>, decltype(transpose(observation()))>);
+  static_assert(!multipliable<covariance<state>, observation>);
+  static_assert(!multipliable<observation, hvec<measurement>>);
+  static_assert(!addable<covariance<state>, transition>);
+
+  // the inverse has the inverse units
+  covariance<measurement> s;
+  s.set<0, 0>(meter_t<double>(2) * meter_t<double>(2));
+  s.set<0, 1>(meter_t<double>(1) * radian_t<double>(1));
+  s.set<1, 0>(meter_t<double>(1) * radian_t<double>(1));
+  s.set<1, 1>(radian_t<double>(1) * radian_t<double>(1));
+
+  const auto inv = invert(s);
+  ASSERT_TRUE(inv.has_value());
+  const auto one = s * *inv;
+  static_assert(concepts::dimensionless_unit<decltype(one.get<1, 1>())::unit_type>);
+  ASSERT_DOUBLE_EQ((one.get<0, 0>().get_value()), 1);
+  ASSERT_NEAR((one.get<0, 1>().get_value()), 0, 1e-15);
+  ASSERT_NEAR((one.get<1, 0>().get_value()), 0, 1e-15);
+  ASSERT_DOUBLE_EQ((one.get<1, 1>().get_value()), 1);
+
+  ASSERT_FALSE(invert(covariance<measurement>()).has_value());
+}
+
+TEST(heterogeneous, kalman) {
+  using transition = jacobian<state, state>;
+  using observation = jacobian<measurement, state>;
+
+  // constant velocity along a line, with a heading measured directly
+  const auto dt = second_t<double>(0.1);
+
+  transition f = transition::identity();
+  f.set<0, 1>(dt);
+
+  observation h;
+  h.set<0, 0>(quantity<make_unit<>, double>(1));
+  h.set<1, 2>(quantity<make_unit<>, double>(1));
+
+  covariance<state> q;
+  q.set<0, 0>(meter_t<double>(0.01) * meter_t<double>(0.01));
+  q.set<1, 1>(quantity<velocity, double>(0.1) * quantity<velocity, double>(0.1));
+  q.set<2, 2>(radian_t<double>(0.01) * radian_t<double>(0.01));
+
+  covariance<measurement> r;
+  r.set<0, 0>(meter_t<double>(0.5) * meter_t<double>(0.5));
+  r.set<1, 1>(radian_t<double>(0.05) * radian_t<double>(0.05));
+
+  hvec<state> x;
+  covariance<state> p = covariance<state>() + q * 100.0;
+
+  for (int step = 1; step <= 200; ++step) {
+    // prediction
+    x = hvec<state>(f * x);
+    p = covariance<state>(f * p * transpose(f)) + q;
+
+    // update with a measurement of an object at 3 m/s heading 0.25 rad
+    const hvec<measurement> z(meter_t<double>(3 * step * dt.get_value()), radian_t<double>(0.25));
+    const auto s = h * p * transpose(h) + r;
+    const auto k = p * transpose(h) * *invert(s);
+    static_assert(std::is_same_v<decltype(k)::row_units, state>);
+
+    x += k * (z - h * x);
+    p = covariance<state>((transition::identity() - k * h) * p);
+  }
+
+  ASSERT_NEAR(x.get<1>().get_value(), 3, 0.05);
+  ASSERT_NEAR(x.get<2>().get_value(), 0.25, 0.01);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,156 @@
+#include <units/histogram.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace units;
+
+namespace units {
+  units_set_prefixes(electronvolt, eV, kilo, mega, giga);
+}
+
+template <class H, class... Xs>
+concept fillable = requires (H& h, const Xs... xs) {h.fill(xs...);};
+
+TEST(histogram, uniformAxis) {
+  // limits are converted to the unit of the axis
+  const uniform_axis<megaelectronvolt_t<>> axis(10, kiloelectronvolt_t<>(0), gigaelectronvolt_t<>(0.01));
+
+  ASSERT_EQ(axis.bins(), 10);
+  ASSERT_EQ(axis.edge(0), megaelectronvolt_t<>(0));
+  ASSERT_EQ(axis.edge(10), megaelectronvolt_t<>(10));
+
+  ASSERT_EQ(axis.index(megaelectronvolt_t<>(0)), 1);
+  ASSERT_EQ(axis.index(megaelectronvolt_t<>(4.5)), 5);
+  ASSERT_EQ(axis.index(kiloelectronvolt_t<>(9999)), 10);
+  ASSERT_EQ(axis.index(megaelectronvolt_t<>(-1)), 0);
+  ASSERT_EQ(axis.index(megaelectronvolt_t<>(10)), 11);
+  ASSERT_EQ(axis.index(megaelectronvolt_t<>(1e300)), 11);
+  ASSERT_EQ(axis.index(megaelectronvolt_t<>(-std::numeric_limits<double>::infinity())), 0);
+  ASSERT_EQ(axis.index(megaelectronvolt_t<>(std::numeric_limits<double>::quiet_NaN())), 11);
+
+  // every edge opens its bin, for limits whose bins are rounded in either direction
+  const uniform_axis<meter_t<>> skewed(7, meter_t<>(0.1), meter_t<>(0.7));
+  for (int i = 0; i <= 7; ++i) {
+    ASSERT_EQ(skewed.index(skewed.edge(i)), i + 1);
+    ASSERT_EQ(skewed.index(meter_t<>(std::nextafter(skewed.edge(i).get_value(), 0))), i);
+  }
+
+  std::mt19937_64 engine(1);
+  std::uniform_real_distribution<double> limit(-100, 100);
+  for (int k = 0; k < 1000; ++k) {
+    const auto bins = std::size_t(k%199 + 1);
+    const auto a = limit(engine), b = limit(engine);
+    const uniform_axis<meter_t<>> random(bins, meter_t<>(std::min(a, b)), meter_t<>(std::max(a, b)));
+
+    for (std::size_t i = 0; i <= bins; ++i) {
+      const auto e = random.edge(i).get_value();
+      ASSERT_EQ(random.index(meter_t<>(e)), i + 1);
+      ASSERT_EQ(random.index(meter_t<>(std::nextafter(e, -200.))), i);
+    }
+  }
+}
+
+TEST(histogram, logAxis) {
+  const log_axis<nanosecond_t<>> axis(6, nanosecond_t<>(1), millisecond_t<>(1));
+
+  // one bin per decade, whose edges are found exactly
+  for (int i = 0; i <= 6; ++i) {
+    ASSERT_NEAR(axis.edge(i).get_value(), std::pow(10, i), 1e-9*std::pow(10, i));
+    if (i < 6) {
+      ASSERT_EQ(axis.index(axis.edge(i)), i + 1);
+    }
+    if (i > 0) {
+      ASSERT_EQ(axis.index(nanosecond_t<>(std::nextafter(axis.edge(i).get_value(), 0))), i);
+    }
+  }
+
+  ASSERT_EQ(axis.index(microsecond_t<>(50)), 5);
+  ASSERT_EQ(axis.index(nanosecond_t<>(0)), 0);
+  ASSERT_EQ(axis.index(nanosecond_t<>(-3)), 0);
+  ASSERT_EQ(axis.index(second_t<>(1)), 7);
+}
+
+TEST(histogram, variableAxis) {
+  const variable_axis<meter_t<>> axis({centimeter_t<>(0), centimeter_t<>(1), centimeter_t<>(2), centimeter_t<>(5), centimeter_t<>(100), centimeter_t<>(100.5)});
+
+  ASSERT_EQ(axis.bins(), 5);
+  ASSERT_EQ(axis.edge(3), meter_t<>(0.05));
+
+  ASSERT_EQ(axis.index(millimeter_t<>(-1)), 0);
+  ASSERT_EQ(axis.index(millimeter_t<>(5)), 1);
+  ASSERT_EQ(axis.index(millimeter_t<>(30)), 3);
+  ASSERT_EQ(axis.index(meter_t<>(0.5)), 4);
+  ASSERT_EQ(axis.index(meter_t<>(1.002)), 5);
+  ASSERT_EQ(axis.index(meter_t<>(1.01)), 6);
+
+  // every edge opens its bin, compared with a search of the edges
+  std::mt19937_64 engine(1);
+  std::uniform_real_distribution<double> dist(-0.1, 1.1);
+  std::vector<double> edges;
+  for (std::size_t i = 0; i <= axis.bins(); ++i)
+    edges.push_back(axis.edge(i).get_value());
+
+  for (int i = 0; i < 100000; ++i) {
+    const double x = (i % 10 == 0)? edges[i % edges.size()] : dist(engine);
+    const std::size_t expected = std::upper_bound(edges.begin(), edges.end(), x) - edges.begin();
+    ASSERT_EQ(axis.index(meter_t<>(x)), expected) << x;
+  }
+}
+
+TEST(histogram, fill) {
+  histogram h(uniform_axis<megaelectronvolt_t<>>(4, megaelectronvolt_t<>(0), megaelectronvolt_t<>(4)),
+              log_axis<nanosecond_t<>>(3, nanosecond_t<>(1), microsecond_t<>(1)));
+
+  h.fill(megaelectronvolt_t<>(0.5), nanosecond_t<>(5));
+  h.fill(kiloelectronvolt_t<>(2500), microsecond_t<>(0.5));
+  h.fill(kiloelectronvolt_t<>(2600), nanosecond_t<>(500));
+  h.fill(megaelectronvolt_t<>(-1), second_t<>(1));
+
+  ASSERT_EQ(h.entries(), 4);
+  ASSERT_EQ(h.at(1, 1), 1);
+  ASSERT_EQ(h.at(3, 3), 2);
+  ASSERT_EQ(h.at(0, 4), 1);
+  ASSERT_EQ(h.counts().size(), 6*5);
+
+  // incompatible units do not compile
+  static_assert(fillable<decltype(h), joule_t<>, second_t<>>);
+  static_assert(!fillable<decltype(h), second_t<>, second_t<>>);
+  static_assert(!fillable<decltype(h), joule_t<>>);
+
+  h.reset();
+  ASSERT_EQ(h.entries(), 0);
+}
+
+TEST(histogram, threadedFill) {
+  histogram h(uniform_axis<megaelectronvolt_t<>>(100, megaelectronvolt_t<>(0), megaelectronvolt_t<>(100)));
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t)
+    threads.emplace_back([&h]{
+      auto buffer = h.make_buffer();
+      for (int i = 0; i < 102000; ++i)
+        buffer.fill(megaelectronvolt_t<>(i % 102 - 1));
+
+      // flushing twice adds nothing the second time
+      buffer.flush();
+    });
+
+  for (auto& t : threads)
+    t.join();
+
+  ASSERT_EQ(h.entries(), 8*102000);
+  for (std::size_t i = 0; i <= 101; ++i)
+    ASSERT_EQ(h.at(i), 8*1000);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
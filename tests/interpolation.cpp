@@ -0,0 +1,175 @@
+#include <units/interpolation.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace units;
+
+namespace units {
+  units_set_prefixes(electronvolt, eV, kilo, mega, giga);
+  units_add_derived_unit(barn, b, make_unit<ratio<1, 10000000000000000>, meter, meter>);
+  units_set_prefixes(barn, b, milli);
+}
+
+TEST(interpolation, uniformGrid) {
+  // keys are converted to the unit of the grid once
+  const uniform_grid<megaelectronvolt_t<>> grid(11, kiloelectronvolt_t<>(0), gigaelectronvolt_t<>(0.01));
+
+  ASSERT_EQ(grid.size(), 11);
+  ASSERT_EQ(grid.node(0), megaelectronvolt_t<>(0));
+  ASSERT_EQ(grid.node(10), megaelectronvolt_t<>(10));
+
+  const std::vector<double> v = {0, 1, 4, 9, 16, 25, 36, 49, 64, 81, 100};
+  std::vector<barn_t<>> values;
+  for (const auto x : v)
+    values.push_back(barn_t<>(x));
+
+  const table<uniform_grid<megaelectronvolt_t<>>, barn_t<>> linear(grid, values);
+
+  ASSERT_EQ(linear(megaelectronvolt_t<>(2)), barn_t<>(4));
+  ASSERT_DOUBLE_EQ(linear(megaelectronvolt_t<>(2.5)).get_value(), 6.5);
+  ASSERT_DOUBLE_EQ(linear(kiloelectronvolt_t<>(2500)).get_value(), 6.5);
+
+  // keys outside the grid are clamped to its ends, and nans propagate
+  ASSERT_EQ(linear(megaelectronvolt_t<>(-1)), barn_t<>(0));
+  ASSERT_EQ(linear(megaelectronvolt_t<>(11)), barn_t<>(100));
+  ASSERT_EQ(linear(megaelectronvolt_t<>(std::numeric_limits<double>::infinity())), barn_t<>(100));
+  ASSERT_TRUE(std::isnan(linear(megaelectronvolt_t<>(std::numeric_limits<double>::quiet_NaN())).get_value()));
+
+  // values are converted to the unit of the table
+  const table<uniform_grid<megaelectronvolt_t<>>, millibarn_t<>> converted(grid, values);
+  ASSERT_DOUBLE_EQ(converted(megaelectronvolt_t<>(2.5)).get_value(), 6500);
+}
+
+TEST(interpolation, cubic) {
+  // a natural cubic spline reproduces a straight line, and interpolates a smooth
+  // function much better than straight lines do. the sine has no curvature at the
+  // ends of the grid, as a natural spline
+  const uniform_grid<second_t<>> grid(41, second_t<>(0), second_t<>(M_PI));
+
+  std::vector<meter_t<>> line, wave;
+  for (std::size_t i = 0; i < grid.size(); ++i) {
+    const double t = grid.node(i).get_value();
+    line.push_back(meter_t<>(3*t - 1));
+    wave.push_back(meter_t<>(std::sin(t)));
+  }
+
+  const table<uniform_grid<second_t<>>, meter_t<>, interpolation::cubic> cubic_line(grid, line);
+  const table<uniform_grid<second_t<>>, meter_t<>, interpolation::cubic> cubic_wave(grid, wave);
+  const table<uniform_grid<second_t<>>, meter_t<>> linear_wave(grid, wave);
+
+  double linear_error = 0, cubic_error = 0;
+  for (double t = 0; t <= M_PI; t += 0.013) {
+    ASSERT_NEAR(cubic_line(second_t<>(t)).get_value(), 3*t - 1, 1e-12);
+    cubic_error = std::max(cubic_error, std::abs(cubic_wave(second_t<>(t)).get_value() - std::sin(t)));
+    linear_error = std::max(linear_error, std::abs(linear_wave(second_t<>(t)).get_value() - std::sin(t)));
+  }
+
+  ASSERT_LT(cubic_error, 1e-6);
+  ASSERT_LT(100*cubic_error, linear_error);
+
+  // the spline goes through the nodes
+  for (std::size_t i = 0; i < grid.size(); ++i)
+    ASSERT_NEAR(cubic_wave(grid.node(i)).get_value(), wave[i].get_value(), 1e-15);
+}
+
+TEST(interpolation, logGrid) {
+  const log_grid<megaelectronvolt_t<>> grid(7, kiloelectronvolt_t<>(1), gigaelectronvolt_t<>(1));
+
+  ASSERT_EQ(grid.size(), 7);
+  ASSERT_DOUBLE_EQ(grid.node(1).get_value(), 0.01);
+  ASSERT_EQ(grid.node(6), megaelectronvolt_t<>(1000));
+
+  // a power law, which is linear in the logarithm of the key
+  const table<log_grid<megaelectronvolt_t<>>, barn_t<>> t(grid, {barn_t<>(0), barn_t<>(1), barn_t<>(2), barn_t<>(3), barn_t<>(4), barn_t<>(5), barn_t<>(6)});
+
+  ASSERT_DOUBLE_EQ(t(megaelectronvolt_t<>(1)).get_value(), 3);
+  ASSERT_DOUBLE_EQ(t(megaelectronvolt_t<>(std::sqrt(10))).get_value(), 3.5);
+  ASSERT_EQ(t(megaelectronvolt_t<>(0)), barn_t<>(0));
+  ASSERT_EQ(t(megaelectronvolt_t<>(-1)), barn_t<>(0));
+  ASSERT_EQ(t(gigaelectronvolt_t<>(2)), barn_t<>(6));
+}
+
+TEST(interpolation, irregularGrid) {
+  const irregular_grid<meter_t<>> grid{centimeter_t<>(0), centimeter_t<>(10), centimeter_t<>(100), centimeter_t<>(150), centimeter_t<>(1000)};
+
+  ASSERT_EQ(grid.size(), 5);
+  ASSERT_EQ(grid.node(1), meter_t<>(0.1));
+
+  const table<irregular_grid<meter_t<>>, second_t<>> t(grid, {second_t<>(0), second_t<>(1), second_t<>(2), second_t<>(3), second_t<>(4)});
+
+  ASSERT_DOUBLE_EQ(t(centimeter_t<>(5)).get_value(), 0.5);
+  ASSERT_DOUBLE_EQ(t(meter_t<>(0.55)).get_value(), 1.5);
+  ASSERT_DOUBLE_EQ(t(meter_t<>(1.25)).get_value(), 2.5);
+  ASSERT_DOUBLE_EQ(t(meter_t<>(5.75)).get_value(), 3.5);
+  ASSERT_EQ(t(meter_t<>(1.5)), second_t<>(3));
+  ASSERT_EQ(t(meter_t<>(-1)), second_t<>(0));
+  ASSERT_EQ(t(meter_t<>(100)), second_t<>(4));
+  ASSERT_TRUE(std::isnan(t(meter_t<>(std::numeric_limits<double>::quiet_NaN())).get_value()));
+}
+
+TEST(interpolation, valueCount) {
+  const uniform_grid<megaelectronvolt_t<>> grid(3, megaelectronvolt_t<>(0), megaelectronvolt_t<>(2));
+  const std::vector<barn_t<>> more(8, barn_t<>(1)), fewer(2, barn_t<>(1)), exact(3, barn_t<>(1));
+
+  // there must be exactly one value per node
+  using linear = table<uniform_grid<megaelectronvolt_t<>>, barn_t<>>;
+  using cubic = table<uniform_grid<megaelectronvolt_t<>>, barn_t<>, interpolation::cubic>;
+  ASSERT_THROW(linear(grid, more), std::invalid_argument);
+  ASSERT_THROW(linear(grid, fewer), std::invalid_argument);
+  ASSERT_THROW(cubic(grid, more), std::invalid_argument);
+  ASSERT_THROW(cubic(grid, fewer), std::invalid_argument);
+  ASSERT_EQ(linear(grid, exact)(megaelectronvolt_t<>(1)), barn_t<>(1));
+}
+
+TEST(interpolation, batch) {
+  std::mt19937_64 rng(7);
+  std::uniform_real_distribution<double> log_energy(-4, 4);
+
+  std::vector<kiloelectronvolt_t<>> keys;
+  for (std::size_t i = 0; i < 1003; ++i)
+    keys.push_back(kiloelectronvolt_t<>(std::pow(10, log_energy(rng))));
+
+  // keys out of range, and out of the range of the vectorized logarithm
+  keys[3] = kiloelectronvolt_t<>(0);
+  keys[4] = kiloelectronvolt_t<>(-1);
+  keys[5] = kiloelectronvolt_t<>(std::numeric_limits<double>::infinity());
+  keys[6] = kiloelectronvolt_t<>(std::numeric_limits<double>::quiet_NaN());
+  keys[7] = kiloelectronvolt_t<>(std::numeric_limits<double>::denorm_min());
+
+  std::vector<barn_t<>> values;
+  const log_grid<megaelectronvolt_t<>> lgrid(200, kiloelectronvolt_t<>(0.1), gigaelectronvolt_t<>(0.01));
+  for (std::size_t i = 0; i < lgrid.size(); ++i)
+    values.push_back(barn_t<>(1/std::sqrt(lgrid.node(i).get_value())));
+
+  const auto check = [&](const auto& t) {
+    std::vector<barn_t<>> out(keys.size() - 2);
+    ASSERT_EQ(t(keys, out).size(), out.size());
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      if (std::isnan(t(keys[i]).get_value()))
+        ASSERT_TRUE(std::isnan(out[i].get_value()));
+      else
+        ASSERT_EQ(out[i], t(keys[i]));
+    }
+  };
+
+  check(table<log_grid<megaelectronvolt_t<>>, barn_t<>>(lgrid, values));
+  check(table<log_grid<megaelectronvolt_t<>>, barn_t<>, interpolation::cubic>(lgrid, values));
+  check(table<uniform_grid<megaelectronvolt_t<>>, barn_t<>>(uniform_grid<megaelectronvolt_t<>>(200, megaelectronvolt_t<>(0), megaelectronvolt_t<>(10)), values));
+
+  std::vector<megaelectronvolt_t<>> nodes;
+  for (std::size_t i = 0; i < lgrid.size(); ++i)
+    nodes.push_back(lgrid.node(i));
+  check(table<irregular_grid<megaelectronvolt_t<>>, barn_t<>>(irregular_grid<megaelectronvolt_t<>>(nodes), values));
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
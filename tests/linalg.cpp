@@ -0,0 +1,192 @@
+#include <units/linalg.h>
+#include <units/numeric.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+using namespace units;
+
+template <class A, class B>
+concept addable = requires (const A a, const B b) {a + b;};
+
+TEST(linalg, layout) {
+  // vectors are packed, and aligned to a power of two up to a fixed 16 bytes,
+  // whatever the compiler flags
+  static_assert(sizeof(vec<2, meter_t<double>>) == 16 && alignof(vec<2, meter_t<double>>) == 16);
+  static_assert(sizeof(vec<4, meter_t<float>>) == 16 && alignof(vec<4, meter_t<float>>) == 16);
+  static_assert(alignof(vec<3, meter_t<double>>) == 16 && sizeof(vec<3, meter_t<double>>) == 32);
+  static_assert(alignof(vec<1, meter_t<double>>) == alignof(double));
+  static_assert(sizeof(mat<3, 3, meter_t<float>>) == 48);
+
+  // vectors are contiguous ranges of quantities
+  static_assert(std::ranges::contiguous_range<vec<3, meter_t<double>>>);
+
+  const vec<3, meter_t<double>> zero;
+  for (const auto x : zero)
+    ASSERT_EQ(x, meter_t<double>(0));
+}
+
+TEST(linalg, arithmetic) {
+  const vec<3, meter_t<double>> a(meter_t<double>(1), meter_t<double>(2), kilometer_t<double>(0.003));
+  const vec<3, kilometer_t<double>> b(kilometer_t<double>(1), kilometer_t<double>(0), kilometer_t<double>(-1));
+
+  ASSERT_EQ(a[2], meter_t<double>(3));
+
+  // the unit of a sum is the unit of its left operand, as for single quantities
+  static_assert(std::is_same_v<decltype(a + b), vec<3, meter_t<double>>>);
+  static_assert(std::is_same_v<decltype(b - a), vec<3, kilometer_t<double>>>);
+  ASSERT_EQ(a + b, (vec<3, meter_t<double>>(meter_t<double>(1001), meter_t<double>(2), meter_t<double>(-997))));
+  ASSERT_EQ(-a, (vec<3, meter_t<double>>(meter_t<double>(-1), meter_t<double>(-2), meter_t<double>(-3))));
+
+  // vectors of incompatible units are not added
+  static_assert(!addable<vec<3, meter_t<double>>, vec<3, second_t<double>>>);
+  static_assert(!addable<vec<3, meter_t<double>>, vec<2, meter_t<double>>>);
+
+  // products by numbers and quantities
+  const auto t = second_t<double>(2);
+  const auto v = a / t;
+  static_assert(std::is_same_v<decltype(v)::unit_type, make_unit<meter, inverse<second>>>);
+  ASSERT_EQ(v[1].get_value(), 1);
+  ASSERT_EQ((2.0 * a)[2], meter_t<double>(6));
+  ASSERT_EQ((v * t), a);
+
+  auto c = a;
+  c += b;
+  c *= 2;
+  ASSERT_EQ(c, (a + b) * 2);
+
+  // vectors of compatible units are converted explicitly
+  ASSERT_EQ((vec<3, kilometer_t<double>>(a)[2]), kilometer_t<double>(0.003));
+}
+
+TEST(linalg, products) {
+  const vec<3, newton_t<double>> f(newton_t<double>(1), newton_t<double>(2), newton_t<double>(3));
+  const vec<3, meter_t<double>> r(meter_t<double>(4), meter_t<double>(5), meter_t<double>(6));
+
+  // units of the products are deduced from the units of the vectors
+  const auto w = dot(f, r);
+  static_assert(std::is_same_v<decltype(w), const quantity<make_unit<newton, meter>, double>>);
+  ASSERT_EQ(w.get_value(), 32);
+
+  const auto tau = cross(r, f);
+  static_assert(std::is_same_v<decltype(tau), const vec<3, quantity<make_unit<meter, newton>, double>>>);
+  ASSERT_EQ(tau[0].get_value(), 3);
+  ASSERT_EQ(tau[1].get_value(), -6);
+  ASSERT_EQ(tau[2].get_value(), 3);
+  ASSERT_EQ(dot(tau, r).get_value(), 0);
+
+  // norms
+  const vec<2, meter_t<double>> d(meter_t<double>(3), centimeter_t<double>(400));
+  ASSERT_EQ(norm(d), meter_t<double>(5));
+  ASSERT_EQ(squared_norm(d).get_value(), 25);
+  ASSERT_DOUBLE_EQ(norm(r).get_value(), std::sqrt(77.0));
+
+  // the norm neither overflows nor underflows
+  const vec<4, meter_t<double>> huge(meter_t<double>(1e300), meter_t<double>(1e300), meter_t<double>(1e300), meter_t<double>(1e300));
+  ASSERT_DOUBLE_EQ(norm(huge).get_value(), 2e300);
+
+  // directions are dimensionless
+  const auto u = normalize(d);
+  static_assert(concepts::dimensionless_quantity<decltype(u)::quantity_type>);
+  ASSERT_DOUBLE_EQ(double(u[0]), 0.6);
+  ASSERT_DOUBLE_EQ(double(u[1]), 0.8);
+
+  // integral vectors have exact squared norms
+  const vec<3, meter_t<int>> n(meter_t<int>(1), meter_t<int>(2), meter_t<int>(2));
+  ASSERT_EQ(squared_norm(n).get_value(), 9);
+  ASSERT_EQ(norm(n), meter_t<double>(3));
+}
+
+TEST(linalg, matrices) {
+  using dimensionless = quantity<make_unit<>, double>;
+  using length = vec<2, meter_t<double>>;
+
+  // rotation by 90 degrees
+  const mat<2, 2, dimensionless> rotation(
+    vec<2, dimensionless>(dimensionless(0), dimensionless(-1)),
+    vec<2, dimensionless>(dimensionless(1), dimensionless(0)));
+
+  const length x(meter_t<double>(1), meter_t<double>(2));
+  const auto y = rotation * x;
+  static_assert(std::is_same_v<decltype(y)::unit_type, meter>);
+  ASSERT_EQ(y, length(meter_t<double>(-2), meter_t<double>(1)));
+
+  ASSERT_EQ(rotation * transpose(rotation), (mat<2, 2, dimensionless>::identity()));
+  ASSERT_EQ(rotation * rotation * rotation * rotation * x, x);
+
+  // the unit of the product of matrices is the product of their units
+  const mat<2, 3, newton_t<double>> a(
+    vec<3, newton_t<double>>(newton_t<double>(1), newton_t<double>(2), newton_t<double>(3)),
+    vec<3, newton_t<double>>(newton_t<double>(4), newton_t<double>(5), newton_t<double>(6)));
+  const auto b = transpose(a) * second_t<double>(1);
+  const auto c = a * b;
+  static_assert(std::is_same_v<decltype(c), const mat<2, 2, quantity<make_unit<newton, newton, second>, double>>>);
+  ASSERT_EQ(c(0, 0).get_value(), 14);
+  ASSERT_EQ(c(0, 1).get_value(), 32);
+  ASSERT_EQ(c(1, 0).get_value(), 32);
+  ASSERT_EQ(c(1, 1).get_value(), 77);
+  ASSERT_EQ(a.column(2), (vec<2, newton_t<double>>(newton_t<double>(3), newton_t<double>(6))));
+
+  ASSERT_EQ((a - a) * 3.0, (mat<2, 3, newton_t<double>>()));
+}
+
+TEST(linalg, batches) {
+  constexpr std::size_t n = 1001;
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> dist(-10, 10);
+
+  vec_aos<3, meter_t<double>> aos;
+  vec_soa<3, meter_t<double>> soa;
+  vec_soa<3, newton_t<double>> forces(n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const vec<3, meter_t<double>> v(meter_t<double>(dist(rng)), meter_t<double>(dist(rng)), meter_t<double>(dist(rng)));
+    aos.push_back(v);
+    soa.push_back(v);
+    forces.set(i, vec<3, newton_t<double>>(newton_t<double>(dist(rng)), newton_t<double>(dist(rng)), newton_t<double>(dist(rng))));
+  }
+
+  // vectors that overflow are computed exactly
+  aos[7] = vec<3, meter_t<double>>(meter_t<double>(1e200), meter_t<double>(1e200), meter_t<double>(0));
+  soa.set(7, aos[7]);
+  aos[8] = vec<3, meter_t<double>>();
+  soa.set(8, aos[8]);
+
+  ASSERT_EQ(soa.size(), n);
+  ASSERT_EQ(soa[5], aos[5]);
+  ASSERT_EQ(soa.elements(1)[5], aos[5][1]);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(soa.elements(2).data()) % 64, 0);
+
+  std::vector<meter_t<double>> norms_aos(n), norms_soa(n);
+  ASSERT_EQ(norm(aos, norms_aos).size(), n);
+  ASSERT_EQ(norm(soa, norms_soa).size(), n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    ASSERT_NEAR(norms_aos[i].get_value(), norm(aos[i]).get_value(), 1e-15*norm(aos[i]).get_value());
+    ASSERT_EQ(norms_aos[i], norms_soa[i]);
+  }
+  ASSERT_DOUBLE_EQ(norms_soa[7].get_value(), std::sqrt(2.0)*1e200);
+  ASSERT_EQ(norms_soa[8].get_value(), 0);
+
+  std::vector<quantity<make_unit<meter, newton>, double>> work(n - 1);
+  ASSERT_EQ(dot(soa, forces, work).size(), n - 1);
+  for (std::size_t i = 0; i < n - 1; ++i)
+    ASSERT_DOUBLE_EQ(work[i].get_value(), dot(soa[i], forces[i]).get_value());
+
+  // the arrays of elements are ranges of quantities, reduced as such
+  double squares = 0;
+  for (const auto& v : aos)
+    squares += v[0].get_value() * v[0].get_value();
+  ASSERT_DOUBLE_EQ(dot(soa.elements(0), soa.elements(0)).get_value(), squares);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
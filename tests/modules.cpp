@@ -0,0 +1,25 @@
+// the macros are not exported by the modules, and must be included before them
+#include <units/details/macros.h>
+
+import units;
+
+namespace units {
+  // a unit defined outside the library
+  units_add_derived_unit(parsec, pc, make_unit<ratio<30856775814913673>, meter>);
+}
+
+// gcc 12 cannot include the standard headers after importing the modules, so this
+// test is not written with googletest
+int main(void) {
+  using namespace units;
+  using namespace units::literals;
+
+  bool ok = true;
+  ok = ok && (meter_t<>(3) + kilometer_t<>(1)).get_value() == 1003;
+  ok = ok && (1_km).convert<meter>().get_value() == 1000;
+  ok = ok && parsec_t<>(1).convert<kilometer>().get_value() == 30856775814913.673;
+  ok = ok && math::sqrt(quantity<make_unit<squared<meter>>>(4)).get_value() == 2;
+  ok = ok && math::sin(degree_t<>(30)) == 0.5;
+
+  return ok? 0 : 1;
+}
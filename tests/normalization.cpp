@@ -0,0 +1,155 @@
+#include <units/normalization.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace units;
+
+TEST(normalization, plans) {
+  const auto plan = make_plan(descriptor_of<mile>, descriptor_of<kilometer>);
+  ASSERT_TRUE(plan.has_value());
+  ASSERT_EQ(plan->ratio, runtime_ratio::make(1609344, 1000000));
+  ASSERT_DOUBLE_EQ((*plan)(1), 1.609344);
+
+  double values[3] = {1, 2, 0.5};
+  (*plan)(values, 3);
+  ASSERT_DOUBLE_EQ(values[1], 3.218688);
+
+  // integral values are scaled exactly
+  const auto exact = make_plan<int>(descriptor_of<kilometer>, descriptor_of<meter>);
+  ASSERT_EQ((*exact)(3), 3000);
+
+  ASSERT_FALSE(make_plan(descriptor_of<meter>, descriptor_of<second>).has_value());
+}
+
+TEST(normalization, sources) {
+  normalizer<meter_t<double>> lengths;
+
+  // units are registered once, by descriptor, by type or by symbol
+  const auto ft = lengths.source("ft");
+  const auto m = lengths.source<meter>();
+  const auto mi = lengths.source(descriptor_of<mile>);
+  ASSERT_TRUE(ft && m && mi);
+  ASSERT_EQ(lengths.source<foot>(), ft);
+  ASSERT_EQ(lengths.sources(), 3);
+  ASSERT_DOUBLE_EQ(lengths.plan(*ft).factor, 0.3048);
+
+  ASSERT_FALSE(lengths.source("s").has_value());
+  ASSERT_FALSE(lengths.source("not a unit").has_value());
+  ASSERT_EQ(lengths.sources(), 3);
+
+  // records come out in the order they were pushed
+  lengths.push(*ft, 10);
+  lengths.push(*mi, 1);
+  lengths.push(*m, 2);
+  lengths.push(*ft, 1);
+  ASSERT_EQ(lengths.size(), 4);
+
+  const auto out = lengths.flush();
+  ASSERT_EQ(lengths.size(), 0);
+  ASSERT_EQ(out.size(), 4);
+  ASSERT_DOUBLE_EQ(out[0].get_value(), 3.048);
+  ASSERT_DOUBLE_EQ(out[1].get_value(), 1609.344);
+  ASSERT_EQ(out[2], meter_t<double>(2));
+  ASSERT_DOUBLE_EQ(out[3].get_value(), 0.3048);
+
+  // identifiers of unregistered sources are rejected
+  ASSERT_FALSE(lengths.push(lengths.sources(), 1));
+  const std::vector<std::size_t> ids = {*m, 7};
+  const std::vector<double> values = {1, 2};
+  ASSERT_FALSE(lengths.push(ids, values));
+  ASSERT_EQ(lengths.size(), 0);
+
+  // identifiers remain valid after a flush, and short outputs are not written
+  ASSERT_TRUE(lengths.push(*m, 5));
+  std::vector<meter_t<double>> none;
+  ASSERT_TRUE(lengths.flush(none).empty());
+  ASSERT_EQ(lengths.flush()[0], meter_t<double>(5));
+}
+
+TEST(normalization, dynamic) {
+  normalizer<kilometer_t<double>> lengths;
+
+  ASSERT_TRUE(lengths.push(dynamic_quantity(meter_t<double>(500))));
+  ASSERT_TRUE(lengths.push(dynamic_quantity(meter_t<double>(1500))));
+  ASSERT_TRUE(lengths.push(dynamic_quantity(mile_t<int>(2))));
+  ASSERT_FALSE(lengths.push(dynamic_quantity(second_t<double>(1))));
+  ASSERT_EQ(lengths.sources(), 2);
+
+  const auto out = lengths.flush();
+  ASSERT_EQ(out.size(), 3);
+  ASSERT_EQ(out[0], kilometer_t<double>(0.5));
+  ASSERT_EQ(out[1], kilometer_t<double>(1.5));
+  ASSERT_DOUBLE_EQ(out[2].get_value(), 3.218688);
+
+  // floating-point values are converted before they are truncated
+  normalizer<meter_t<int>> meters;
+  ASSERT_TRUE(meters.push(dynamic_quantity(1.5, descriptor_of<kilometer>)));
+  ASSERT_TRUE(meters.push(dynamic_quantity(kilometer_t<int>(2))));
+  ASSERT_EQ(meters.flush(), (std::vector{meter_t<int>(1500), meter_t<int>(2000)}));
+
+  // with no other source than their own unit, as the target is not registered
+  ASSERT_EQ(meters.sources(), 1);
+  ASSERT_EQ(meters.plan(0).source, descriptor_of<kilometer>);
+
+  // values that do not fit in the value type are rejected
+  ASSERT_FALSE(meters.push(dynamic_quantity(3e6, descriptor_of<kilometer>)));
+  ASSERT_FALSE(meters.push(dynamic_quantity(std::nan(""), descriptor_of<kilometer>)));
+  ASSERT_TRUE(meters.push(dynamic_quantity(-2e6, descriptor_of<kilometer>)));
+  ASSERT_EQ(meters.size(), 1);
+  ASSERT_EQ(meters.flush(), std::vector{meter_t<int>(-2'000'000'000)});
+
+  // as are integral values of another type
+  normalizer<millimeter_t<int>> millimeters;
+  ASSERT_FALSE(millimeters.push(dynamic_quantity(5'000'000'000ll, descriptor_of<millimeter>)));
+  ASSERT_TRUE(millimeters.push(dynamic_quantity(2'000'000'000ll, descriptor_of<millimeter>)));
+  ASSERT_EQ(millimeters.flush(), std::vector{millimeter_t<int>(2'000'000'000)});
+}
+
+TEST(normalization, overflow) {
+  normalizer<millimeter_t<int>> millimeters;
+  const auto km = millimeters.source<kilometer>();
+
+  // integral values that do not fit once converted fail the flush, and are kept
+  ASSERT_TRUE(millimeters.push(*km, 2));
+  ASSERT_TRUE(millimeters.push(*km, 3'000'000));
+
+  std::vector<millimeter_t<int>> out(2);
+  ASSERT_TRUE(millimeters.flush(out).empty());
+  ASSERT_TRUE(millimeters.flush().empty());
+  ASSERT_EQ(millimeters.size(), 2);
+}
+
+TEST(normalization, batch) {
+  normalizer<meter_t<double>> lengths;
+  const std::vector<std::size_t> units = {*lengths.source("ft"), *lengths.source("m"), *lengths.source("mi"), *lengths.source("km")};
+
+  std::mt19937_64 rng(3);
+  std::uniform_int_distribution<std::size_t> pick(0, units.size() - 1);
+  std::uniform_real_distribution<double> value(0, 100);
+
+  std::vector<std::size_t> ids(1000);
+  std::vector<double> values(ids.size());
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    ids[i] = units[pick(rng)];
+    values[i] = value(rng);
+  }
+
+  ASSERT_TRUE(lengths.push(ids, values));
+  std::vector<meter_t<double>> out(ids.size());
+  ASSERT_EQ(lengths.flush(out).size(), out.size());
+
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    const auto expected = dynamic_quantity(values[i], lengths.plan(ids[i]).source).convert<meter>();
+    ASSERT_DOUBLE_EQ(out[i].get_value(), expected->get_value());
+  }
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,181 @@
+#include <units/angular.h>
+#include <units/math.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <experimental/simd>
+#include <type_traits>
+
+using namespace units;
+
+namespace stdx = std::experimental;
+
+using pack_d = pack<double, 4>;
+using simd_d = stdx::fixed_size_simd<double, 4>;
+
+static_assert(concepts::pack<pack_d>);
+static_assert(concepts::pack<simd_d>);
+static_assert(concepts::pack<stdx::native_simd<float>>);
+static_assert(!concepts::pack<double>);
+static_assert(std::is_same_v<meter_t<pack_d>::element_type, double>);
+
+// the layout of packs does not depend on the compiler flags
+static_assert(pack<double>::size() == 2 && pack<float>::size() == 4 && pack<char>::size() == 16);
+static_assert(sizeof(pack_d) == 32 && alignof(pack_d) == 16);
+static_assert(alignof(pack<float, 2>) == 8 && alignof(pack<double, 8>) == 16);
+
+// * a pack whose elements are f(0), f(1), ...
+template <class P, class F>
+P make(F f) {
+  P ret;
+  for (std::size_t j = 0; j < P::size(); ++j)
+    ret[j] = f(double(j));
+  return ret;
+}
+
+TEST(packs, pack) {
+  const pack_d a = make<pack_d>([](double j) {return j + 1;});
+  const pack_d b(2);
+
+  const auto c = a*b - 1;
+  for (std::size_t j = 0; j < a.size(); ++j)
+    ASSERT_EQ(c[j], 2*a[j] - 1);
+
+  ASSERT_TRUE(all_of(a > 0));
+  ASSERT_TRUE(any_of(a == b));
+  ASSERT_FALSE(all_of(a == b));
+  ASSERT_EQ(select(a < b, a, b)[3], 2);
+
+  double values[4] = {};
+  (a/b).copy_to(values);
+  ASSERT_EQ(values[1], 1);
+}
+
+template <class P>
+void arithmetic() {
+  const quantity<meter, P> a(make<P>([](double j) {return j;}));
+  const quantity<kilometer, P> b(P(1));
+
+  // operations of quantities apply to every element
+  const auto sum = a + b;
+  static_assert(std::is_same_v<std::remove_cvref_t<decltype(sum)>, quantity<meter, P>>);
+  const auto speed = sum/second_t<double>(2);
+  const P ratio = a/b;
+
+  for (std::size_t j = 0; j < P::size(); ++j) {
+    ASSERT_EQ(sum.get_value()[j], 1000 + double(j));
+    ASSERT_EQ(speed.get_value()[j], 500 + double(j)/2);
+    ASSERT_DOUBLE_EQ(ratio[j], double(j)/1000);
+  }
+
+  // conversions and comparisons
+  const quantity<centimeter, P> cm(a);
+  ASSERT_EQ(cm.get_value()[3], 300);
+  ASSERT_TRUE(all_of(a < b));
+  ASSERT_TRUE(any_of(a == meter_t<double>(2)));
+  ASSERT_EQ((2*a).get_value()[3], 6);
+
+  // integral packs are converted by integral factors only
+  const quantity<kilometer, pack<int, 4>> n(pack<int, 4>(3));
+  ASSERT_TRUE(all_of(n.convert<meter>().get_value() == pack<int, 4>(3000)));
+}
+
+TEST(packs, arithmetic) {
+  arithmetic<pack_d>();
+  arithmetic<simd_d>();
+}
+
+template <class P>
+void functions() {
+  const auto x = make<P>([](double j) {return 0.5 + j;});
+  const quantity<make_unit<meter, meter>, P> area(x);
+  const quantity<make_unit<>, P> number(x);
+
+  const auto side = math::sqrt(area);
+  static_assert(std::is_same_v<decltype(side), const quantity<meter, P>>);
+  const auto cube = math::pow<3>(side);
+  const auto diagonal = math::hypot(side, centimeter_t<P>(P(50)));
+
+  // the same numbers as the functions of single values
+  for (std::size_t j = 0; j < P::size(); ++j) {
+    const double v = x[j];
+    ASSERT_DOUBLE_EQ(side.get_value()[j], math::sqrt(quantity<make_unit<meter, meter>, double>(v)).get_value());
+    ASSERT_DOUBLE_EQ(cube.get_value()[j], std::pow(std::sqrt(v), 3));
+    ASSERT_DOUBLE_EQ(diagonal.get_value()[j], std::hypot(std::sqrt(v), 0.5));
+    ASSERT_DOUBLE_EQ(math::exp(number)[j], std::exp(v));
+    ASSERT_DOUBLE_EQ(math::log(number)[j], std::log(v));
+    ASSERT_DOUBLE_EQ(math::cbrt(number)[j], std::cbrt(v));
+    ASSERT_EQ(math::floor(side).get_value()[j], std::floor(std::sqrt(v)));
+  }
+
+  ASSERT_TRUE(all_of(math::abs(-side) == side));
+  ASSERT_TRUE(all_of(math::max(-side, meter_t<P>(P(0))) == meter_t<double>(0)));
+  ASSERT_TRUE(all_of(math::min(side, meter_t<P>(P(1))) <= meter_t<double>(1)));
+  ASSERT_TRUE(all_of(math::min(-side, centimeter_t<P>(P(0))) == -side));
+  ASSERT_TRUE(all_of(math::fdim(side, meter_t<P>(P(1))) == math::max(side - meter_t<double>(1), meter_t<P>(P(0)))));
+  ASSERT_TRUE(none_of(math::isnan(side)));
+  ASSERT_TRUE(all_of(math::isnan(math::sqrt(-area))));
+}
+
+TEST(packs, functions) {
+  functions<pack_d>();
+  functions<simd_d>();
+}
+
+TEST(packs, qualified) {
+  // functions of packs are found in units::math, as those of numbers
+  const meter_t<pack_d> a(make<pack_d>([](double j) {return j + 1;}));
+  const meter_t<pack_d> b(pack_d(2));
+  const pack_d ratio = a/b;
+
+  const auto exp = math::exp(ratio);
+  const auto log = math::log(ratio);
+  const auto square = math::pow(ratio, 2.0);
+  const auto smaller = math::min(ratio, pack_d(1));
+  const auto larger = math::max(ratio, pack_d(1));
+  for (std::size_t j = 0; j < ratio.size(); ++j) {
+    ASSERT_DOUBLE_EQ(exp[j], std::exp(ratio[j]));
+    ASSERT_DOUBLE_EQ(log[j], std::log(ratio[j]));
+    ASSERT_DOUBLE_EQ(square[j], ratio[j]*ratio[j]);
+    ASSERT_EQ(smaller[j], std::min(ratio[j], 1.0));
+    ASSERT_EQ(larger[j], std::max(ratio[j], 1.0));
+  }
+
+  ASSERT_TRUE(all_of(math::min(a, b) == meter_t<pack_d>(math::min(a.get_value(), b.get_value()))));
+  ASSERT_TRUE(none_of(math::isnan(ratio)));
+}
+
+template <class P>
+void angles() {
+  const degree_t<P> right(make<P>([](double j) {return 90*j;}));
+  const auto [sin, cos] = math::sincos(right);
+
+  // multiples of right angles are exact, as for single angles
+  for (std::size_t j = 0; j < P::size(); ++j) {
+    ASSERT_EQ(sin[j], math::sin(degree_t<double>(90*double(j))));
+    ASSERT_EQ(cos[j], math::cos(degree_t<double>(90*double(j))));
+  }
+
+  const radian_t<P> x(make<P>([](double j) {return 0.3*j - 0.4;}));
+  const meter_t<P> y(make<P>([](double j) {return j - 1;}));
+  for (std::size_t j = 0; j < P::size(); ++j) {
+    const double v = x.get_value()[j];
+    ASSERT_DOUBLE_EQ(math::sin(x)[j], std::sin(v));
+    ASSERT_DOUBLE_EQ(math::tan(x)[j], std::tan(v));
+    ASSERT_DOUBLE_EQ(math::asin(x.get_value()).get_value()[j], std::asin(v));
+    ASSERT_DOUBLE_EQ(math::atan2(y, centimeter_t<double>(100)).get_value()[j], std::atan2(double(j) - 1, 1));
+  }
+}
+
+TEST(packs, angles) {
+  angles<pack_d>();
+  angles<simd_d>();
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
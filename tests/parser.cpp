@@ -0,0 +1,87 @@
+#include <units/parser.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+
+using namespace units;
+
+TEST(dimension, packedExponents) {
+  constexpr auto a = dimension::base(0, 3) * dimension::base(9, -2);
+
+  static_assert(a.exponent(0) == 3 && a.exponent(9) == -2 && a.exponent(4) == 0);
+  static_assert((a / a).dimensionless());
+  static_assert(a.inverse().exponent(9) == 2);
+  static_assert(a.pow(-3).exponent(0) == -9 && a.pow(-3).exponent(9) == 6);
+
+  // exponents out of the range of a field, and unknown base ids, are invalid
+  ASSERT_FALSE(dimension::base(0, dimension::max_exponent + 1).valid());
+  ASSERT_FALSE(dimension::base(dimension::size).valid());
+  ASSERT_FALSE((dimension::base(1, dimension::max_exponent) * dimension::base(1)).valid());
+  ASSERT_FALSE(dimension::base(1, dimension::min_exponent).inverse().valid());
+  ASSERT_FALSE(a.pow(16).valid());
+  ASSERT_FALSE((dimension::invalid() / dimension::invalid()).valid());
+}
+
+TEST(runtimeRatio, arithmetic) {
+  static_assert(runtime_ratio::make(6, -4) == runtime_ratio{-3, 2});
+  static_assert(runtime_ratio::make(2, 3) * runtime_ratio::make(9, 4) == runtime_ratio{3, 2});
+  static_assert(runtime_ratio::make(2, 3).pow(-3) == runtime_ratio{27, 8});
+  constexpr auto min = std::numeric_limits<std::int64_t>::min();
+  static_assert(runtime_ratio::make(min, -1).num == -runtime_ratio::make(min, 1).num);
+  static_assert(runtime_ratio::make(min, -1).den == 1);
+
+  ASSERT_FALSE(runtime_ratio::make(1, 0).valid());
+  ASSERT_FALSE(runtime_ratio::make(0, 1).inverse().valid());
+  ASSERT_FALSE(runtime_ratio::make(10, 1).pow(40).valid());
+}
+
+TEST(parser, symbols) {
+  ASSERT_EQ(parse_unit("m"), descriptor_of<meter>);
+  ASSERT_EQ(parse_unit("kg"), descriptor_of<kilogram>);
+  ASSERT_EQ(parse_unit("km"), descriptor_of<kilometer>);
+  ASSERT_EQ(parse_unit("dam"), descriptor_of<decameter>);
+  ASSERT_EQ(parse_unit("MeV"), (descriptor_of<make_unit<mega, electronvolt>>));
+  ASSERT_EQ(parse_unit("µs"), descriptor_of<microsecond>);
+  ASSERT_EQ(parse_unit("min"), descriptor_of<minute>);
+  ASSERT_EQ(parse_unit("cd"), descriptor_of<candela>);
+  ASSERT_EQ(parse_unit("deg"), descriptor_of<degree>);
+
+  // prefixes only apply to units of the SI
+  ASSERT_FALSE(parse_unit("kmin"));
+  ASSERT_FALSE(parse_unit("kkg"));
+  ASSERT_FALSE(parse_unit("furlongs"));
+}
+
+TEST(parser, expressions) {
+  ASSERT_EQ(parse_unit("kg m s^-2"), descriptor_of<newton>);
+  ASSERT_EQ(parse_unit("kg*m/s^2"), descriptor_of<newton>);
+  ASSERT_EQ(parse_unit("km/h"), (descriptor_of<make_unit<kilometer, inverse<hour>>>));
+  ASSERT_EQ(parse_unit("uSv/h"), (descriptor_of<make_unit<micro, sievert, inverse<hour>>>));
+  ASSERT_EQ(parse_unit("mGy"), (descriptor_of<make_unit<milli, gray>>));
+  ASSERT_EQ(parse_unit("J/(kg K)"), (descriptor_of<make_unit<joule, inverse<kilogram>, inverse<kelvin>>>));
+  ASSERT_EQ(parse_unit("  N·m^(2/2) "), descriptor_of<joule>);
+  ASSERT_EQ(parse_unit("(m s)^-1"), (descriptor_of<make_unit<inverse<meter>, inverse<second>>>));
+  ASSERT_EQ(parse_unit("60 s"), descriptor_of<minute>);
+
+  static_assert(*parse_unit("W h") == descriptor_of<make_unit<watt, hour>>);
+
+  for (const auto s : {"", "m^", "m^(1/2)", "(m", "m)", "m//s", "m s^x", "2^-1 m^-", "m^99"})
+    ASSERT_FALSE(parse_unit(s)) << s;
+}
+
+TEST(parser, composedSymbols) {
+  // symbols composed by the library can be parsed back
+  using speed = make_unit<kilometer, inverse<hour>>;
+  using area = make_unit<ratio<3, 7>, joule, joule>;
+
+  ASSERT_EQ(parse_unit(speed::symbol), descriptor_of<speed>);
+  ASSERT_EQ(parse_unit(area::symbol), descriptor_of<area>);
+  ASSERT_EQ(parse_unit(make_unit<newton, meter, second>::symbol), (descriptor_of<make_unit<newton, meter, second>>));
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,47 @@
+#include <units/math.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+using namespace units;
+
+// this test is compiled with units_prebuilt defined and linked with libphys-units,
+// so the quantities below use the instantiations compiled in the library
+
+TEST(prebuilt, declared) {
+#if !defined(units_prebuilt)
+  FAIL() << "units_prebuilt is not defined";
+#endif
+}
+
+TEST(prebuilt, quantities) {
+  meter_t<> a(1.5);
+  ++a;
+  ASSERT_EQ(a.get_value(), 2.5);
+  ASSERT_EQ((a + meter_t<>(0.5)).get_value(), 3);
+  ASSERT_EQ((-a).get_value(), -2.5);
+  ASSERT_EQ(hour_t<>(2).convert<hour>().get_value(), 2);
+
+  // conversions and operations between units remain instantiated where they are used
+  ASSERT_EQ((kilometer_t<>(1) + meter_t<>(1)).get_value(), 1.001);
+  ASSERT_EQ(hour_t<>(2).convert<minute>().get_value(), 120);
+  ASSERT_EQ(math::abs(-a), a);
+}
+
+TEST(prebuilt, symbols) {
+  std::ostringstream os;
+  os << joule_t<>(3) << ", " << millisecond_t<>(0.5) << ", " << electronvolt_t<>(1);
+  ASSERT_EQ(os.str(), "3 J, 0.5 ms, 1 eV");
+
+  // quantities that are not prebuilt are printed too
+  os.str("");
+  os << quantity<make_unit<meter, inverse<second>>>(3);
+  ASSERT_EQ(os.str(), "3 m s^-1 ");
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
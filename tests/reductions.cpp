@@ -0,0 +1,106 @@
+#include <units/numeric.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <random>
+#include <vector>
+
+#define ASSERT_SAME(...) ASSERT_TRUE((std::is_same_v<__VA_ARGS__>))
+
+using namespace units;
+
+TEST(reductions, sum) {
+  std::vector<meter_t<>> lengths;
+  for (const double x : {1.5, 2.5, -1.0, 4.0})
+    lengths.emplace_back(x);
+
+  ASSERT_EQ(sum(lengths), meter_t<>(7));
+  ASSERT_EQ(sum<summation::naive>(lengths), meter_t<>(7));
+  ASSERT_EQ(sum<summation::kahan>(lengths), meter_t<>(7));
+  ASSERT_EQ(sum(std::vector<meter_t<>>()), meter_t<>(0));
+
+  // the sum is converted once to the unit of init
+  ASSERT_EQ(reduce(lengths, kilometer_t<>(1)), kilometer_t<>(1.007));
+  ASSERT_SAME(decltype(reduce(lengths, kilometer_t<>(1))), kilometer_t<>);
+
+  // integral quantities are summed exactly
+  std::vector<second_t<std::int64_t>> times(100001, second_t<std::int64_t>(3));
+  ASSERT_EQ(sum(times).get_value(), 300003);
+  ASSERT_EQ(reduce(times, second_t<std::int64_t>(60)).get_value(), 300063);
+}
+
+TEST(reductions, dotAndMean) {
+  std::vector<newton_t<>> forces;
+  std::vector<meter_t<>> displacements;
+  for (int i = 1; i <= 4; ++i) {
+    forces.emplace_back(i);
+    displacements.emplace_back(0.5*i);
+  }
+
+  // the unit of the result is the product of the units
+  const auto work = dot(forces, displacements);
+  ASSERT_SAME(decltype(work), const joule_t<>);
+  ASSERT_EQ(work, joule_t<>(15));
+
+  // the shortest range sets the number of terms
+  displacements.pop_back();
+  ASSERT_EQ(dot(forces, displacements), joule_t<>(7));
+
+  ASSERT_EQ(mean(forces), newton_t<>(2.5));
+  ASSERT_TRUE(std::isnan(mean(std::vector<newton_t<>>()).get_value()));
+
+  // the mean of integral quantities is a double
+  std::vector<second_t<int>> times = {second_t<int>(1), second_t<int>(2)};
+  ASSERT_SAME(decltype(mean(times)), second_t<double>);
+  ASSERT_EQ(mean(times), second_t<>(1.5));
+}
+
+TEST(reductions, accuracy) {
+  // a million terms which are not exactly representable, across several chunks
+  std::mt19937_64 engine(3);
+  std::uniform_real_distribution<double> dist(0, 1);
+
+  std::vector<joule_t<>> deposits(1 << 20);
+  long double exact = 0;
+  for (auto& x : deposits) {
+    x = joule_t<>(dist(engine) * 0.1);
+    exact += x.get_value();
+  }
+
+  const auto error = [&](const joule_t<> s) {return std::abs(s.get_value() - double(exact)) / double(exact);};
+  const double eps = std::numeric_limits<double>::epsilon();
+
+  ASSERT_LE(error(sum<summation::kahan>(deposits)), eps);
+  ASSERT_LE(error(sum<summation::pairwise>(deposits)), 4*eps);
+  ASSERT_LE(error(sum<summation::naive>(deposits)), 1e5*eps);
+  ASSERT_LE(error(mean<summation::kahan>(deposits)*double(deposits.size())), eps);
+}
+
+TEST(reductions, parallel) {
+  std::mt19937_64 engine(5);
+  std::uniform_real_distribution<double> dist(-1, 1);
+
+  std::vector<watt_t<>> powers(300001);
+  std::vector<second_t<>> durations(powers.size());
+  for (std::size_t i = 0; i < powers.size(); ++i) {
+    powers[i] = watt_t<>(dist(engine));
+    durations[i] = second_t<>(dist(engine));
+  }
+
+  // results do not depend on the execution policy
+  ASSERT_EQ(sum(std::execution::par, powers), sum(powers));
+  ASSERT_EQ(sum<summation::kahan>(std::execution::par_unseq, powers), sum<summation::kahan>(powers));
+  ASSERT_EQ(dot(std::execution::par, powers, durations), dot(powers, durations));
+  ASSERT_EQ(mean<summation::naive>(std::execution::par, powers), mean<summation::naive>(powers));
+  ASSERT_EQ(reduce(std::execution::par, powers, watt_t<>(1)), reduce(powers, watt_t<>(1)));
+  ASSERT_SAME(decltype(dot(std::execution::par, powers, durations)), joule_t<>);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
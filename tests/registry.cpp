@@ -0,0 +1,101 @@
+#include <units/parser.h>
+#include <units/registry.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+using namespace units;
+
+namespace units {
+  // a unit defined outside the library
+  units_add_derived_unit(parsec, pc, make_unit<ratio<30856775814913673>, meter>);
+}
+
+TEST(registry, names) {
+  static_assert(_details::_unit::name<meter> == "meter");
+  static_assert(_details::_unit::name<kilometer> == "kilometer");
+  static_assert(_details::_unit::name<arcsecond> == "arcsecond");
+  static_assert(_details::_unit::name<parsec> == "parsec");
+
+  // units composed by the library have no name
+  static_assert(_details::_unit::name<make_unit<meter, second>>.empty());
+}
+
+TEST(registry, fingerprints) {
+  // fingerprints depend on the unit only, not on the way it was written
+  static_assert(fingerprint_of<kilometer> == fingerprint_of<make_unit<kilo, meter>>);
+  static_assert(fingerprint_of<sievert> == fingerprint_of<gray>);
+  static_assert(fingerprint(*parse_unit("km")) == fingerprint_of<kilometer>);
+  static_assert(fingerprint(*parse_unit("J/kg")) == fingerprint_of<gray>);
+
+  static_assert(fingerprint_of<meter> != fingerprint_of<kilometer>);
+  static_assert(fingerprint_of<hertz> != fingerprint_of<becquerel>);
+  static_assert(fingerprint(unit_descriptor::invalid()) == 0);
+
+  // the hash is stable: these values may be stored and must never change
+  ASSERT_EQ(fingerprint_of<meter>, 0x7e47977f4ada7f83);
+  ASSERT_EQ(fingerprint_of<kilometer>, 0x59318a685257bacd);
+
+  // all registered fingerprints are distinct, and none is null
+  std::set<std::uint64_t> seen;
+  for (const auto& entry : registry::all()) {
+    ASSERT_NE(entry.fingerprint, 0);
+    ASSERT_TRUE(seen.insert(entry.fingerprint).second);
+  }
+}
+
+TEST(registry, tables) {
+  static_assert(registry::size == registry::entries.size());
+  static_assert(registry::contains<meter> && !registry::contains<parsec>);
+  static_assert(registry::index_of<meter> == 0);
+  static_assert(registry::entries[registry::index_of<degree>].symbol == "deg");
+
+  // lookups are constant expressions
+  static_assert(registry::find_name("kilometer")->unit == descriptor_of<kilometer>);
+  static_assert(registry::find_symbol("arcsec")->name == "arcsecond");
+  static_assert(registry::find(fingerprint_of<hour>)->symbol == "h");
+  static_assert(registry::find(*parse_unit("60 min"))->name == "hour");
+
+  // every entry is found by each of its keys
+  for (const auto& entry : registry::all()) {
+    ASSERT_EQ(registry::find_name(entry.name), &entry);
+    ASSERT_EQ(registry::find_symbol(entry.symbol), &entry);
+    ASSERT_EQ(registry::find(entry.fingerprint), &entry);
+    ASSERT_EQ(registry::find(entry.unit), &entry);
+  }
+
+  // unregistered units are not found
+  ASSERT_EQ(registry::find_name("parsec"), nullptr);
+  ASSERT_EQ(registry::find_symbol("pc"), nullptr);
+  ASSERT_EQ(registry::find_symbol(""), nullptr);
+  ASSERT_EQ(registry::find(fingerprint_of<parsec>), nullptr);
+  ASSERT_EQ(registry::find(descriptor_of<make_unit<meter, second>>), nullptr);
+  ASSERT_EQ(registry::find(unit_descriptor::invalid()), nullptr);
+
+  // no seed is searched for duplicate keys, which are rejected instead
+  using symbols = std::array<std::string_view, 3>;
+  ASSERT_THROW(_details::_registry::perfect_hash<3>(symbols{"m", "s", "m"}), std::invalid_argument);
+  ASSERT_NO_THROW(_details::_registry::perfect_hash<3>(symbols{"m", "s", "kg"}));
+}
+
+TEST(registry, customRegistry) {
+  using astronomy = unit_registry<unit_list_cat<library_units, unit_list<parsec>>>;
+
+  static_assert(astronomy::size == registry::size + 1);
+  ASSERT_EQ(astronomy::find_symbol("pc")->name, "parsec");
+  ASSERT_EQ(astronomy::find_name("meter")->symbol, "m");
+
+  using empty = unit_registry<unit_list<>>;
+  ASSERT_EQ(empty::size, 0);
+  ASSERT_EQ(empty::find_name("meter"), nullptr);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,212 @@
+#include <units/angular.h>
+#include <units/math.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#define ASSERT_SAME(...) ASSERT_TRUE((std::is_same_v<__VA_ARGS__>))
+
+using namespace units;
+
+// sine and cosine of x, in units of which a quarter turn is q, reduced exactly
+// in long double precision
+void reference(const long double x, const long double q, long double& s, long double& c) {
+  long double r = std::fmod(x, 4*q);
+  const long double k = std::nearbyint(r/q);
+  r -= k*q;
+
+  const long double theta = r * (3.14159265358979323846264338327950288L/2) / q;
+  const long double a = std::sin(theta), b = std::cos(theta);
+
+  switch ((static_cast<long long>(k) % 4 + 4) % 4) {
+    case 0: s = a; c = b; break;
+    case 1: s = b; c = -a; break;
+    case 2: s = -a; c = -b; break;
+    default: s = -b; c = a; break;
+  }
+}
+
+// distance, in units in the last place, between a result and a reference
+template <class T>
+double ulps(const T value, const long double reference) {
+  if (reference == 0)
+    return value == 0? 0 : std::numeric_limits<double>::infinity();
+
+  const T rounded = static_cast<T>(reference);
+  const T ulp = std::nextafter(std::abs(rounded), std::numeric_limits<T>::infinity()) - std::abs(rounded);
+  return double(std::abs(value - reference) / ulp);
+}
+
+TEST(trigonometry, rightAngles) {
+  // multiples of a right angle are exact, whatever their magnitude
+  for (long long k = -1000; k <= 1000; ++k) {
+    for (const long long m : {1ll, 1000001ll, 1ll << 40}) {
+      const auto [s, c] = math::sincos(degree_t<>(90.0 * k * m));
+      const long long n = ((k*m) % 4 + 4) % 4;
+
+      ASSERT_EQ(s, n == 1? 1 : n == 3? -1 : 0);
+      ASSERT_EQ(c, n == 0? 1 : n == 2? -1 : 0);
+
+      // zeros are positive, as the results of std::sin and std::cos around them
+      ASSERT_FALSE(s == 0 && std::signbit(s));
+      ASSERT_FALSE(c == 0 && std::signbit(c));
+    }
+  }
+
+  ASSERT_FALSE(std::signbit(math::cos(degree_t<>(90))));
+  ASSERT_FALSE(std::signbit(math::cos(degree_t<>(-270))));
+  ASSERT_FALSE(std::signbit(math::sin(degree_t<>(-180))));
+  ASSERT_EQ(math::tan(degree_t<>(90)), std::numeric_limits<double>::infinity());
+
+  ASSERT_EQ(math::sin(degree_t<>(180)), 0);
+  ASSERT_EQ(math::cos(arcsecond_t<>(324000)), 0);
+  ASSERT_EQ(math::cos(cycle_t<>(0.5)), -1);
+  ASSERT_EQ(math::sin(pi_t<>(1)), 0);
+  ASSERT_DOUBLE_EQ(math::tan(degree_t<>(45)), 1);
+  ASSERT_EQ(math::sin(degree_t<>(30)), 0.5);
+
+  // integral angles give double results
+  ASSERT_SAME(decltype(math::sin(degree_t<int>(270))), double);
+  ASSERT_EQ(math::sin(degree_t<int>(270)), -1);
+}
+
+TEST(trigonometry, accuracy) {
+  std::mt19937_64 engine(7);
+
+  const auto check = [&]<class Q>(const Q, const long double quarter, const double range) {
+    std::uniform_real_distribution<double> dist(-range, range);
+
+    for (int i = 0; i < 100000; ++i) {
+      const double x = (i % 5 == 0)? std::round(dist(engine)) : dist(engine);
+      const auto [s, c] = math::sincos(Q(x));
+
+      long double rs, rc;
+      reference(x, quarter, rs, rc);
+
+      ASSERT_LE(ulps(s, rs), 1.2) << x;
+      ASSERT_LE(ulps(c, rc), 1.2) << x;
+    }
+  };
+
+  check(degree_t<>(), 90, 720);
+  check(degree_t<>(), 90, 1e18);
+  check(arcminute_t<>(), 5400, 1e6);
+  check(arcsecond_t<>(), 324000, 1e9);
+  check(cycle_t<>(), 0.25L, 100);
+
+  // float angles are within 1.2 ulp of float
+  std::uniform_real_distribution<float> dist(-1000, 1000);
+  for (int i = 0; i < 100000; ++i) {
+    const float x = dist(engine);
+    const auto [s, c] = math::sincos(degree_t<float>(x));
+
+    long double rs, rc;
+    reference(x, 90, rs, rc);
+
+    ASSERT_SAME(decltype(s), const float);
+    ASSERT_LE(ulps(s, rs), 1.2) << x;
+    ASSERT_LE(ulps(c, rc), 1.2) << x;
+  }
+
+  // other units are converted to radians
+  ASSERT_EQ(math::sin(radian_t<>(0.5)), std::sin(0.5));
+  ASSERT_DOUBLE_EQ(math::cos(quantity<make_unit<ratio<1, 1000>, radian>>(500)), std::cos(0.5));
+}
+
+TEST(trigonometry, specialValues) {
+  const auto inf = std::numeric_limits<double>::infinity();
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+
+  ASSERT_TRUE(std::isnan(math::sin(degree_t<>(inf))));
+  ASSERT_TRUE(std::isnan(math::cos(degree_t<>(-inf))));
+  ASSERT_TRUE(std::isnan(math::sin(degree_t<>(nan))));
+  ASSERT_TRUE(std::isinf(math::tan(degree_t<>(90))));
+
+  // angles too large for the vectorized reduction are reduced exactly too
+  const auto [s1, c1] = math::sincos(cycle_t<>(1067799978026949.5));
+  ASSERT_EQ(s1, 0);
+  ASSERT_EQ(c1, -1);
+  const auto [s2, c2] = math::sincos(cycle_t<>(6e14 + 0.25));
+  ASSERT_EQ(s2, 1);
+  ASSERT_EQ(c2, 0);
+  const auto [s3, c3] = math::sincos(pi_t<>(2e15 + 0.5));
+  ASSERT_EQ(s3, 1);
+  ASSERT_EQ(c3, 0);
+  ASSERT_EQ(math::cos(pi_t<>(std::ldexp(1.0, 52) + 1)), -1);
+  ASSERT_EQ(math::sin(degree_t<>(std::ldexp(45.0, 900))), 0);
+  ASSERT_EQ(math::cos(degree_t<>(std::ldexp(45.0, 900))), 1);
+}
+
+TEST(trigonometry, batch) {
+  std::mt19937_64 engine(11);
+  std::uniform_real_distribution<double> dist(-400, 400);
+
+  // 37 elements: several full blocks and a partial one, whatever the vector width
+  std::vector<degree_t<>> in(37);
+  for (auto& x : in)
+    x = degree_t<>(dist(engine));
+
+  in[3] = degree_t<>(std::numeric_limits<double>::infinity());
+  in[5] = degree_t<>(1e300);
+  in[36] = degree_t<>(-90);
+
+  std::vector<double> sines(in.size()), cosines(in.size() + 4);
+  const auto [s, c] = math::sincos(in, sines, cosines);
+
+  ASSERT_EQ(s.size(), in.size());
+  ASSERT_EQ(c.size(), in.size());
+
+  std::vector<double> only_sines(in.size()), only_cosines(in.size());
+  math::sin(in, only_sines);
+  math::cos(in, only_cosines);
+
+  // batch and single results are identical
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    const auto [si, ci] = math::sincos(in[i]);
+
+    if (std::isnan(si)) {
+      ASSERT_TRUE(std::isnan(sines[i]) && std::isnan(cosines[i]));
+      ASSERT_TRUE(std::isnan(only_sines[i]) && std::isnan(only_cosines[i]));
+      continue;
+    }
+
+    ASSERT_EQ(sines[i], si);
+    ASSERT_EQ(cosines[i], ci);
+    ASSERT_EQ(only_sines[i], si);
+    ASSERT_EQ(only_cosines[i], ci);
+  }
+
+  ASSERT_EQ(sines.back(), -1);
+  ASSERT_EQ(cosines[36], 0);
+
+  // float and integral angles, and radians
+  std::vector<arcsecond_t<float>> seconds(11, arcsecond_t<float>(648000));
+  std::vector<float> fs(seconds.size());
+  math::cos(seconds, fs);
+  for (const auto x : fs)
+    ASSERT_EQ(x, -1);
+
+  std::vector<degree_t<int>> degrees;
+  for (const int x : {0, 30, 90, 180, 270})
+    degrees.emplace_back(x);
+
+  std::vector<double> ds(degrees.size());
+  math::sin(degrees, ds);
+  ASSERT_EQ(ds, (std::vector<double>{0, 0.5, 1, 0, -1}));
+
+  std::vector<radian_t<>> radians = {radian_t<>(0.25), radian_t<>(1.5)};
+  std::vector<double> rs(radians.size()), rc(radians.size());
+  math::sincos(radians, rs, rc);
+  ASSERT_EQ(rs[1], std::sin(1.5));
+  ASSERT_EQ(rc[0], std::cos(0.25));
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
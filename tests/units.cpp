@@ -1,6 +1,51 @@
 #include <units/units.h>
 
+#include <string_view>
+#include <type_traits>
+
+// - composed symbols
+
+namespace {
+  using namespace units;
+
+  // the symbol of U, which must be stored in a string of exactly its length
+  template <class U>
+  constexpr bool symbol_is(const std::string_view expected) {
+    constexpr auto& text = _details::_unit::symbol_text<U>;
+    return std::remove_cvref_t<decltype(text)>::max_length == text.size() && U::symbol == expected;
+  }
+
+  // registered symbols, including those of prefixed and derived units
+  static_assert(symbol_is<meter>("m"));
+  static_assert(symbol_is<kilometer>("km"));
+  static_assert(symbol_is<newton>("N"));
+  static_assert(symbol_is<make_unit<kilogram, meter, inverse_squared<second>>>("N"));
+  static_assert(symbol_is<make_unit<newton, meter>>("J"));
+  static_assert(symbol_is<make_unit<inverse<second>>>("Hz"));
+
+  // strings made of a single character hold it
+  static_assert(_details::string('m').size() == 1 && _details::string('m') == _details::string("m"));
+  static_assert(_details::string('\0').size() == 0);
+
+  // powers, of base and of derived units, the latter by the gcd of the exponents
+  static_assert(symbol_is<make_unit<squared<meter>>>("m^2"));
+  static_assert(symbol_is<make_unit<power<meter, 3>>>("m^3"));
+  static_assert(symbol_is<make_unit<squared<newton>>>("N^2"));
+
+  // products and inverse units, with no symbol of their own
+  static_assert(symbol_is<make_unit<meter, second>>("m s "));
+  static_assert(symbol_is<make_unit<meter, inverse<second>>>("m s^-1 "));
+
+  // units with a factor, but no symbol
+  static_assert(symbol_is<make_unit<ratio<3>, meter>>("· 3 m"));
+  static_assert(symbol_is<make_unit<ratio<1, 3>, squared<meter>>>("· (1/3) m^2"));
+  static_assert(symbol_is<make_unit<ratio<1000>, newton>>("· 1000 N"));
+  static_assert(symbol_is<make_unit<ratio<1, 3>>>("· (1/3)"));
+  static_assert(symbol_is<make_unit<squared<kilometer>>>("· 1000000 m^2"));
+  static_assert(symbol_is<make_unit<kilometer, inverse<hour>>>("· (5/18) m s^-1 "));
+}
+
 int main(void) {
   using namespace units::_details;
   return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,58 @@
+#include <units/span.h>
+#include <units/units.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#define ASSERT_SAME(...) ASSERT_TRUE((std::is_same_v<__VA_ARGS__>))
+
+using namespace units;
+
+TEST(quantityViews, layout) {
+  ASSERT_TRUE(std::is_standard_layout_v<meter_t<>>);
+  ASSERT_TRUE(std::is_trivially_copyable_v<meter_t<>>);
+  ASSERT_TRUE(std::is_trivially_copyable_v<nanosecond_t<std::int64_t>>);
+  ASSERT_EQ(sizeof(meter_t<float>), sizeof(float));
+  ASSERT_EQ(sizeof(nanosecond_t<std::int64_t>), sizeof(std::int64_t));
+
+  ASSERT_SAME(quantity_span<meter>, std::span<meter_t<>>);
+  ASSERT_SAME(quantity_span<second, const float, 3>, std::span<const second_t<float>, 3>);
+}
+
+TEST(quantityViews, rawBuffers) {
+  std::vector<double> raw = {1, 2, 3, 4};
+
+  const auto view = as_quantities<kilometer>(raw.data(), raw.size());
+  ASSERT_EQ(view.size(), raw.size());
+  ASSERT_EQ(static_cast<const void*>(view.data()), static_cast<const void*>(raw.data()));
+  ASSERT_EQ(meter_t<>(view[2]), meter_t<>(3000));
+
+  // writes through the view modify the underlying buffer
+  view[0] += meter_t<>(500);
+  ASSERT_DOUBLE_EQ(raw[0], 1.5);
+
+  // constness is preserved
+  const std::vector<std::int64_t> ticks = {10, 20};
+  const auto cview = as_quantities<nanosecond>(std::span(ticks));
+  ASSERT_SAME(decltype(cview), const quantity_span<nanosecond, const std::int64_t>);
+
+  // and a span of quantities can be viewed back as its values
+  const auto values = as_values(view);
+  ASSERT_SAME(decltype(values), const std::span<double>);
+  ASSERT_EQ(values.data(), raw.data());
+}
+
+TEST(quantityViews, accessor) {
+  double raw[] = {1, 2, 3};
+  const quantity_accessor<second> accessor;
+
+  ASSERT_SAME(quantity_accessor<second>::reference, second_t<>&);
+  ASSERT_EQ(accessor.access(accessor.offset(raw, 1), 1), second_t<>(3));
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}